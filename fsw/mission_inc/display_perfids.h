@@ -29,6 +29,8 @@
 #ifndef DISPLAY_PERFIDS_H
 #define DISPLAY_PERFIDS_H
 
-#define DISPLAY_PERF_ID 91
+#define DISPLAY_PERF_ID       91
+#define DISPLAY_FLUSH_PERF_ID 92
+#define DISPLAY_BAND_PERF_ID  93
 
 #endif /* DISPLAY_PERFIDS_H */
@@ -34,8 +34,17 @@
 /* V1 Command Message IDs must be 0x18xx */
 #define DISPLAY_CMD_MID     0x1887
 #define DISPLAY_SEND_HK_MID 0x1889
+#define DISPLAY_WAKEUP_MID  0x188A /* Frame tick from the scheduler */
 
 /* V1 Telemetry Message IDs must be 0x08xx */
-#define DISPLAY_HK_TLM_MID 0x0885
+#define DISPLAY_HK_TLM_MID          0x0885
+#define DISPLAY_IMAGE_LIST_TLM_MID  0x0886
+#define DISPLAY_XFER_STATUS_TLM_MID 0x0887
+#define DISPLAY_CLIENT_LIST_TLM_MID 0x0888
+#define DISPLAY_PERF_TLM_MID        0x0889
+#define DISPLAY_CRC_TLM_MID         0x088A
+#define DISPLAY_SHOT_TLM_MID        0x088B
+#define DISPLAY_ACK_TLM_MID         0x088C
+#define DISPLAY_FLOW_TLM_MID        0x088D
 
 #endif /* DISPLAY_MSGIDS_H */
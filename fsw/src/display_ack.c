@@ -0,0 +1,133 @@
+#include "display_ack.h"
+
+#include <string.h>
+
+/*
+** Draw acknowledgements. Sequenced draws are noted as they are made, per
+** sender, and the notes are turned into one packet per sender once the
+** flush that presents them is done. Ground commands each flush and client
+** draws flush at the end of their frame tick, except while the command
+** pipe is congested, when draws wait for a later flush (display_flow.c);
+** the notes then gather until it comes.
+*/
+#define DISPLAY_ACK_MAX_SOURCES ((DISPLAY_MAX_CLIENTS * 2) + 1) /* Client pipes and rings, and the ground */
+
+typedef struct
+{
+    uint32 Source;
+    uint32 Sequence; /* Newest noted */
+    uint32 Draws;
+    uint64 SentUs;   /* Of Sequence */
+    uint64 OldestUs; /* Earliest of the Draws */
+} DISPLAY_AckNote_t;
+
+typedef struct
+{
+    DISPLAY_AckNote_t Notes[DISPLAY_ACK_MAX_SOURCES];
+    uint32            Count;
+} DISPLAY_Ack_t;
+
+static DISPLAY_Ack_t Ack;
+
+static uint64 DISPLAY_AckUs(CFE_TIME_SysTime_t Time)
+{
+    return ((uint64)Time.Seconds * 1000000) + (((uint64)Time.Subseconds * 1000000) >> 32);
+}
+
+static uint32 DISPLAY_AckSince(uint64 NowUs, uint64 SentUs)
+{
+    /* a sender clock ahead of ours counts as no delay */
+    if (SentUs >= NowUs)
+    {
+        return 0;
+    }
+    if (NowUs - SentUs > 0xFFFFFFFF)
+    {
+        return 0xFFFFFFFF;
+    }
+
+    return (uint32)(NowUs - SentUs);
+}
+
+void DISPLAY_AckInit(void)
+{
+    memset(&Ack, 0, sizeof(Ack));
+}
+
+/*
+** Note a sequenced draw from Source. Sequences compare with wraparound,
+** so a sender may count through zero.
+*/
+void DISPLAY_AckNote(uint32 Source, uint32 Sequence, CFE_TIME_SysTime_t Sent)
+{
+    DISPLAY_AckNote_t *Note = NULL;
+    uint64             SentUs = DISPLAY_AckUs(Sent);
+    uint32             i;
+
+    for (i = 0; i < Ack.Count; i++)
+    {
+        if (Ack.Notes[i].Source == Source)
+        {
+            Note = &Ack.Notes[i];
+            break;
+        }
+    }
+
+    if (Note == NULL)
+    {
+        if (Ack.Count == DISPLAY_ACK_MAX_SOURCES)
+        {
+            return;
+        }
+
+        Note           = &Ack.Notes[Ack.Count++];
+        Note->Source   = Source;
+        Note->Sequence = Sequence;
+        Note->Draws    = 0;
+        Note->SentUs   = SentUs;
+        Note->OldestUs = SentUs;
+    }
+
+    if ((int32)(Sequence - Note->Sequence) > 0)
+    {
+        Note->Sequence = Sequence;
+        Note->SentUs   = SentUs;
+    }
+    if (SentUs < Note->OldestUs)
+    {
+        Note->OldestUs = SentUs;
+    }
+    Note->Draws++;
+}
+
+/*
+** After a flush: acknowledge everything noted since the last one.
+** Flushes is the render's flush count, as reported with checksums.
+*/
+void DISPLAY_AckService(DISPLAY_AckTlm_Payload_t *Payload, uint32 Flushes, DISPLAY_AckSend_t Send)
+{
+    const DISPLAY_AckNote_t *Note;
+    uint64                   NowUs;
+    uint32                   i;
+
+    if (Ack.Count == 0)
+    {
+        return;
+    }
+
+    NowUs = DISPLAY_AckUs(CFE_TIME_GetTime());
+
+    for (i = 0; i < Ack.Count; i++)
+    {
+        Note                  = &Ack.Notes[i];
+        Payload->Source       = Note->Source;
+        Payload->Sequence     = Note->Sequence;
+        Payload->Draws        = Note->Draws;
+        Payload->LatencyUs    = DISPLAY_AckSince(NowUs, Note->SentUs);
+        Payload->MaxLatencyUs = DISPLAY_AckSince(NowUs, Note->OldestUs);
+        Payload->Flushes      = Flushes;
+        Send();
+    }
+
+    Ack.Count = 0;
+}
@@ -0,0 +1,15 @@
+#ifndef DISPLAY_ACK__H_
+#define DISPLAY_ACK__H_
+
+#include "common_types.h"
+#include "cfe_time.h"
+#include "display_msg.h"
+
+/* Transmit the acknowledgement packet just filled in */
+typedef void (*DISPLAY_AckSend_t)(void);
+
+void DISPLAY_AckInit(void);
+void DISPLAY_AckNote(uint32 Source, uint32 Sequence, CFE_TIME_SysTime_t Sent);
+void DISPLAY_AckService(DISPLAY_AckTlm_Payload_t *Payload, uint32 Flushes, DISPLAY_AckSend_t Send);
+
+#endif // DISPLAY_ACK__H_
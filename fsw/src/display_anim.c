@@ -0,0 +1,456 @@
+#include "display_anim.h"
+#include "display_fb.h"
+#include "display_image.h"
+#include "display_render.h"
+#include "cfe_time.h"
+
+#include <string.h>
+
+/*
+** Keyframe animations, evaluated once per frame tick against cFE time.
+** Each animation owns the area it draws on its layer: when its primitive
+** changes, the old area is cleared to the layer's key color and the new
+** one drawn, so only animated regions are damaged and nothing is redrawn
+** on ticks where the evaluated frame is unchanged. Animations are best
+** kept on a layer of their own, since the clear also removes anything
+** else drawn there.
+*/
+
+/* Fixed point used for interpolation: 1.0 == 1 << DISPLAY_ANIM_FRAC_BITS */
+#define DISPLAY_ANIM_FRAC_BITS 16
+#define DISPLAY_ANIM_ONE       (1 << DISPLAY_ANIM_FRAC_BITS)
+
+/*
+** What one evaluation of an animation puts on screen
+*/
+typedef struct
+{
+    DISPLAY_Rect_t  Rect;
+    DISPLAY_Color_t Color;
+    bool            Visible;
+} DISPLAY_AnimFrame_t;
+
+typedef struct
+{
+    bool                 Defined;
+    bool                 Drawn;   /* Last is on screen */
+    bool                 Changed; /* Needs drawing this tick */
+    DISPLAY_AnimSetCmd_t Def;
+    uint64               StartMs;
+    DISPLAY_AnimFrame_t  Last;
+} DISPLAY_Anim_t;
+
+typedef struct
+{
+    DISPLAY_Anim_t Anims[DISPLAY_MAX_ANIMS];
+    uint32         FbGeneration; /* Device mapping the drawn frames are on */
+    uint32         Redraws;
+} DISPLAY_AnimTable_t;
+
+static DISPLAY_AnimTable_t AnimTbl;
+
+static uint64 DISPLAY_AnimNowMs(void)
+{
+    CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+
+    return ((uint64)Now.Seconds * 1000) + (((uint64)Now.Subseconds * 1000) >> 32);
+}
+
+void DISPLAY_AnimInit(void)
+{
+    memset(&AnimTbl, 0, sizeof(AnimTbl));
+}
+
+static CFE_Status_t DISPLAY_AnimValidate(const DISPLAY_AnimSetCmd_t *Def)
+{
+    uint32 i;
+
+    if (Def->Id >= DISPLAY_MAX_ANIMS || Def->Layer >= DISPLAY_MAX_LAYERS || Def->PeriodMs == 0 ||
+        Def->KeyCount == 0 || Def->KeyCount > DISPLAY_ANIM_MAX_KEYS || Def->Easing > DISPLAY_ANIM_EASE_IN_OUT ||
+        Def->Mode > DISPLAY_ANIM_MODE_ONCE || Def->Property > DISPLAY_ANIM_PROP_VISIBLE)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    switch (Def->Target)
+    {
+        case DISPLAY_ANIM_TARGET_RECT:
+            if (Def->Width == 0 || Def->Height == 0)
+            {
+                return DISPLAY_STATUS_ERROR_RANGE;
+            }
+            break;
+
+        case DISPLAY_ANIM_TARGET_IMAGE:
+            if (Def->Slot >= DISPLAY_MAX_IMAGE_SLOTS || Def->Property == DISPLAY_ANIM_PROP_WIDTH ||
+                Def->Property == DISPLAY_ANIM_PROP_HEIGHT || Def->Property == DISPLAY_ANIM_PROP_COLOR)
+            {
+                return DISPLAY_STATUS_ERROR_RANGE;
+            }
+            break;
+
+        default:
+            return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    for (i = 0; i < Def->KeyCount; i++)
+    {
+        if (Def->Keys[i].Time > Def->PeriodMs || (i > 0 && Def->Keys[i].Time < Def->Keys[i - 1].Time))
+        {
+            return DISPLAY_STATUS_ERROR_RANGE;
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Clear what an animation last drew
+*/
+static void DISPLAY_AnimErase(DISPLAY_Anim_t *Anim)
+{
+    if (Anim->Drawn && Anim->Last.Visible)
+    {
+        DISPLAY_RenderSetTarget(Anim->Def.Layer, NULL);
+        DISPLAY_RenderClear(&Anim->Last.Rect);
+    }
+
+    Anim->Drawn = false;
+}
+
+/*
+** Define or replace an animation. It starts at its first key on the next
+** tick.
+*/
+CFE_Status_t DISPLAY_AnimSet(const DISPLAY_AnimSetCmd_t *Def)
+{
+    DISPLAY_Anim_t *Anim;
+    CFE_Status_t    status;
+    uint8           Layer;
+
+    status = DISPLAY_AnimValidate(Def);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    Anim  = &AnimTbl.Anims[Def->Id];
+    Layer = DISPLAY_RenderGetLayer();
+    DISPLAY_AnimErase(Anim);
+    DISPLAY_RenderSetTarget(Layer, NULL);
+
+    memset(Anim, 0, sizeof(*Anim));
+    Anim->Defined = true;
+    Anim->Def     = *Def;
+    Anim->StartMs = DISPLAY_AnimNowMs();
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t DISPLAY_AnimStop(uint8 Id, bool Clear)
+{
+    DISPLAY_Anim_t *Anim;
+    uint8           Layer;
+
+    if (Id >= DISPLAY_MAX_ANIMS || !AnimTbl.Anims[Id].Defined)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Anim = &AnimTbl.Anims[Id];
+    if (Clear)
+    {
+        Layer = DISPLAY_RenderGetLayer();
+        DISPLAY_AnimErase(Anim);
+        DISPLAY_RenderSetTarget(Layer, NULL);
+    }
+
+    memset(Anim, 0, sizeof(*Anim));
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Map linear progress F through an easing curve, both in fixed point
+*/
+static int32 DISPLAY_AnimEase(uint8 Easing, int32 F)
+{
+    int64 f = F;
+
+    switch (Easing)
+    {
+        case DISPLAY_ANIM_EASE_STEP:
+            return 0;
+
+        case DISPLAY_ANIM_EASE_IN:
+            return (int32)((f * f) >> DISPLAY_ANIM_FRAC_BITS);
+
+        case DISPLAY_ANIM_EASE_OUT:
+            f = DISPLAY_ANIM_ONE - f;
+            return DISPLAY_ANIM_ONE - (int32)((f * f) >> DISPLAY_ANIM_FRAC_BITS);
+
+        case DISPLAY_ANIM_EASE_IN_OUT:
+            /* 3f^2 - 2f^3 */
+            return (int32)((((f * f) >> DISPLAY_ANIM_FRAC_BITS) * (3 * DISPLAY_ANIM_ONE - 2 * f)) >>
+                           DISPLAY_ANIM_FRAC_BITS);
+
+        default:
+            return F;
+    }
+}
+
+static int32 DISPLAY_AnimLerp(int32 A, int32 B, int32 F)
+{
+    return A + (int32)((((int64)B - A) * F) >> DISPLAY_ANIM_FRAC_BITS);
+}
+
+/*
+** Property value Ms into the period
+*/
+static int32 DISPLAY_AnimValue(const DISPLAY_AnimSetCmd_t *Def, uint32 Ms)
+{
+    const DISPLAY_AnimKey_t *K = Def->Keys;
+    int32                    F;
+    int32                    Value;
+    uint32                   i;
+    int                      Shift;
+
+    if (Ms <= K[0].Time)
+    {
+        return K[0].Value;
+    }
+
+    for (i = 1; i < Def->KeyCount; i++)
+    {
+        if (Ms < K[i].Time)
+        {
+            break;
+        }
+    }
+
+    if (i == Def->KeyCount)
+    {
+        return K[i - 1].Value;
+    }
+
+    if (Def->Property == DISPLAY_ANIM_PROP_VISIBLE)
+    {
+        return K[i - 1].Value;
+    }
+
+    F = (int32)(((uint64)(Ms - K[i - 1].Time) << DISPLAY_ANIM_FRAC_BITS) / (K[i].Time - K[i - 1].Time));
+    F = DISPLAY_AnimEase(Def->Easing, F);
+
+    if (Def->Property != DISPLAY_ANIM_PROP_COLOR)
+    {
+        return DISPLAY_AnimLerp(K[i - 1].Value, K[i].Value, F);
+    }
+
+    Value = 0;
+    for (Shift = 0; Shift <= 16; Shift += 8)
+    {
+        Value |= DISPLAY_AnimLerp((K[i - 1].Value >> Shift) & 0xFF, (K[i].Value >> Shift) & 0xFF, F) << Shift;
+    }
+
+    return Value;
+}
+
+static void DISPLAY_AnimEvaluate(const DISPLAY_Anim_t *Anim, uint64 NowMs, DISPLAY_AnimFrame_t *Frame)
+{
+    const DISPLAY_AnimSetCmd_t    *Def     = &Anim->Def;
+    const DISPLAY_ImageSlotInfo_t *Info    = NULL;
+    uint64                         Elapsed = (NowMs > Anim->StartMs) ? NowMs - Anim->StartMs : 0;
+    uint32                         Ms;
+    int32                          Value;
+
+    if (Def->Mode == DISPLAY_ANIM_MODE_ONCE)
+    {
+        Ms = (Elapsed < Def->PeriodMs) ? (uint32)Elapsed : Def->PeriodMs;
+    }
+    else
+    {
+        Ms = (uint32)(Elapsed % Def->PeriodMs);
+    }
+
+    Frame->Rect.X  = Def->X;
+    Frame->Rect.Y  = Def->Y;
+    Frame->Rect.W  = Def->Width;
+    Frame->Rect.H  = Def->Height;
+    Frame->Color   = Def->Color;
+    Frame->Visible = true;
+
+    if (Def->Target == DISPLAY_ANIM_TARGET_IMAGE)
+    {
+        Info = DISPLAY_ImageGetSlot(Def->Slot);
+        if (Info == NULL || DISPLAY_ImageGetPixels(Def->Slot) == NULL)
+        {
+            Frame->Visible = false;
+            return;
+        }
+
+        Frame->Rect.W = Info->Width;
+        Frame->Rect.H = Info->Height;
+    }
+
+    Value = DISPLAY_AnimValue(Def, Ms);
+
+    switch (Def->Property)
+    {
+        case DISPLAY_ANIM_PROP_X:
+            Frame->Rect.X += Value;
+            break;
+        case DISPLAY_ANIM_PROP_Y:
+            Frame->Rect.Y += Value;
+            break;
+        case DISPLAY_ANIM_PROP_WIDTH:
+            Frame->Rect.W = Value;
+            break;
+        case DISPLAY_ANIM_PROP_HEIGHT:
+            Frame->Rect.H = Value;
+            break;
+        case DISPLAY_ANIM_PROP_COLOR:
+            Frame->Color.red   = (uint8)(Value >> 16);
+            Frame->Color.green = (uint8)(Value >> 8);
+            Frame->Color.blue  = (uint8)Value;
+            break;
+        default:
+            Frame->Visible = (Value != 0);
+            break;
+    }
+
+    if (DISPLAY_RectIsEmpty(&Frame->Rect))
+    {
+        Frame->Visible = false;
+    }
+}
+
+static bool DISPLAY_AnimFrameEqual(const DISPLAY_AnimFrame_t *A, const DISPLAY_AnimFrame_t *B)
+{
+    if (A->Visible != B->Visible)
+    {
+        return false;
+    }
+
+    if (!A->Visible)
+    {
+        return true;
+    }
+
+    return (memcmp(&A->Rect, &B->Rect, sizeof(A->Rect)) == 0 && A->Color.red == B->Color.red &&
+            A->Color.green == B->Color.green && A->Color.blue == B->Color.blue);
+}
+
+static void DISPLAY_AnimDraw(const DISPLAY_Anim_t *Anim)
+{
+    const DISPLAY_AnimFrame_t     *Frame = &Anim->Last;
+    const DISPLAY_ImageSlotInfo_t *Info;
+
+    if (!Frame->Visible)
+    {
+        return;
+    }
+
+    DISPLAY_RenderSetTarget(Anim->Def.Layer, NULL);
+
+    if (Anim->Def.Target == DISPLAY_ANIM_TARGET_IMAGE)
+    {
+        Info = DISPLAY_ImageGetSlot(Anim->Def.Slot);
+        DISPLAY_RenderBlit565(Frame->Rect.X, Frame->Rect.Y, DISPLAY_ImageGetPixels(Anim->Def.Slot), Info->Width,
+                              Info->Height);
+    }
+    else
+    {
+        DISPLAY_RenderFillRect(&Frame->Rect, Frame->Color);
+    }
+}
+
+/*
+** Frame tick. Animations whose frame changed are erased first and then
+** redrawn, together with any others on the same layer that overlap an
+** erased area, so overlapping animations never punch holes in each other.
+*/
+void DISPLAY_AnimTick(void)
+{
+    const DISPLAY_FbInfo_t *FbInfo = DISPLAY_FbGetInfo();
+    DISPLAY_AnimFrame_t     Frame;
+    DISPLAY_Anim_t         *Anim;
+    DISPLAY_Anim_t         *Other;
+    DISPLAY_Rect_t          Overlap;
+    uint64                  NowMs = DISPLAY_AnimNowMs();
+    uint8                   Layer = DISPLAY_RenderGetLayer();
+    bool                    Remapped;
+    int                     i, j;
+
+    /* Layers may have been reallocated and cleared by a new device mapping */
+    Remapped             = (FbInfo->Generation != AnimTbl.FbGeneration);
+    AnimTbl.FbGeneration = FbInfo->Generation;
+
+    for (i = 0; i < DISPLAY_MAX_ANIMS; i++)
+    {
+        AnimTbl.Anims[i].Changed = Remapped;
+    }
+
+    for (i = 0; i < DISPLAY_MAX_ANIMS; i++)
+    {
+        Anim = &AnimTbl.Anims[i];
+        if (!Anim->Defined)
+        {
+            continue;
+        }
+
+        DISPLAY_AnimEvaluate(Anim, NowMs, &Frame);
+
+        if (Anim->Drawn && DISPLAY_AnimFrameEqual(&Frame, &Anim->Last))
+        {
+            continue;
+        }
+
+        Anim->Changed = true;
+
+        if (Anim->Drawn && Anim->Last.Visible)
+        {
+            for (j = 0; j < DISPLAY_MAX_ANIMS; j++)
+            {
+                Other = &AnimTbl.Anims[j];
+                if (Other->Defined && Other->Drawn && Other->Last.Visible && Other->Def.Layer == Anim->Def.Layer &&
+                    DISPLAY_RectIntersect(&Overlap, &Other->Last.Rect, &Anim->Last.Rect))
+                {
+                    Other->Changed = true;
+                }
+            }
+        }
+
+        DISPLAY_AnimErase(Anim);
+        Anim->Last = Frame;
+    }
+
+    for (i = 0; i < DISPLAY_MAX_ANIMS; i++)
+    {
+        Anim = &AnimTbl.Anims[i];
+        if (Anim->Defined && Anim->Changed)
+        {
+            DISPLAY_AnimDraw(Anim);
+            Anim->Drawn   = true;
+            Anim->Changed = false;
+            AnimTbl.Redraws++;
+        }
+    }
+
+    DISPLAY_RenderSetTarget(Layer, NULL);
+}
+
+void DISPLAY_AnimGetStats(uint8 *Active, uint32 *Redraws)
+{
+    int i;
+
+    *Active = 0;
+    for (i = 0; i < DISPLAY_MAX_ANIMS; i++)
+    {
+        if (AnimTbl.Anims[i].Defined)
+        {
+            (*Active)++;
+        }
+    }
+
+    *Redraws = AnimTbl.Redraws;
+}
@@ -0,0 +1,14 @@
+#ifndef DISPLAY_ANIM__H_
+#define DISPLAY_ANIM__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_msg.h"
+
+void         DISPLAY_AnimInit(void);
+CFE_Status_t DISPLAY_AnimSet(const DISPLAY_AnimSetCmd_t *Def);
+CFE_Status_t DISPLAY_AnimStop(uint8 Id, bool Clear);
+void         DISPLAY_AnimTick(void);
+void         DISPLAY_AnimGetStats(uint8 *Active, uint32 *Redraws);
+
+#endif // DISPLAY_ANIM__H_
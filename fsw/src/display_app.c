@@ -17,12 +17,28 @@
 #include "cfe_evs.h"
 #include "display_app.h"
 #include "display_events.h"
+#include "display_ack.h"
+#include "display_anim.h"
+#include "display_arena.h"
+#include "display_band.h"
+#include "display_client.h"
+#include "display_dither.h"
 #include "display_fb.h"
+#include "display_flow.h"
+#include "display_font.h"
+#include "display_image.h"
+#include "display_job.h"
+#include "display_record.h"
+#include "display_render.h"
+#include "display_shot.h"
+#include "display_xfer.h"
 #include "display_version.h"
 #include "display_table.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <stddef.h>
+#include <string.h>
 #include <unistd.h>
 
 /*
@@ -37,6 +53,7 @@ void DISPLAY_Main(void)
 {
     int32            status;
     CFE_SB_Buffer_t *SBBufPtr;
+    bool             Queued;
 
     /*
     ** Create the first Performance Log entry
@@ -60,29 +77,52 @@ void DISPLAY_Main(void)
     while (CFE_ES_RunLoop(&DISPLAY_Data.RunStatus) == true)
     {
         /*
-        ** Performance Log Exit Stamp
+        ** Take what is already queued without waiting, so a backlog can be
+        ** seen (display_flow.c), and pend only once the pipe is empty and
+        ** no job (display_job.c) is left to run
         */
-        CFE_ES_PerfLogExit(DISPLAY_PERF_ID);
+        status = CFE_SB_ReceiveBuffer(&SBBufPtr, DISPLAY_Data.CommandPipe, CFE_SB_POLL);
+        Queued = (status == CFE_SUCCESS);
 
-        /* Pend on receipt of command packet */
-        status = CFE_SB_ReceiveBuffer(&SBBufPtr, DISPLAY_Data.CommandPipe, CFE_SB_PEND_FOREVER);
+        if (status == CFE_SB_NO_MESSAGE)
+        {
+            DISPLAY_PipeDrained();
+        }
 
-        /*
-        ** Performance Log Entry Stamp
-        */
-        CFE_ES_PerfLogEntry(DISPLAY_PERF_ID);
+        if (status == CFE_SB_NO_MESSAGE && !DISPLAY_JobPending())
+        {
+            /*
+            ** Performance Log Exit Stamp
+            */
+            CFE_ES_PerfLogExit(DISPLAY_PERF_ID);
+
+            /* Pend on receipt of command packet */
+            status = CFE_SB_ReceiveBuffer(&SBBufPtr, DISPLAY_Data.CommandPipe, CFE_SB_PEND_FOREVER);
+
+            /*
+            ** Performance Log Entry Stamp
+            */
+            CFE_ES_PerfLogEntry(DISPLAY_PERF_ID);
+        }
 
         if (status == CFE_SUCCESS)
         {
+            DISPLAY_FlowReceived(Queued, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
             DISPLAY_ProcessCommandPacket(SBBufPtr);
         }
-        else
+        else if (status != CFE_SB_NO_MESSAGE)
         {
             CFE_EVS_SendEvent(DISPLAY_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
                               "DISPLAY APP: SB Pipe Read Error, App Will Exit");
 
             DISPLAY_Data.RunStatus = CFE_ES_RunStatus_APP_ERROR;
         }
+
+        /*
+        ** Long work runs for up to the job budget after each message, so
+        ** the next message waits about that long at most
+        */
+        DISPLAY_JobRun();
     }
 
     /*
@@ -90,6 +130,18 @@ void DISPLAY_Main(void)
     */
     CFE_ES_PerfLogExit(DISPLAY_PERF_ID);
 
+    /*
+    ** Unmap the device so a restarted app (or another user) gets it clean
+    */
+    DISPLAY_RecordStop();
+    DISPLAY_ClientClose();
+    DISPLAY_RenderClose();
+    DISPLAY_BandClose();
+    DISPLAY_FbClose();
+    DISPLAY_FontClose();
+    DISPLAY_ImageClose();
+    DISPLAY_ArenaClose();
+
     CFE_ES_ExitApp(DISPLAY_Data.RunStatus);
 
 } /* End of DISPLAY_Main() */
@@ -119,6 +171,22 @@ int32 DISPLAY_Init(void)
     strncpy(DISPLAY_Data.PipeName, "DISPLAY_CMD_PIPE", sizeof(DISPLAY_Data.PipeName));
     DISPLAY_Data.PipeName[sizeof(DISPLAY_Data.PipeName) - 1] = 0;
 
+    /*
+    ** Precompute dither thresholds and an uncorrected color table
+    */
+    DISPLAY_DrawInit();
+    DISPLAY_DitherInit();
+
+    /*
+    ** Default layer stack; no producer apps or animations until defined
+    */
+    DISPLAY_RenderInit();
+    DISPLAY_ClientInit();
+    DISPLAY_AnimInit();
+    DISPLAY_AckInit();
+    DISPLAY_FlowInit(DISPLAY_Data.PipeDepth);
+    DISPLAY_JobInit();
+
     /*
     ** Initialize event filter table...
     */
@@ -152,6 +220,22 @@ int32 DISPLAY_Init(void)
     ** Initialize housekeeping packet (clear user data area).
     */
     CFE_MSG_Init(&DISPLAY_Data.HkTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_HK_TLM_MID), sizeof(DISPLAY_Data.HkTlm));
+    CFE_MSG_Init(&DISPLAY_Data.ImageListTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_IMAGE_LIST_TLM_MID),
+                 sizeof(DISPLAY_Data.ImageListTlm));
+    CFE_MSG_Init(&DISPLAY_Data.XferStatusTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_XFER_STATUS_TLM_MID),
+                 sizeof(DISPLAY_Data.XferStatusTlm));
+    CFE_MSG_Init(&DISPLAY_Data.ClientListTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_CLIENT_LIST_TLM_MID),
+                 sizeof(DISPLAY_Data.ClientListTlm));
+    CFE_MSG_Init(&DISPLAY_Data.PerfTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_PERF_TLM_MID),
+                 sizeof(DISPLAY_Data.PerfTlm));
+    CFE_MSG_Init(&DISPLAY_Data.CrcTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_CRC_TLM_MID),
+                 sizeof(DISPLAY_Data.CrcTlm));
+    CFE_MSG_Init(&DISPLAY_Data.ShotTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_SHOT_TLM_MID),
+                 sizeof(DISPLAY_Data.ShotTlm));
+    CFE_MSG_Init(&DISPLAY_Data.AckTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_ACK_TLM_MID),
+                 sizeof(DISPLAY_Data.AckTlm));
+    CFE_MSG_Init(&DISPLAY_Data.FlowTlm.TlmHeader.Msg, CFE_SB_ValueToMsgId(DISPLAY_FLOW_TLM_MID),
+                 sizeof(DISPLAY_Data.FlowTlm));
 
     /*
     ** Create Software Bus message pipe.
@@ -187,6 +271,18 @@ int32 DISPLAY_Init(void)
         return (status);
     }
 
+    /*
+    ** Subscribe to the frame tick that services client draws
+    */
+    status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(DISPLAY_WAKEUP_MID), DISPLAY_Data.CommandPipe);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR,
+                "Display: Error Subscribing to wakeup, RC = 0x%08lX\n", (unsigned long)status);
+
+        return (status);
+    }
+
     /*
     ** Register Table(s)
     */
@@ -210,41 +306,71 @@ int32 DISPLAY_Init(void)
         }
     }
 
-    /* Use the tbl pointer to get spi port config */
-    DISPLAY_Table_t *displayTblPtr = NULL;
+    /*
+    ** Reserve all display memory. Pool sizes are only read here; nothing
+    ** is allocated from the heap after this point.
+    */
     if (status == CFE_SUCCESS)
     {
-        status = CFE_TBL_GetAddress((void **) &displayTblPtr, DISPLAY_Data.TblHandles[0]);
-        if (status != CFE_SUCCESS)
+        DISPLAY_Table_t *TblPtr;
+        int32            BandStatus;
+
+        status = CFE_TBL_GetAddress((void *)&TblPtr, DISPLAY_Data.TblHandles[0]);
+        if (status >= CFE_SUCCESS)
         {
-            CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR, "Failed to get table pointer!");
-        }
+            status = DISPLAY_ArenaInit(TblPtr->PoolSize);
+            if (status != CFE_SUCCESS)
+            {
+                CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR,
+                        "Display: Error reserving display arena, RC = 0x%08lX\n", (unsigned long)status);
+            }
+            else
+            {
+                status = DISPLAY_ImageInit();
+            }
 
-    }
+            if (status == CFE_SUCCESS)
+            {
+                status = DISPLAY_FontInit();
+            }
 
-    /* Initialize the display device */
-    if (status == CFE_SUCCESS)
-    {
-        DISPLAY_Table_t *tblPtr;
-        CFE_TBL_GetAddress((void **) &tblPtr, DISPLAY_Data.TblHandles[0]);
-        status = DISPLAY_FbInit(tblPtr);
-        if (status != CFE_SUCCESS)
+            if (status == CFE_SUCCESS)
+            {
+                status = DISPLAY_RecordInit();
+            }
+
+            /* Fewer workers than asked for only make large draws slower */
+            if (status == CFE_SUCCESS)
+            {
+                BandStatus = DISPLAY_BandInit(TblPtr->Workers);
+                if (BandStatus != CFE_SUCCESS)
+                {
+                    CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Display: Error starting band workers, RC = 0x%08lX\n", (unsigned long)BandStatus);
+                }
+            }
+
+            CFE_TBL_ReleaseAddress(DISPLAY_Data.TblHandles[0]);
+        }
+        else
         {
-            CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR, "Framebuffer display failed to initialize");
+            CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR, "Failed to get table pointer!");
         }
     }
 
-    /* Release the table pointer */
-    if (displayTblPtr != NULL)
+    /*
+    ** Initialize the display device. A missing device is not fatal; the
+    ** housekeeping cycle keeps probing for it and maps it when it appears.
+    */
+    if (status == CFE_SUCCESS)
     {
-        status = CFE_TBL_ReleaseAddress(DISPLAY_Data.TblHandles[0]);
-        if (status != CFE_SUCCESS)
+        DISPLAY_CheckDevice();
+        if (!DISPLAY_FbIsMapped())
         {
-            CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR, "Failed to release tbl address!");
+            CFE_EVS_SendEvent(DISPLAY_STARTUP_ERR_EID, CFE_EVS_EventType_ERROR, "Framebuffer display failed to initialize");
         }
     }
 
-
     if (status == CFE_SUCCESS)
     {
         CFE_EVS_SendEvent(DISPLAY_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION,
@@ -269,20 +395,48 @@ int32 DISPLAY_Init(void)
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 void DISPLAY_ProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr)
 {
-    CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
+    CFE_SB_MsgId_t    MsgId       = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t CommandCode = 0;
+    bool              Draw;
 
     CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
 
+    DISPLAY_RecordPacket(DISPLAY_RECORD_SOURCE_CMD, SBBufPtr);
+
     switch (CFE_SB_MsgIdToValue(MsgId))
     {
         case DISPLAY_CMD_MID:
+            CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
+            Draw = (CommandCode == DISPLAY_FILLRECT_CC || CommandCode == DISPLAY_GRADIENT_CC ||
+                    CommandCode == DISPLAY_DRAW_IMAGE_CC || CommandCode == DISPLAY_TEXT_CC);
+
+            /* Draws held back below may read image slots other commands change */
+            if (!Draw)
+            {
+                DISPLAY_RenderSync();
+            }
+
             DISPLAY_ProcessGroundCommand(SBBufPtr);
+
+            /*
+            ** While the pipe is congested, draws wait to be presented
+            ** together. Otherwise they go out at once: only the frame tick
+            ** waits for the panel refresh, so the pipe is never held up.
+            */
+            if (!Draw || !DISPLAY_FlowSkipFrame())
+            {
+                DISPLAY_Present(false);
+            }
             break;
 
         case DISPLAY_SEND_HK_MID:
             DISPLAY_ReportHousekeeping((CFE_MSG_CommandHeader_t *)SBBufPtr);
             break;
 
+        case DISPLAY_WAKEUP_MID:
+            DISPLAY_ServiceClients();
+            break;
+
         default:
             CFE_EVS_SendEvent(DISPLAY_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_ERROR,
                               "DISPLAY: invalid command packet,MID = 0x%x", (unsigned int)CFE_SB_MsgIdToValue(MsgId));
@@ -301,6 +455,7 @@ void DISPLAY_ProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr)
 void DISPLAY_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 {
     CFE_MSG_FcnCode_t CommandCode = 0;
+    int32             status;
 
     CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
 
@@ -334,9 +489,201 @@ void DISPLAY_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
             break;
 
         case DISPLAY_FILLRECT_CC:
-            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_FillRectCmd_t)))
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_FillRectCmd_t)))
+            {
+                status = DISPLAY_FillRect((DISPLAY_FillRectCmd_t *) SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_FillRectCmd_t), status);
+            }
+
+            break;
+
+        case DISPLAY_GRADIENT_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_GradientCmd_t)))
+            {
+                status = DISPLAY_Gradient((DISPLAY_GradientCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_GradientCmd_t), status);
+            }
+
+            break;
+
+        case DISPLAY_IMAGE_UPLOAD_CC:
+            if (DISPLAY_VerifyCmdMinLength(&SBBufPtr->Msg, offsetof(DISPLAY_ImageUploadCmd_t, Data)))
+            {
+                const DISPLAY_ImageUploadCmd_t *Cmd = (const DISPLAY_ImageUploadCmd_t *)SBBufPtr;
+
+                if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, offsetof(DISPLAY_ImageUploadCmd_t, Data) +
+                                                                DISPLAY_ImageFormatSize(Cmd->Format, Cmd->Width,
+                                                                                        Cmd->Height)))
+                {
+                    DISPLAY_ImageUpload(Cmd);
+                }
+            }
+
+            break;
+
+        case DISPLAY_IMAGE_FREE_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_ImageFreeCmd_t)))
+            {
+                DISPLAY_ImageFreeSlot((DISPLAY_ImageFreeCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_IMAGE_LIST_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_ImageListCmd_t)))
+            {
+                DISPLAY_ImageListSlots((DISPLAY_ImageListCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_DRAW_IMAGE_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_DrawImageCmd_t)))
+            {
+                status = DISPLAY_DrawImage((DISPLAY_DrawImageCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_DrawImageCmd_t), status);
+            }
+
+            break;
+
+        case DISPLAY_TEXT_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_TextCmd_t)))
+            {
+                status = DISPLAY_TextCmd((DISPLAY_TextCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_TextCmd_t), status);
+            }
+
+            break;
+
+        case DISPLAY_XFER_BEGIN_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_XferBeginCmd_t)))
+            {
+                DISPLAY_XferBeginCmd((DISPLAY_XferBeginCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_XFER_CHUNK_CC:
+            if (DISPLAY_VerifyCmdMinLength(&SBBufPtr->Msg, offsetof(DISPLAY_XferChunkCmd_t, Data)))
+            {
+                const DISPLAY_XferChunkCmd_t *Cmd = (const DISPLAY_XferChunkCmd_t *)SBBufPtr;
+
+                if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, offsetof(DISPLAY_XferChunkCmd_t, Data) + Cmd->Length))
+                {
+                    DISPLAY_XferChunkCmd(Cmd);
+                }
+            }
+
+            break;
+
+        case DISPLAY_XFER_COMMIT_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_XferCommitCmd_t)))
+            {
+                DISPLAY_XferCommitCmd((DISPLAY_XferCommitCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_XFER_ABORT_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_XferAbortCmd_t)))
+            {
+                DISPLAY_XferAbortCmd((DISPLAY_XferAbortCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_XFER_STATUS_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_XferStatusCmd_t)))
+            {
+                DISPLAY_XferStatusCmd((DISPLAY_XferStatusCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_CLIENT_REGISTER_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_ClientRegisterCmd_t)))
+            {
+                DISPLAY_ClientRegisterCmd((DISPLAY_ClientRegisterCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_CLIENT_UNREGISTER_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_ClientUnregisterCmd_t)))
+            {
+                DISPLAY_ClientUnregisterCmd((DISPLAY_ClientUnregisterCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_CLIENT_LIST_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_ClientListCmd_t)))
+            {
+                DISPLAY_ClientListCmd((DISPLAY_ClientListCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_LAYER_SET_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_LayerSetCmd_t)))
+            {
+                DISPLAY_LayerSet((DISPLAY_LayerSetCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_LAYER_SELECT_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_LayerSelectCmd_t)))
+            {
+                DISPLAY_LayerSelect((DISPLAY_LayerSelectCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_RECORD_START_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_RecordStartCmd_t)))
+            {
+                DISPLAY_RecordStartCmd((DISPLAY_RecordStartCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_RECORD_STOP_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_RecordStopCmd_t)))
+            {
+                DISPLAY_RecordStopCmd((DISPLAY_RecordStopCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_ANIM_SET_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_AnimSetCmd_t)))
+            {
+                DISPLAY_AnimSetCmd((DISPLAY_AnimSetCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_ANIM_STOP_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_AnimStopCmd_t)))
+            {
+                DISPLAY_AnimStopCmd((DISPLAY_AnimStopCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_CRC_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_CrcCmd_t)))
+            {
+                DISPLAY_CrcCmd((DISPLAY_CrcCmd_t *)SBBufPtr);
+            }
+
+            break;
+
+        case DISPLAY_SCREENSHOT_CC:
+            if (DISPLAY_VerifyCmdLength(&SBBufPtr->Msg, sizeof(DISPLAY_ScreenshotCmd_t)))
             {
-                DISPLAY_FillRect((DISPLAY_FillRectCmd_t *) SBBufPtr);
+                DISPLAY_ScreenshotCmd((DISPLAY_ScreenshotCmd_t *)SBBufPtr);
             }
 
             break;
@@ -353,131 +700,1272 @@ void DISPLAY_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 } /* End of DISPLAY_ProcessGroundCommand() */
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*  Name:  DISPLAY_ReportHousekeeping                                          */
+/*  Name:  DISPLAY_ProcessClientCommand                                       */
 /*                                                                            */
 /*  Purpose:                                                                  */
-/*         This function is triggered in response to a task telemetry request */
-/*         from the housekeeping task. This function will gather the Apps     */
-/*         telemetry, packetize it and send it to the housekeeping task via   */
-/*         the software bus                                                   */
+/*         Run one message from a client draw pipe. Clients may only draw;    */
+/*         the render viewport is already set to the client's area.           */
+/*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
-int32 DISPLAY_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
+int32 DISPLAY_ProcessClientCommand(CFE_SB_Buffer_t *SBBufPtr)
 {
-    int i;
+    CFE_MSG_FcnCode_t CommandCode = 0;
+    CFE_SB_MsgId_t    MsgId       = CFE_SB_INVALID_MSG_ID;
+    int32             status      = DISPLAY_STATUS_ERROR_RANGE;
 
-    /*
-    ** Get command execution counters...
-    */
-    DISPLAY_Data.HkTlm.Payload.CommandErrorCounter = DISPLAY_Data.ErrCounter;
-    DISPLAY_Data.HkTlm.Payload.CommandCounter      = DISPLAY_Data.CmdCounter;
+    DISPLAY_RecordPacket(DISPLAY_RECORD_SOURCE_CLIENT, SBBufPtr);
 
-    /*
-    ** Send housekeeping telemetry packet...
-    */
-    CFE_SB_TimeStampMsg(&DISPLAY_Data.HkTlm.TlmHeader.Msg);
-    CFE_SB_TransmitMsg(&DISPLAY_Data.HkTlm.TlmHeader.Msg, true);
+    CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
 
-    /*
-    ** Manage any pending table loads, validations, etc.
-    */
-    for (i = 0; i < DISPLAY_NUMBER_OF_TABLES; i++)
+    switch (CommandCode)
     {
-        CFE_TBL_Manage(DISPLAY_Data.TblHandles[i]);
-    }
+        case DISPLAY_FILLRECT_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_FillRectCmd_t)))
+            {
+                status = DISPLAY_FillRect((DISPLAY_FillRectCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_FillRectCmd_t), status);
+            }
 
-    return CFE_SUCCESS;
+            break;
 
-} /* End of DISPLAY_ReportHousekeeping() */
+        case DISPLAY_GRADIENT_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_GradientCmd_t)))
+            {
+                status = DISPLAY_Gradient((DISPLAY_GradientCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_GradientCmd_t), status);
+            }
 
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*                                                                            */
-/* DISPLAY_Noop -- DISPLAY NOOP commands                                        */
-/*                                                                            */
-/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-int32 DISPLAY_Noop(const DISPLAY_NoopCmd_t *Msg)
-{
+            break;
 
-    DISPLAY_Data.CmdCounter++;
+        case DISPLAY_DRAW_IMAGE_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_DrawImageCmd_t)))
+            {
+                status = DISPLAY_DrawImage((DISPLAY_DrawImageCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_DrawImageCmd_t), status);
+            }
 
-    CFE_EVS_SendEvent(DISPLAY_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: NOOP command %s",
-                      DISPLAY_VERSION);
+            break;
 
-    return CFE_SUCCESS;
+        case DISPLAY_TEXT_CC:
+            if (DISPLAY_VerifyDrawLength(&SBBufPtr->Msg, sizeof(DISPLAY_TextCmd_t)))
+            {
+                status = DISPLAY_TextCmd((DISPLAY_TextCmd_t *)SBBufPtr);
+                DISPLAY_AckDraw(SBBufPtr, sizeof(DISPLAY_TextCmd_t), status);
+            }
 
-} /* End of DISPLAY_Noop */
+            break;
+
+        default:
+            CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+            CFE_EVS_SendEvent(DISPLAY_CLIENT_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "DISPLAY: client MID 0x%x sent non-draw command code %d",
+                              (unsigned int)CFE_SB_MsgIdToValue(MsgId), CommandCode);
+            DISPLAY_Data.ErrCounter++;
+            break;
+    }
+
+    return status;
+
+} /* End of DISPLAY_ProcessClientCommand() */
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*  Name:  DISPLAY_ResetCounters                                               */
+/*  Name:  DISPLAY_ProcessLibDraw                                             */
 /*                                                                            */
 /*  Purpose:                                                                  */
-/*         This function resets all the global counter variables that are     */
-/*         part of the task telemetry.                                        */
+/*         Run one draw a client queued through display_lib, with the render  */
+/*         viewport already set to the client's area. Every draw made this    */
+/*         way is acknowledged under the client's draw MID with               */
+/*         DISPLAY_ACK_SOURCE_LIB set, apart from its pipe draws.             */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
-int32 DISPLAY_ResetCounters(const DISPLAY_ResetCountersCmd_t *Msg)
+int32 DISPLAY_ProcessLibDraw(uint32 Source, const DISPLAY_LibOp_t *Op)
 {
+    DISPLAY_Rect_t                 Rect = {Op->X, Op->Y, (int32)Op->Width, (int32)Op->Height};
+    const DISPLAY_ImageSlotInfo_t *Info;
+    const uint8                   *Pixels;
 
-    DISPLAY_Data.CmdCounter = 0;
-    DISPLAY_Data.ErrCounter = 0;
+    switch (Op->Op)
+    {
+        case DISPLAY_LIB_OP_FILL:
+            DISPLAY_RenderFillRect(&Rect, Op->Color);
+            break;
 
-    CFE_EVS_SendEvent(DISPLAY_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: RESET command");
+        case DISPLAY_LIB_OP_GRADIENT:
+            DISPLAY_RenderGradient(&Rect, Op->Color, Op->To, Op->Vertical != 0);
+            break;
 
-    return CFE_SUCCESS;
+        case DISPLAY_LIB_OP_IMAGE:
+            Info   = DISPLAY_ImageGetSlot(Op->Image);
+            Pixels = DISPLAY_ImageGetPixels(Op->Image);
+            if (Pixels == NULL)
+            {
+                CFE_EVS_SendEvent(DISPLAY_IMAGE_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "DISPLAY: image slot %u is not loaded", (unsigned int)Op->Image);
+                DISPLAY_Data.ErrCounter++;
+                return DISPLAY_STATUS_ERROR_RANGE;
+            }
+
+            DISPLAY_RenderBlit565(Op->X, Op->Y, Pixels, Info->Width, Info->Height);
+            break;
+
+        case DISPLAY_LIB_OP_BLIT:
+            DISPLAY_RenderBlit565(Op->X, Op->Y, Op->Pixels, Op->Width, Op->Height);
+            break;
+
+        default:
+            CFE_EVS_SendEvent(DISPLAY_CLIENT_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "DISPLAY: client MID 0x%x queued unknown draw %u", (unsigned int)Source,
+                              (unsigned int)Op->Op);
+            DISPLAY_Data.ErrCounter++;
+            return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    DISPLAY_AckNote(Source | DISPLAY_ACK_SOURCE_LIB, Op->Sequence, Op->Sent);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ProcessLibDraw() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ServiceClients                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Frame tick: advance animations, run queued client draws within     */
+/*         the per-tick budgets from the table, then send the result to the   */
+/*         panel in one flush.                                                */
+/*         Draws stay queued while there is no display to draw on, and the    */
+/*         flush is held back while the command pipe is congested.            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_ServiceClients(void)
+{
+    int32            status;
+    DISPLAY_Table_t *TblPtr;
+    uint32           ShotBytesPerSec;
+
+    if (!DISPLAY_RenderIsReady())
+    {
+        return;
+    }
+
+    DISPLAY_AnimTick();
+
+    status = CFE_TBL_GetAddress((void *)&TblPtr, DISPLAY_Data.TblHandles[0]);
+    if (status < CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Display: Fail to get table address: 0x%08lx", (unsigned long)status);
+        DISPLAY_Present(true);
+        return;
+    }
+
+    DISPLAY_ClientService(TblPtr->ClientMsgBudget, TblPtr->ClientPixelBudget, DISPLAY_ProcessClientCommand,
+                          DISPLAY_ProcessLibDraw);
+    ShotBytesPerSec = TblPtr->ShotBytesPerSec;
+
+    status = CFE_TBL_ReleaseAddress(DISPLAY_Data.TblHandles[0]);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Display: Fail to release table address: 0x%08lx", (unsigned long)status);
+    }
+
+    /* Clients keep their pace while congested; only the frame waits */
+    if (DISPLAY_FlowSkipFrame())
+    {
+        return;
+    }
+
+    DISPLAY_Present(true);
+
+    /* Stream from the frame just flushed */
+    DISPLAY_ShotService(&DISPLAY_Data.ShotTlm.Payload, ShotBytesPerSec, DISPLAY_SendShotPacket);
+
+} /* End of DISPLAY_ServiceClients() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_Present                                                    */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Flush what has been drawn to the panel, at its next refresh when   */
+/*         Paced, and acknowledge the draws it presented                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_Present(bool Paced)
+{
+    DISPLAY_RenderFlush(Paced);
+    DISPLAY_FlowPresented();
+    DISPLAY_LibPresent();
+    DISPLAY_AckService(&DISPLAY_Data.AckTlm.Payload, DISPLAY_RenderGetFlushes(), DISPLAY_SendAckPacket);
+
+} /* End of DISPLAY_Present() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_PipeDrained                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         The command pipe is empty: present any frame held back while it    */
+/*         was congested and tell producers it has drained                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_PipeDrained(void)
+{
+    if (DISPLAY_FlowHeld())
+    {
+        DISPLAY_Present(false);
+    }
+
+    DISPLAY_FlowDrained(&DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+
+} /* End of DISPLAY_PipeDrained() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ReportHousekeeping                                          */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function is triggered in response to a task telemetry request */
+/*         from the housekeeping task. This function will gather the Apps     */
+/*         telemetry, packetize it and send it to the housekeeping task via   */
+/*         the software bus                                                   */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
+{
+    int    i;
+    uint32 Hits, Misses, Lookups;
+
+    /*
+    ** Get command execution counters...
+    */
+    DISPLAY_Data.HkTlm.Payload.CommandErrorCounter = DISPLAY_Data.ErrCounter;
+    DISPLAY_Data.HkTlm.Payload.CommandCounter      = DISPLAY_Data.CmdCounter;
+    DISPLAY_Data.HkTlm.Payload.FbMapped            = DISPLAY_FbIsMapped();
+    DISPLAY_Data.HkTlm.Payload.FbMapCounter        = (uint8)DISPLAY_FbGetInfo()->Generation;
+    DISPLAY_ArenaGetStats(DISPLAY_Data.HkTlm.Payload.Pools);
+
+    /*
+    ** Write out the recorder's staged entries once per housekeeping cycle
+    */
+    if (DISPLAY_RecordFlush() != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_RECORD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: command log write failed, recording stopped");
+    }
+
+    DISPLAY_RecordGetStats(&DISPLAY_Data.HkTlm.Payload.RecordMessages, &DISPLAY_Data.HkTlm.Payload.RecordBytes);
+    DISPLAY_Data.HkTlm.Payload.Recording = DISPLAY_RecordIsActive();
+    DISPLAY_AnimGetStats(&DISPLAY_Data.HkTlm.Payload.AnimActive, &DISPLAY_Data.HkTlm.Payload.AnimRedraws);
+
+    /*
+    ** Glyph cache hit rate over the last housekeeping period, taken against
+    ** the totals sent last time
+    */
+    DISPLAY_FontGetStats(&Hits, &Misses, &DISPLAY_Data.HkTlm.Payload.GlyphCached);
+    Lookups = (Hits - DISPLAY_Data.HkTlm.Payload.GlyphHits) + (Misses - DISPLAY_Data.HkTlm.Payload.GlyphMisses);
+    DISPLAY_Data.HkTlm.Payload.GlyphHitPct =
+        (Lookups == 0) ? 0 : (uint8)(((uint64)(Hits - DISPLAY_Data.HkTlm.Payload.GlyphHits) * 100) / Lookups);
+    DISPLAY_Data.HkTlm.Payload.GlyphHits   = Hits;
+    DISPLAY_Data.HkTlm.Payload.GlyphMisses = Misses;
+
+    DISPLAY_FlowGetStats(&DISPLAY_Data.HkTlm.Payload.PipeCongested, &DISPLAY_Data.HkTlm.Payload.FramesDropped,
+                         &DISPLAY_Data.HkTlm.Payload.DrawsCoalesced);
+    DISPLAY_JobGetStats(&DISPLAY_Data.HkTlm.Payload.JobsPending, &DISPLAY_Data.HkTlm.Payload.JobsDone,
+                        &DISPLAY_Data.HkTlm.Payload.JobMaxPassUs);
+
+    /*
+    ** Send housekeeping telemetry packet...
+    */
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.HkTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.HkTlm.TlmHeader.Msg, true);
+
+    DISPLAY_RenderGetPerf(&DISPLAY_Data.PerfTlm.Payload);
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.PerfTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.PerfTlm.TlmHeader.Msg, true);
+
+    /*
+    ** Manage any pending table loads, validations, etc.
+    */
+    for (i = 0; i < DISPLAY_NUMBER_OF_TABLES; i++)
+    {
+        CFE_TBL_Manage(DISPLAY_Data.TblHandles[i]);
+    }
+
+    /*
+    ** Follow table changes and device hotplug
+    */
+    DISPLAY_CheckDevice();
+
+    /*
+    ** Keep the idle timeout running when no frame tick is scheduled, and
+    ** acknowledge anything that flush shows
+    */
+    DISPLAY_Present(false);
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ReportHousekeeping() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_CheckDevice                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Bring the framebuffer mapping in line with the current table:      */
+/*         remap when DevicePath changes or the device node is recreated,     */
+/*         and pick the device back up when it reappears.                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_CheckDevice(void)
+{
+    int32                   status;
+    DISPLAY_Table_t        *TblPtr;
+    const DISPLAY_FbInfo_t *FbInfo     = DISPLAY_FbGetInfo();
+    uint32                  Generation = FbInfo->Generation;
+    bool                    WasMapped  = DISPLAY_FbIsMapped();
+
+    status = CFE_TBL_GetAddress((void *)&TblPtr, DISPLAY_Data.TblHandles[0]);
+    if (status < CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Display: Fail to get table address: 0x%08lx", (unsigned long)status);
+        return;
+    }
+
+    status = DISPLAY_FbCheck(TblPtr);
+    if (FbInfo->Generation != Generation)
+    {
+        CFE_EVS_SendEvent(DISPLAY_FB_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "Display: mapped %s, %lux%lu, %lu bpp", TblPtr->DevicePath,
+                          (unsigned long)FbInfo->Width, (unsigned long)FbInfo->Height,
+                          (unsigned long)(FbInfo->BytesPerPixel * 8));
+    }
+
+    DISPLAY_JobSetBudget(TblPtr->JobBudgetUs);
+
+    if (status == CFE_SUCCESS)
+    {
+        /* Conversions under way keep the colors they were started with */
+        if (TblPtr->PanelGamma != DISPLAY_Data.PanelGamma || TblPtr->Brightness != DISPLAY_Data.Brightness)
+        {
+            DISPLAY_JobFinish();
+            DISPLAY_Data.PanelGamma = TblPtr->PanelGamma;
+            DISPLAY_Data.Brightness = TblPtr->Brightness;
+        }
+
+        status = DISPLAY_RenderConfigure(TblPtr);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_EVS_SendEvent(DISPLAY_FB_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Display: failed to configure back buffer, RC = 0x%08lX", (unsigned long)status);
+        }
+    }
+    else if (status != CFE_SUCCESS && WasMapped)
+    {
+        CFE_EVS_SendEvent(DISPLAY_FB_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Display: framebuffer %s unavailable, RC = 0x%08lX", TblPtr->DevicePath,
+                          (unsigned long)status);
+    }
+
+    status = CFE_TBL_ReleaseAddress(DISPLAY_Data.TblHandles[0]);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Display: Fail to release table address: 0x%08lx", (unsigned long)status);
+    }
+
+} /* End of DISPLAY_CheckDevice() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* DISPLAY_Noop -- DISPLAY NOOP commands                                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 DISPLAY_Noop(const DISPLAY_NoopCmd_t *Msg)
+{
+
+    DISPLAY_Data.CmdCounter++;
+
+    CFE_EVS_SendEvent(DISPLAY_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: NOOP command %s",
+                      DISPLAY_VERSION);
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_Noop */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ResetCounters                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function resets all the global counter variables that are     */
+/*         part of the task telemetry.                                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ResetCounters(const DISPLAY_ResetCountersCmd_t *Msg)
+{
+
+    DISPLAY_Data.CmdCounter = 0;
+    DISPLAY_Data.ErrCounter = 0;
+
+    CFE_EVS_SendEvent(DISPLAY_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: RESET command");
+
+    return CFE_SUCCESS;
 
 } /* End of DISPLAY_ResetCounters() */
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*  Name:  DISPLAY_Process                                                     */
+/*  Name:  DISPLAY_Process                                                     */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function Process Ground Station Command                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ProcessTbl(const DISPLAY_ProcessCmd_t *Msg)
+{
+    int32            status;
+    DISPLAY_Table_t *TblPtr;
+    const char      *TableName = "DISPLAY.displayTable";
+
+    /* Use of Table */
+    status = CFE_TBL_GetAddress((void *)&TblPtr, DISPLAY_Data.TblHandles[0]);
+
+    if (status < CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Display: Fail to get table address: 0x%08lx", (unsigned long)status);
+        return status;
+    }
+
+    CFE_ES_WriteToSysLog("Display: Table Device Path %s", TblPtr->DevicePath);
+
+    DISPLAY_GetCrc(TableName);
+
+    status = CFE_TBL_ReleaseAddress(DISPLAY_Data.TblHandles[0]);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Display: Fail to release table address: 0x%08lx", (unsigned long)status);
+    }
+
+    return status;
+
+} /* End of DISPLAY_ProcessTbl */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_DrawArea                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Read a draw command's position and size into Rect, refusing any    */
+/*         outside the range of DISPLAY_DRAW_MAX_COORD and                    */
+/*         DISPLAY_DRAW_MAX_SIZE, whose edges would not fit an int32          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_DrawArea(DISPLAY_Rect_t *Rect, uint32 X, uint32 Y, uint32 W, uint32 H)
+{
+    Rect->X = (int32)X;
+    Rect->Y = (int32)Y;
+    Rect->W = (int32)W;
+    Rect->H = (int32)H;
+
+    if (Rect->X < DISPLAY_DRAW_MIN_COORD || Rect->X > DISPLAY_DRAW_MAX_COORD || Rect->Y < DISPLAY_DRAW_MIN_COORD ||
+        Rect->Y > DISPLAY_DRAW_MAX_COORD || W > DISPLAY_DRAW_MAX_SIZE || H > DISPLAY_DRAW_MAX_SIZE)
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: draw at %ld,%ld of %lux%lu out of range, dropped", (long)Rect->X,
+                          (long)Rect->Y, (unsigned long)W, (unsigned long)H);
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_DrawArea */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_FillRect                                                     */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         This function Process Ground Station Command                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_FillRect(const DISPLAY_FillRectCmd_t *Msg)
+{
+    DISPLAY_Rect_t Rect;
+
+    if (!DISPLAY_RenderIsReady())
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no display, draw dropped");
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    if (DISPLAY_DrawArea(&Rect, Msg->startX, Msg->startY, Msg->sizeX, Msg->sizeY) != CFE_SUCCESS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    DISPLAY_RenderFillRect(&Rect, Msg->color);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_FillRect */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_Gradient                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Fill a rectangle with a dithered linear gradient                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_Gradient(const DISPLAY_GradientCmd_t *Msg)
+{
+    DISPLAY_Rect_t Rect;
+
+    if (!DISPLAY_RenderIsReady())
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no display, draw dropped");
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    if (DISPLAY_DrawArea(&Rect, Msg->startX, Msg->startY, Msg->sizeX, Msg->sizeY) != CFE_SUCCESS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    DISPLAY_RenderGradient(&Rect, Msg->colorFrom, Msg->colorTo, Msg->vertical != 0);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_Gradient */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ImageUpload                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Store the pixels carried by the command in an image slot           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ImageUpload(const DISPLAY_ImageUploadCmd_t *Msg)
+{
+    int32  status;
+    uint8 *Pixels;
+    uint32 Size;
+    char   Name[DISPLAY_IMAGE_NAME_LEN];
+
+    strncpy(Name, Msg->Name, sizeof(Name) - 1);
+    Name[sizeof(Name) - 1] = 0;
+
+    Size   = DISPLAY_ImageFormatSize(Msg->Format, Msg->Width, Msg->Height);
+    status = DISPLAY_ImageReserve(Msg->Slot, Name, Msg->Width, Msg->Height, Msg->Format, Size, &Pixels);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_IMAGE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: cannot store %ux%u image in slot %u, RC = 0x%08lX", (unsigned int)Msg->Width,
+                          (unsigned int)Msg->Height, (unsigned int)Msg->Slot, (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    memcpy(Pixels, Msg->Data, Size);
+    DISPLAY_ImageCommit(Msg->Slot, Msg->Format);
+
+    CFE_EVS_SendEvent(DISPLAY_IMAGE_INF_EID, CFE_EVS_EventType_DEBUG, "DISPLAY: slot %u '%s' %ux%u stored",
+                      (unsigned int)Msg->Slot, Name, (unsigned int)Msg->Width, (unsigned int)Msg->Height);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ImageUpload */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ImageFreeSlot                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Release an image slot and the arena space it holds                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ImageFreeSlot(const DISPLAY_ImageFreeCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_ImageFree(Msg->Slot);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_IMAGE_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: invalid image slot %u",
+                          (unsigned int)Msg->Slot);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ImageFreeSlot */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ImageListSlots                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the image slot listing packet                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ImageListSlots(const DISPLAY_ImageListCmd_t *Msg)
+{
+    DISPLAY_ImageList(&DISPLAY_Data.ImageListTlm.Payload);
+
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.ImageListTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.ImageListTlm.TlmHeader.Msg, true);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ImageListSlots */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_DrawImage                                                  */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Draw a resident image by slot number                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_DrawImage(const DISPLAY_DrawImageCmd_t *Msg)
+{
+    const DISPLAY_ImageSlotInfo_t *Info   = DISPLAY_ImageGetSlot(Msg->Slot);
+    const uint8                   *Pixels = DISPLAY_ImageGetPixels(Msg->Slot);
+
+    if (Pixels == NULL)
+    {
+        CFE_EVS_SendEvent(DISPLAY_IMAGE_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: image slot %u is not loaded",
+                          (unsigned int)Msg->Slot);
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    if (!DISPLAY_RenderIsReady())
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no display, draw dropped");
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    DISPLAY_RenderBlit565(Msg->X, Msg->Y, Pixels, Info->Width, Info->Height);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_DrawImage */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_TextCmd                                                    */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Draw a line of text in a font held in an image slot                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_TextCmd(const DISPLAY_TextCmd_t *Msg)
+{
+    int32 status;
+
+    if (!DISPLAY_RenderIsReady())
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no display, draw dropped");
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    status = DISPLAY_FontDrawText(Msg->Font, Msg->X, Msg->Y, Msg->Color, Msg->Text, sizeof(Msg->Text));
+    if (status == DISPLAY_STATUS_ERROR_RANGE)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TEXT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: image slot %u does not hold a valid font", (unsigned int)Msg->Font);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TEXT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: font in slot %u has glyphs that cannot be drawn, RC = 0x%08lX",
+                          (unsigned int)Msg->Font, (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_TextCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_XferBeginCmd                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Open a segmented upload into an image slot                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_XferBeginCmd(const DISPLAY_XferBeginCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_XferBegin(Msg);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_XFER_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: transfer %u rejected, slot %u, %lu bytes in %u byte chunks, RC = 0x%08lX",
+                          (unsigned int)Msg->TransferId, (unsigned int)Msg->Slot, (unsigned long)Msg->TotalSize,
+                          (unsigned int)Msg->ChunkSize, (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(DISPLAY_XFER_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "DISPLAY: transfer %u started, slot %u, %u chunks", (unsigned int)Msg->TransferId,
+                      (unsigned int)Msg->Slot, (unsigned int)DISPLAY_XferGetStatus()->NumChunks);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_XferBeginCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_XferChunkCmd                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Place one chunk of the open upload. Duplicates are counted in the  */
+/*         transfer status and otherwise ignored.                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_XferChunkCmd(const DISPLAY_XferChunkCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_XferChunk(Msg);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_XFER_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: transfer %u chunk %u at %lu, %u bytes rejected", (unsigned int)Msg->TransferId,
+                          (unsigned int)Msg->Sequence, (unsigned long)Msg->Offset, (unsigned int)Msg->Length);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_XferChunkCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_XferCommitCmd                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Verify and complete the open upload, then report the transfer      */
+/*         status so the sender knows what, if anything, to resend.           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_XferCommitCmd(const DISPLAY_XferCommitCmd_t *Msg)
+{
+    int32                                  status;
+    const DISPLAY_XferStatusTlm_Payload_t *Status;
+
+    status = DISPLAY_XferCommit(Msg);
+    Status = DISPLAY_XferGetStatus();
+
+    if (status == CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_XFER_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "DISPLAY: transfer %u complete, slot %u, %u duplicate chunks", (unsigned int)Msg->TransferId,
+                          (unsigned int)Status->Slot, (unsigned int)Status->DuplicateChunks);
+        DISPLAY_Data.CmdCounter++;
+    }
+    else
+    {
+        CFE_EVS_SendEvent(DISPLAY_XFER_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: transfer %u commit failed, %u of %u chunks, first missing %u, RC = 0x%08lX",
+                          (unsigned int)Msg->TransferId, (unsigned int)Status->ChunksReceived,
+                          (unsigned int)Status->NumChunks, (unsigned int)Status->FirstMissing, (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+    }
+
+    DISPLAY_XferStatusCmd(NULL);
+
+    return status;
+
+} /* End of DISPLAY_XferCommitCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_XferAbortCmd                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Abandon the open upload and release its slot                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_XferAbortCmd(const DISPLAY_XferAbortCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_XferAbort(Msg->TransferId);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_XFER_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no open transfer %u",
+                          (unsigned int)Msg->TransferId);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(DISPLAY_XFER_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: transfer %u aborted",
+                      (unsigned int)Msg->TransferId);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_XferAbortCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_XferStatusCmd                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the segmented transfer status packet. Also called after a     */
+/*         commit with Msg == NULL, which does not count as a command.        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_XferStatusCmd(const DISPLAY_XferStatusCmd_t *Msg)
+{
+    DISPLAY_Data.XferStatusTlm.Payload = *DISPLAY_XferGetStatus();
+
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.XferStatusTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.XferStatusTlm.TlmHeader.Msg, true);
+
+    if (Msg != NULL)
+    {
+        DISPLAY_Data.CmdCounter++;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_XferStatusCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ClientRegisterCmd                                          */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Give a producer app a draw pipe and a viewport, or move the        */
+/*         viewport of one already registered                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ClientRegisterCmd(const DISPLAY_ClientRegisterCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_ClientRegister(Msg->DrawMid, Msg->X, Msg->Y, Msg->Width, Msg->Height, Msg->Layer);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_CLIENT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: cannot register client MID 0x%lx, RC = 0x%08lX", (unsigned long)Msg->DrawMid,
+                          (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(DISPLAY_CLIENT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "DISPLAY: client MID 0x%lx draws at %u,%u size %ux%u on layer %u",
+                      (unsigned long)Msg->DrawMid, (unsigned int)Msg->X, (unsigned int)Msg->Y,
+                      (unsigned int)Msg->Width, (unsigned int)Msg->Height, (unsigned int)Msg->Layer);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ClientRegisterCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ClientUnregisterCmd                                        */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Drop a producer app and delete its draw pipe                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 DISPLAY_ClientUnregisterCmd(const DISPLAY_ClientUnregisterCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_ClientUnregister(Msg->DrawMid);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_CLIENT_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no client with MID 0x%lx",
+                          (unsigned long)Msg->DrawMid);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(DISPLAY_CLIENT_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: client MID 0x%lx removed",
+                      (unsigned long)Msg->DrawMid);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ClientUnregisterCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ClientListCmd                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the client listing packet                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ClientListCmd(const DISPLAY_ClientListCmd_t *Msg)
+{
+    DISPLAY_ClientList(&DISPLAY_Data.ClientListTlm.Payload);
+
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.ClientListTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.ClientListTlm.TlmHeader.Msg, true);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ClientListCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_LayerSet                                                   */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Restack, show or hide a layer and set its transparent color        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_LayerSet(const DISPLAY_LayerSetCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_RenderSetLayer(Msg->layer, Msg->z, Msg->visible != 0, Msg->keyEnabled != 0, Msg->keyColor);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: invalid layer %u",
+                          (unsigned int)Msg->layer);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_LayerSet */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_LayerSelect                                                */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Direct following ground draw commands to a layer                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_LayerSelect(const DISPLAY_LayerSelectCmd_t *Msg)
+{
+    if (Msg->layer >= DISPLAY_MAX_LAYERS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: invalid layer %u",
+                          (unsigned int)Msg->layer);
+        DISPLAY_Data.ErrCounter++;
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    DISPLAY_RenderSetTarget(Msg->layer, NULL);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_LayerSelect */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_RecordStartCmd                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start logging handled messages to a file                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_RecordStartCmd(const DISPLAY_RecordStartCmd_t *Msg)
+{
+    char  Path[DISPLAY_RECORD_PATH_LEN];
+    int32 status;
+
+    strncpy(Path, Msg->Filename, sizeof(Path) - 1);
+    Path[sizeof(Path) - 1] = '\0';
+
+    status = DISPLAY_RecordStart(Path);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_RECORD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: could not start command log %s, RC = 0x%08lX", Path, (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(DISPLAY_RECORD_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: recording commands to %s",
+                      Path);
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_RecordStartCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_RecordStopCmd                                              */
 /*                                                                            */
 /*  Purpose:                                                                  */
-/*         This function Process Ground Station Command                       */
+/*         Write out and close the command log                                */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
-int32 DISPLAY_ProcessTbl(const DISPLAY_ProcessCmd_t *Msg)
+int32 DISPLAY_RecordStopCmd(const DISPLAY_RecordStopCmd_t *Msg)
 {
-    int32            status;
-    DISPLAY_Table_t *TblPtr;
-    const char      *TableName = "DISPLAY.displayTable";
+    uint32 Messages;
+    uint32 Bytes;
+    int32  status;
 
-    /* Use of Table */
-    status = CFE_TBL_GetAddress((void *)&TblPtr, DISPLAY_Data.TblHandles[0]);
+    status = DISPLAY_RecordStop();
+    DISPLAY_RecordGetStats(&Messages, &Bytes);
 
-    if (status < CFE_SUCCESS)
+    if (status != CFE_SUCCESS)
     {
-        CFE_ES_WriteToSysLog("Display: Fail to get table address: 0x%08lx", (unsigned long)status);
+        CFE_EVS_SendEvent(DISPLAY_RECORD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: command log write failed, RC = 0x%08lX", (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
         return status;
     }
 
-    CFE_ES_WriteToSysLog("Display: Table Device Path %s", TblPtr->DevicePath);
+    CFE_EVS_SendEvent(DISPLAY_RECORD_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "DISPLAY: command log closed, %lu messages, %lu bytes", (unsigned long)Messages,
+                      (unsigned long)Bytes);
+    DISPLAY_Data.CmdCounter++;
 
-    DISPLAY_GetCrc(TableName);
+    return CFE_SUCCESS;
 
-    status = CFE_TBL_ReleaseAddress(DISPLAY_Data.TblHandles[0]);
+} /* End of DISPLAY_RecordStopCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_AnimSetCmd                                                 */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Define or replace a keyframe animation                             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_AnimSetCmd(const DISPLAY_AnimSetCmd_t *Msg)
+{
+    int32 status;
+
+    status = DISPLAY_AnimSet(Msg);
     if (status != CFE_SUCCESS)
     {
-        CFE_ES_WriteToSysLog("Display: Fail to release table address: 0x%08lx", (unsigned long)status);
+        CFE_EVS_SendEvent(DISPLAY_ANIM_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: invalid animation %u: target %u, property %u, %u keys, period %lu ms",
+                          (unsigned int)Msg->Id, (unsigned int)Msg->Target, (unsigned int)Msg->Property,
+                          (unsigned int)Msg->KeyCount, (unsigned long)Msg->PeriodMs);
+        DISPLAY_Data.ErrCounter++;
+        return status;
     }
 
-    return status;
+    CFE_EVS_SendEvent(DISPLAY_ANIM_INF_EID, CFE_EVS_EventType_DEBUG, "DISPLAY: animation %u defined on layer %u",
+                      (unsigned int)Msg->Id, (unsigned int)Msg->Layer);
+    DISPLAY_Data.CmdCounter++;
 
-} /* End of DISPLAY_ProcessTbl */
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_AnimSetCmd */
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-/*  Name:  DISPLAY_FillRect                                                     */
+/*  Name:  DISPLAY_AnimStopCmd                                                */
 /*                                                                            */
 /*  Purpose:                                                                  */
-/*         This function Process Ground Station Command                       */
+/*         Stop an animation, optionally erasing it                           */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
-int32 DISPLAY_FillRect(const DISPLAY_FillRectCmd_t *Msg)
+int32 DISPLAY_AnimStopCmd(const DISPLAY_AnimStopCmd_t *Msg)
 {
-    int32 status = CFE_SUCCESS;
+    int32 status;
 
-    // TODO
+    status = DISPLAY_AnimStop(Msg->Id, Msg->Clear != 0);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_ANIM_ERR_EID, CFE_EVS_EventType_ERROR, "DISPLAY: no animation %u",
+                          (unsigned int)Msg->Id);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
 
-    return status;
+    DISPLAY_Data.CmdCounter++;
 
-} /* End of DISPLAY_ProcessTbl */
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_AnimStopCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_CrcCmd                                                     */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the checksum of what the panel shows over a rectangle         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_CrcCmd(const DISPLAY_CrcCmd_t *Msg)
+{
+    DISPLAY_Rect_t Rect;
+    int32          status;
+
+    Rect.X = Msg->X;
+    Rect.Y = Msg->Y;
+    Rect.W = Msg->W;
+    Rect.H = Msg->H;
+
+    status = DISPLAY_RenderCrc(&Rect, &DISPLAY_Data.CrcTlm.Payload);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: cannot checksum %u,%u size %ux%u, RC = 0x%08lX", (unsigned int)Msg->X,
+                          (unsigned int)Msg->Y, (unsigned int)Msg->W, (unsigned int)Msg->H, (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.CrcTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.CrcTlm.TlmHeader.Msg, true);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_CrcCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_ScreenshotCmd                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Start streaming what the panel shows. The frame tick sends the     */
+/*         packets at the table's byte rate.                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+int32 DISPLAY_ScreenshotCmd(const DISPLAY_ScreenshotCmd_t *Msg)
+{
+    uint16 CaptureId;
+    uint16 Tiles;
+    int32  status;
+
+    status = DISPLAY_ShotStart(Msg->Mode, &CaptureId, &Tiles);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_SHOT_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: cannot start mode %u screenshot, RC = 0x%08lX", (unsigned int)Msg->Mode,
+                          (unsigned long)status);
+        DISPLAY_Data.ErrCounter++;
+        return status;
+    }
+
+    CFE_EVS_SendEvent(DISPLAY_SHOT_INF_EID, CFE_EVS_EventType_INFORMATION, "DISPLAY: screenshot %u started, %u tiles",
+                      (unsigned int)CaptureId, (unsigned int)Tiles);
+
+    DISPLAY_Data.CmdCounter++;
+
+    return CFE_SUCCESS;
+
+} /* End of DISPLAY_ScreenshotCmd */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_SendShotPacket                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the screenshot packet just filled in, cut to Size bytes       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_SendShotPacket(size_t Size)
+{
+    CFE_MSG_SetSize(&DISPLAY_Data.ShotTlm.TlmHeader.Msg, Size);
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.ShotTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.ShotTlm.TlmHeader.Msg, true);
+
+} /* End of DISPLAY_SendShotPacket */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_AckDraw                                                    */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Note a draw for acknowledgement after the next flush, when it was  */
+/*         made and carries a DISPLAY_DrawSeq_t after its CmdLength bytes     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_AckDraw(const CFE_SB_Buffer_t *SBBufPtr, size_t CmdLength, int32 Status)
+{
+    DISPLAY_DrawSeq_t  Seq;
+    CFE_TIME_SysTime_t Sent         = {0, 0};
+    size_t             ActualLength = 0;
+    CFE_SB_MsgId_t     MsgId        = CFE_SB_INVALID_MSG_ID;
+
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &ActualLength);
+    if (Status != CFE_SUCCESS || ActualLength != CmdLength + sizeof(Seq))
+    {
+        return;
+    }
+
+    memcpy(&Seq, (const uint8 *)SBBufPtr + CmdLength, sizeof(Seq));
+
+    Sent.Seconds    = Seq.SentSeconds;
+    Sent.Subseconds = Seq.SentSubseconds;
+    if (Sent.Seconds == 0 && Sent.Subseconds == 0)
+    {
+        /* Standard command headers carry no time and report an error */
+        if (CFE_MSG_GetMsgTime(&SBBufPtr->Msg, &Sent) != CFE_SUCCESS || (Sent.Seconds == 0 && Sent.Subseconds == 0))
+        {
+            Sent = CFE_TIME_GetTime();
+        }
+    }
+
+    CFE_MSG_GetMsgId(&SBBufPtr->Msg, &MsgId);
+    DISPLAY_AckNote(CFE_SB_MsgIdToValue(MsgId), Seq.Sequence, Sent);
+
+} /* End of DISPLAY_AckDraw */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_SendAckPacket                                              */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Send the draw acknowledgement packet just filled in                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_SendAckPacket(void)
+{
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.AckTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.AckTlm.TlmHeader.Msg, true);
+
+} /* End of DISPLAY_SendAckPacket */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_SendFlowPacket                                             */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Transmit the command pipe flow packet just filled in               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_SendFlowPacket(void)
+{
+    CFE_SB_TimeStampMsg(&DISPLAY_Data.FlowTlm.TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&DISPLAY_Data.FlowTlm.TlmHeader.Msg, true);
+
+} /* End of DISPLAY_SendFlowPacket */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*  Name:  DISPLAY_RecordPacket                                               */
+/*                                                                            */
+/*  Purpose:                                                                  */
+/*         Log one received message while recording. A failed write stops     */
+/*         the recorder and is reported once.                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
+void DISPLAY_RecordPacket(uint8 Source, const CFE_SB_Buffer_t *SBBufPtr)
+{
+    if (DISPLAY_RecordMessage(Source, SBBufPtr) != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_RECORD_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "DISPLAY: command log write failed, recording stopped");
+    }
+
+} /* End of DISPLAY_RecordPacket */
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
@@ -517,6 +2005,84 @@ bool DISPLAY_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
 
 } /* End of DISPLAY_VerifyCmdLength() */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* DISPLAY_VerifyDrawLength() -- Verify draw command length, with or without  */
+/*                               a DISPLAY_DrawSeq_t                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool DISPLAY_VerifyDrawLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
+{
+    bool              result       = true;
+    size_t            ActualLength = 0;
+    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t FcnCode      = 0;
+
+    CFE_MSG_GetSize(MsgPtr, &ActualLength);
+
+    /*
+    ** Verify the command packet length.
+    */
+    if (ActualLength != ExpectedLength && ActualLength != ExpectedLength + sizeof(DISPLAY_DrawSeq_t))
+    {
+        CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+        CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
+
+        CFE_EVS_SendEvent(DISPLAY_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u or %u",
+                          (unsigned int) CFE_SB_MsgIdToValue(MsgId),
+                          (unsigned int) FcnCode,
+                          (unsigned int) ActualLength,
+                          (unsigned int) ExpectedLength,
+                          (unsigned int) (ExpectedLength + sizeof(DISPLAY_DrawSeq_t)));
+
+        result = false;
+
+        DISPLAY_Data.ErrCounter++;
+    }
+
+    return (result);
+
+} /* End of DISPLAY_VerifyDrawLength() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* DISPLAY_VerifyCmdMinLength() -- Verify variable length command packet      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool DISPLAY_VerifyCmdMinLength(CFE_MSG_Message_t *MsgPtr, size_t MinLength)
+{
+    bool              result       = true;
+    size_t            ActualLength = 0;
+    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t FcnCode      = 0;
+
+    CFE_MSG_GetSize(MsgPtr, &ActualLength);
+
+    /*
+    ** Verify the fixed part of the command is present.
+    */
+    if (ActualLength < MinLength)
+    {
+        CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+        CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
+
+        CFE_EVS_SendEvent(DISPLAY_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Minimum = %u",
+                          (unsigned int) CFE_SB_MsgIdToValue(MsgId),
+                          (unsigned int) FcnCode,
+                          (unsigned int) ActualLength,
+                          (unsigned int) MinLength);
+
+        result = false;
+
+        DISPLAY_Data.ErrCounter++;
+    }
+
+    return (result);
+
+} /* End of DISPLAY_VerifyCmdMinLength() */
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
 /* DISPLAY_TblValidationFunc -- Verify contents of First Table      */
@@ -527,6 +2093,8 @@ int32 DISPLAY_TblValidationFunc(void *TblData)
 {
     int32 ReturnCode = 0;
     struct stat filestats;
+    uint32 PoolTotal;
+    int i;
     
 
     DISPLAY_Table_t *TblDataPtr = (DISPLAY_Table_t *)TblData;
@@ -544,6 +2112,71 @@ int32 DISPLAY_TblValidationFunc(void *TblData)
         ReturnCode = DISPLAY_TBL_ERR_EID;
     }
 
+    PoolTotal = 0;
+    for (i = 0; i < DISPLAY_POOL_COUNT; i++)
+    {
+        if (TblDataPtr->PoolSize[i] > DISPLAY_ARENA_MAX_SIZE - PoolTotal)
+        {
+            PoolTotal = DISPLAY_ARENA_MAX_SIZE + 1;
+            break;
+        }
+        PoolTotal += TblDataPtr->PoolSize[i];
+    }
+    if (PoolTotal > DISPLAY_ARENA_MAX_SIZE)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR,
+                "Pool sizes exceed the %lu byte arena limit!", (unsigned long)DISPLAY_ARENA_MAX_SIZE);
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
+    if (TblDataPtr->Rotation > DISPLAY_ROTATE_270)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR,
+                "Invalid rotation %u!", (unsigned int)TblDataPtr->Rotation);
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
+    /* A zero budget would starve every client */
+    if (TblDataPtr->ClientMsgBudget == 0 || TblDataPtr->ClientPixelBudget == 0 ||
+        TblDataPtr->ClientPixelBudget > 0x7FFFFFFF)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR,
+                "Invalid client budget %u messages, %lu pixels!", (unsigned int)TblDataPtr->ClientMsgBudget,
+                (unsigned long)TblDataPtr->ClientPixelBudget);
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
+    if (TblDataPtr->PanelGamma < 100 || TblDataPtr->PanelGamma > 400 || TblDataPtr->Brightness == 0 ||
+        TblDataPtr->Brightness > 100)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR,
+                "Invalid panel gamma %u or brightness %u%%!", (unsigned int)TblDataPtr->PanelGamma,
+                (unsigned int)TblDataPtr->Brightness);
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
+    if (TblDataPtr->Workers > DISPLAY_BAND_MAX_WORKERS)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid worker count %u, most is %u!",
+                (unsigned int)TblDataPtr->Workers, (unsigned int)DISPLAY_BAND_MAX_WORKERS);
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
+    /* A zero rate would never finish a capture */
+    if (TblDataPtr->ShotBytesPerSec == 0)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid screenshot rate 0 bytes/s!");
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
+    /* Every flush may wait up to a period, so a slow one would stall commands */
+    if (TblDataPtr->RefreshUs > DISPLAY_MAX_REFRESH_US)
+    {
+        CFE_EVS_SendEvent(DISPLAY_TBL_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid refresh period %lu us, most is %lu!",
+                (unsigned long)TblDataPtr->RefreshUs, (unsigned long)DISPLAY_MAX_REFRESH_US);
+        ReturnCode = DISPLAY_TBL_ERR_EID;
+    }
+
     return ReturnCode;
 
 } /* End of DISPLAY_TBLValidationFunc() */
@@ -43,6 +43,8 @@
 #include "display_msg.h"
 #include "display_table.h"
 #include "display_events.h"
+#include "display_draw.h"
+#include "display_lib.h"
 
 /***********************************************************************/
 #define DISPLAY_PIPE_DEPTH 32 /* Depth of the Command Pipe for Application */
@@ -75,6 +77,46 @@ typedef struct
     */
     DISPLAY_HkTlm_t HkTlm;
 
+    /*
+    ** Image slot listing packet...
+    */
+    DISPLAY_ImageListTlm_t ImageListTlm;
+
+    /*
+    ** Segmented transfer status packet...
+    */
+    DISPLAY_XferStatusTlm_t XferStatusTlm;
+
+    /*
+    ** Client listing packet...
+    */
+    DISPLAY_ClientListTlm_t ClientListTlm;
+
+    /*
+    ** Flush performance packet...
+    */
+    DISPLAY_PerfTlm_t PerfTlm;
+
+    /*
+    ** Displayed content checksum packet...
+    */
+    DISPLAY_CrcTlm_t CrcTlm;
+
+    /*
+    ** Screenshot stream packet...
+    */
+    DISPLAY_ShotTlm_t ShotTlm;
+
+    /*
+    ** Draw acknowledgement packet...
+    */
+    DISPLAY_AckTlm_t AckTlm;
+
+    /*
+    ** Command pipe flow packet...
+    */
+    DISPLAY_FlowTlm_t FlowTlm;
+
     /*
     ** Run Status variable used in the main processing loop
     */
@@ -84,6 +126,8 @@ typedef struct
     ** Operational data (not reported in housekeeping)...
     */
     CFE_SB_PipeId_t CommandPipe;
+    uint16          PanelGamma; /* Table colors the draw LUT was last built for */
+    uint8           Brightness;
 
     /*
     ** Initialization data (not reported in housekeeping)...
@@ -107,15 +151,51 @@ void  DISPLAY_Main(void);
 int32 DISPLAY_Init(void);
 void  DISPLAY_ProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr);
 void  DISPLAY_ProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr);
+int32 DISPLAY_ProcessClientCommand(CFE_SB_Buffer_t *SBBufPtr);
+int32 DISPLAY_ProcessLibDraw(uint32 Source, const DISPLAY_LibOp_t *Op);
+void  DISPLAY_ServiceClients(void);
+void  DISPLAY_Present(bool Paced);
+void  DISPLAY_PipeDrained(void);
 int32 DISPLAY_ReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg);
 int32 DISPLAY_ResetCounters(const DISPLAY_ResetCountersCmd_t *Msg);
 int32 DISPLAY_ProcessTbl(const DISPLAY_ProcessCmd_t *Msg);
+int32 DISPLAY_DrawArea(DISPLAY_Rect_t *Rect, uint32 X, uint32 Y, uint32 W, uint32 H);
 int32 DISPLAY_FillRect(const DISPLAY_FillRectCmd_t *Msg);
+int32 DISPLAY_Gradient(const DISPLAY_GradientCmd_t *Msg);
+int32 DISPLAY_ImageUpload(const DISPLAY_ImageUploadCmd_t *Msg);
+int32 DISPLAY_ImageFreeSlot(const DISPLAY_ImageFreeCmd_t *Msg);
+int32 DISPLAY_ImageListSlots(const DISPLAY_ImageListCmd_t *Msg);
+int32 DISPLAY_DrawImage(const DISPLAY_DrawImageCmd_t *Msg);
+int32 DISPLAY_TextCmd(const DISPLAY_TextCmd_t *Msg);
+int32 DISPLAY_XferBeginCmd(const DISPLAY_XferBeginCmd_t *Msg);
+int32 DISPLAY_XferChunkCmd(const DISPLAY_XferChunkCmd_t *Msg);
+int32 DISPLAY_XferCommitCmd(const DISPLAY_XferCommitCmd_t *Msg);
+int32 DISPLAY_XferAbortCmd(const DISPLAY_XferAbortCmd_t *Msg);
+int32 DISPLAY_XferStatusCmd(const DISPLAY_XferStatusCmd_t *Msg);
+int32 DISPLAY_ClientRegisterCmd(const DISPLAY_ClientRegisterCmd_t *Msg);
+int32 DISPLAY_ClientUnregisterCmd(const DISPLAY_ClientUnregisterCmd_t *Msg);
+int32 DISPLAY_ClientListCmd(const DISPLAY_ClientListCmd_t *Msg);
+int32 DISPLAY_LayerSet(const DISPLAY_LayerSetCmd_t *Msg);
+int32 DISPLAY_LayerSelect(const DISPLAY_LayerSelectCmd_t *Msg);
+int32 DISPLAY_RecordStartCmd(const DISPLAY_RecordStartCmd_t *Msg);
+int32 DISPLAY_RecordStopCmd(const DISPLAY_RecordStopCmd_t *Msg);
+int32 DISPLAY_AnimSetCmd(const DISPLAY_AnimSetCmd_t *Msg);
+int32 DISPLAY_AnimStopCmd(const DISPLAY_AnimStopCmd_t *Msg);
+int32 DISPLAY_CrcCmd(const DISPLAY_CrcCmd_t *Msg);
+int32 DISPLAY_ScreenshotCmd(const DISPLAY_ScreenshotCmd_t *Msg);
+void  DISPLAY_SendShotPacket(size_t Size);
+void  DISPLAY_AckDraw(const CFE_SB_Buffer_t *SBBufPtr, size_t CmdLength, int32 Status);
+void  DISPLAY_SendAckPacket(void);
+void  DISPLAY_SendFlowPacket(void);
+void  DISPLAY_RecordPacket(uint8 Source, const CFE_SB_Buffer_t *SBBufPtr);
 int32 DISPLAY_Noop(const DISPLAY_NoopCmd_t *Msg);
 void  DISPLAY_GetCrc(const char *TableName);
+void  DISPLAY_CheckDevice(void);
 
 int32 DISPLAY_TblValidationFunc(void *TblData);
 
 bool DISPLAY_VerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
+bool DISPLAY_VerifyCmdMinLength(CFE_MSG_Message_t *MsgPtr, size_t MinLength);
+bool DISPLAY_VerifyDrawLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
 
 #endif /* DISPLAY_H */
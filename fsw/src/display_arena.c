@@ -0,0 +1,151 @@
+#include "display_arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** All memory the app uses for pixels and queues comes from one block
+** reserved at startup and split into fixed pools. Each pool is a bump
+** allocator; nothing is allocated from the heap after DISPLAY_ArenaInit.
+*/
+typedef struct
+{
+    uint8              *Base;
+    DISPLAY_PoolStats_t Stats;
+} DISPLAY_Pool_t;
+
+typedef struct
+{
+    uint8         *Block;
+    DISPLAY_Pool_t Pools[DISPLAY_POOL_COUNT];
+} DISPLAY_Arena_t;
+
+static DISPLAY_Arena_t Arena;
+
+#define DISPLAY_ARENA_ROUND(n, a) (((n) + ((a)-1)) & ~((a)-1))
+
+CFE_Status_t DISPLAY_ArenaInit(const uint32 PoolSize[DISPLAY_POOL_COUNT])
+{
+    uint32 Total = 0;
+    uint8 *Base;
+    int    i;
+
+    DISPLAY_ArenaClose();
+
+    for (i = 0; i < DISPLAY_POOL_COUNT; i++)
+    {
+        /* Checked pool by pool so a huge size cannot wrap the total */
+        if (PoolSize[i] > DISPLAY_ARENA_MAX_SIZE - Total)
+        {
+            return DISPLAY_STATUS_ERROR_RANGE;
+        }
+        Total += DISPLAY_ARENA_ROUND(PoolSize[i], DISPLAY_ARENA_ALIGN);
+    }
+
+    if (Total > DISPLAY_ARENA_MAX_SIZE)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    /* The one and only heap allocation; aligned by hand to stay C99 */
+    Arena.Block = malloc(Total + DISPLAY_ARENA_ALIGN);
+    if (Arena.Block == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    Base = (uint8 *)DISPLAY_ARENA_ROUND((uintptr_t)Arena.Block, DISPLAY_ARENA_ALIGN);
+    for (i = 0; i < DISPLAY_POOL_COUNT; i++)
+    {
+        Arena.Pools[i].Base       = Base;
+        Arena.Pools[i].Stats.Size = PoolSize[i];
+        Base += DISPLAY_ARENA_ROUND(PoolSize[i], DISPLAY_ARENA_ALIGN);
+    }
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_ArenaClose(void)
+{
+    free(Arena.Block);
+    memset(&Arena, 0, sizeof(Arena));
+}
+
+/*
+** Take Size bytes from the top of Pool, aligned to Align (a power of two
+** no larger than DISPLAY_ARENA_ALIGN). Returns NULL when the pool is full.
+*/
+void *DISPLAY_ArenaAlloc(uint8 Pool, uint32 Size, uint32 Align)
+{
+    DISPLAY_Pool_t *PoolPtr;
+    uint32          Start;
+
+    if (Pool >= DISPLAY_POOL_COUNT)
+    {
+        return NULL;
+    }
+
+    PoolPtr = &Arena.Pools[Pool];
+    Start   = DISPLAY_ARENA_ROUND(PoolPtr->Stats.Used, Align);
+
+    if (PoolPtr->Base == NULL || Start > PoolPtr->Stats.Size || Size > PoolPtr->Stats.Size - Start)
+    {
+        PoolPtr->Stats.Failures++;
+        return NULL;
+    }
+
+    PoolPtr->Stats.Used = Start + Size;
+    if (PoolPtr->Stats.Used > PoolPtr->Stats.HighWater)
+    {
+        PoolPtr->Stats.HighWater = PoolPtr->Stats.Used;
+    }
+
+    return PoolPtr->Base + Start;
+}
+
+/*
+** Release everything allocated from Pool
+*/
+void DISPLAY_ArenaReset(uint8 Pool)
+{
+    if (Pool < DISPLAY_POOL_COUNT)
+    {
+        Arena.Pools[Pool].Stats.Used = 0;
+    }
+}
+
+/*
+** Give back the top Size bytes of Pool, for owners that compact their
+** allocations toward the pool base
+*/
+void DISPLAY_ArenaShrink(uint8 Pool, uint32 Size)
+{
+    if (Pool < DISPLAY_POOL_COUNT)
+    {
+        if (Size > Arena.Pools[Pool].Stats.Used)
+        {
+            Size = Arena.Pools[Pool].Stats.Used;
+        }
+        Arena.Pools[Pool].Stats.Used -= Size;
+    }
+}
+
+uint32 DISPLAY_ArenaAvailable(uint8 Pool)
+{
+    if (Pool >= DISPLAY_POOL_COUNT)
+    {
+        return 0;
+    }
+
+    return Arena.Pools[Pool].Stats.Size - Arena.Pools[Pool].Stats.Used;
+}
+
+void DISPLAY_ArenaGetStats(DISPLAY_PoolStats_t Stats[DISPLAY_POOL_COUNT])
+{
+    int i;
+
+    for (i = 0; i < DISPLAY_POOL_COUNT; i++)
+    {
+        Stats[i] = Arena.Pools[i].Stats;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef DISPLAY_ARENA__H_
+#define DISPLAY_ARENA__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_msg.h"
+
+/* Alignment of every pool base; a cache line on all supported targets */
+#define DISPLAY_ARENA_ALIGN 64
+
+/* Upper bound on the sum of the table's pool sizes */
+#define DISPLAY_ARENA_MAX_SIZE (64 * 1024 * 1024)
+
+CFE_Status_t DISPLAY_ArenaInit(const uint32 PoolSize[DISPLAY_POOL_COUNT]);
+void         DISPLAY_ArenaClose(void);
+
+void  *DISPLAY_ArenaAlloc(uint8 Pool, uint32 Size, uint32 Align);
+void   DISPLAY_ArenaReset(uint8 Pool);
+void   DISPLAY_ArenaShrink(uint8 Pool, uint32 Size);
+uint32 DISPLAY_ArenaAvailable(uint8 Pool);
+
+void DISPLAY_ArenaGetStats(DISPLAY_PoolStats_t Stats[DISPLAY_POOL_COUNT]);
+
+#endif // DISPLAY_ARENA__H_
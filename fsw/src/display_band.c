@@ -0,0 +1,225 @@
+#include "display_band.h"
+#include "display_msg.h"
+#include "display_perfids.h"
+#include "cfe_es.h"
+#include "osapi.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+** Worker pool for large draws. A job covering many rows is cut into
+** horizontal bands, one per task taking part, and the app task and the
+** pool's child tasks take bands in turn until none are left. The app task
+** then waits for every worker it woke before going on, so a job is
+** complete, and its rows are in memory, when DISPLAY_BandRun returns.
+**
+** Bands never overlap and their edges depend only on the rows of the job
+** and the size of the pool, never on which task takes which band or when,
+** so the result is the same bit for bit as drawing on one task. Edges are
+** kept on the dither period so an ordered dither lines up across them.
+** Small jobs, and every job when the pool is empty, run on the app task
+** alone.
+*/
+typedef struct
+{
+    DISPLAY_BandFunc_t Func;
+    const void        *Arg;
+    int32              Y;
+    int32              Rows;
+    uint32             Count; /* Bands in the job */
+    uint32             Next;  /* Next band to be taken, shared by all tasks */
+} DISPLAY_BandJob_t;
+
+typedef struct
+{
+    CFE_ES_TaskId_t   TaskIds[DISPLAY_BAND_MAX_WORKERS];
+    uint8             Workers; /* Child tasks running */
+    osal_id_t         GoSem;   /* Given once per worker woken for a job */
+    osal_id_t         DoneSem; /* Given once per wake when the worker is done */
+    DISPLAY_BandJob_t Job;
+    uint32            Jobs; /* Jobs split across more than one task */
+} DISPLAY_Band_t;
+
+static DISPLAY_Band_t Band;
+
+/*
+** First row of band k
+*/
+static int32 DISPLAY_BandEdge(const DISPLAY_BandJob_t *Job, uint32 k)
+{
+    int32 Edge;
+
+    if (k == 0)
+    {
+        return Job->Y;
+    }
+    if (k >= Job->Count)
+    {
+        return Job->Y + Job->Rows;
+    }
+
+    Edge = Job->Y + (int32)(((int64)Job->Rows * k) / Job->Count);
+
+    return Edge - (Edge % DISPLAY_BAND_ALIGN);
+}
+
+/*
+** Take and draw bands of the current job until there are none left
+*/
+static void DISPLAY_BandWork(void)
+{
+    DISPLAY_BandJob_t *Job = &Band.Job;
+    uint32             k;
+    int32              First;
+
+    while ((k = __atomic_fetch_add(&Job->Next, 1, __ATOMIC_RELAXED)) < Job->Count)
+    {
+        First = DISPLAY_BandEdge(Job, k);
+        Job->Func(First, DISPLAY_BandEdge(Job, k + 1) - First, Job->Arg);
+    }
+}
+
+static void DISPLAY_BandWorker(void)
+{
+    while (OS_CountSemTake(Band.GoSem) == OS_SUCCESS)
+    {
+        CFE_ES_PerfLogEntry(DISPLAY_BAND_PERF_ID);
+        DISPLAY_BandWork();
+        CFE_ES_PerfLogExit(DISPLAY_BAND_PERF_ID);
+
+        OS_CountSemGive(Band.DoneSem);
+    }
+
+    CFE_ES_ExitChildTask();
+}
+
+/*
+** Start Workers child tasks. If one cannot be started the pool keeps those
+** that were, and draws stay correct with however many there are.
+*/
+CFE_Status_t DISPLAY_BandInit(uint8 Workers)
+{
+    CFE_Status_t status;
+    char         Name[OS_MAX_API_NAME];
+    uint8        i;
+
+    DISPLAY_BandClose();
+
+    if (Workers > DISPLAY_BAND_MAX_WORKERS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+    if (Workers == 0)
+    {
+        return CFE_SUCCESS;
+    }
+
+    status = OS_CountSemCreate(&Band.GoSem, "DISPLAY_BAND_GO", 0, 0);
+    if (status != OS_SUCCESS)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    status = OS_CountSemCreate(&Band.DoneSem, "DISPLAY_BAND_DONE", 0, 0);
+    if (status != OS_SUCCESS)
+    {
+        OS_CountSemDelete(Band.GoSem);
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    for (i = 0; i < Workers; i++)
+    {
+        snprintf(Name, sizeof(Name), "DISPLAY_BAND%u", (unsigned int)i);
+
+        status = CFE_ES_CreateChildTask(&Band.TaskIds[i], Name, DISPLAY_BandWorker, CFE_ES_TASK_STACK_ALLOCATE,
+                                        DISPLAY_BAND_STACK_SIZE, DISPLAY_BAND_PRIORITY, 0);
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+
+        Band.Workers++;
+    }
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_BandClose(void)
+{
+    uint8 i;
+
+    for (i = 0; i < Band.Workers; i++)
+    {
+        CFE_ES_DeleteChildTask(Band.TaskIds[i]);
+    }
+
+    if (OS_ObjectIdDefined(Band.GoSem))
+    {
+        OS_CountSemDelete(Band.GoSem);
+        OS_CountSemDelete(Band.DoneSem);
+    }
+
+    memset(&Band, 0, sizeof(Band));
+}
+
+/*
+** Run Func over rows Y to Y + Rows - 1 of a job Width pixels wide, split
+** into as many bands as there are tasks to take them, but none smaller
+** than DISPLAY_BAND_MIN_PIXELS
+*/
+void DISPLAY_BandRun(int32 Y, int32 Rows, int32 Width, DISPLAY_BandFunc_t Func, const void *Arg)
+{
+    uint32 Count = Band.Workers + 1u;
+    uint64 Fit;
+    uint32 i;
+
+    if (Rows <= 0 || Width <= 0)
+    {
+        return;
+    }
+
+    Fit = ((uint64)Rows * (uint64)Width) / DISPLAY_BAND_MIN_PIXELS;
+    if (Fit < Count)
+    {
+        Count = (uint32)Fit;
+    }
+    if ((uint32)Rows / DISPLAY_BAND_ALIGN < Count)
+    {
+        Count = (uint32)Rows / DISPLAY_BAND_ALIGN;
+    }
+
+    if (Count <= 1)
+    {
+        Func(Y, Rows, Arg);
+        return;
+    }
+
+    Band.Job.Func  = Func;
+    Band.Job.Arg   = Arg;
+    Band.Job.Y     = Y;
+    Band.Job.Rows  = Rows;
+    Band.Job.Count = Count;
+    Band.Job.Next  = 0;
+
+    /* The app task takes bands too, so wake one worker fewer than there are bands */
+    for (i = 1; i < Count; i++)
+    {
+        OS_CountSemGive(Band.GoSem);
+    }
+
+    DISPLAY_BandWork();
+
+    for (i = 1; i < Count; i++)
+    {
+        OS_CountSemTake(Band.DoneSem);
+    }
+
+    Band.Jobs++;
+}
+
+void DISPLAY_BandGetStats(uint8 *Workers, uint32 *Jobs)
+{
+    *Workers = Band.Workers;
+    *Jobs    = Band.Jobs;
+}
@@ -0,0 +1,27 @@
+#ifndef DISPLAY_BAND__H_
+#define DISPLAY_BAND__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+
+/* Most child tasks the table may ask for */
+#define DISPLAY_BAND_MAX_WORKERS 8
+
+/* Band edges fall on multiples of this many rows, the period of the dither pattern */
+#define DISPLAY_BAND_ALIGN 4
+
+/* Fewest pixels per band worth waking a worker for */
+#define DISPLAY_BAND_MIN_PIXELS (32 * 1024)
+
+#define DISPLAY_BAND_STACK_SIZE 16384
+#define DISPLAY_BAND_PRIORITY   100
+
+/* Do the part of a job that covers rows Y to Y + Rows - 1 */
+typedef void (*DISPLAY_BandFunc_t)(int32 Y, int32 Rows, const void *Arg);
+
+CFE_Status_t DISPLAY_BandInit(uint8 Workers);
+void         DISPLAY_BandClose(void);
+void         DISPLAY_BandRun(int32 Y, int32 Rows, int32 Width, DISPLAY_BandFunc_t Func, const void *Arg);
+void         DISPLAY_BandGetStats(uint8 *Workers, uint32 *Jobs);
+
+#endif // DISPLAY_BAND__H_
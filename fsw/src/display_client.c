@@ -0,0 +1,268 @@
+#include "display_client.h"
+#include "display_msgids.h"
+#include "display_render.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+** Producer apps registered to draw into their own viewport. Each client
+** has a private pipe subscribed to its draw MID, so one app filling its
+** pipe never delays messages from another.
+**
+** Clients are serviced on the frame tick, one message per client per
+** turn, starting with a different client each tick. Every client gets a
+** message and a pixel budget per tick. A draw that overruns the pixel
+** budget is finished and the overrun is paid back on later ticks, so an
+** app redrawing the whole screen ends up drawing only every few ticks.
+**
+** Draws a client queues through display_lib share its turns and budgets
+** with its pipe, and are taken before the pipe on each turn.
+*/
+typedef struct
+{
+    CFE_SB_PipeId_t      Pipe;
+    int32                MsgCredit;
+    int32                PixelCredit;
+    DISPLAY_Rect_t       Viewport;
+    DISPLAY_ClientInfo_t Info;
+} DISPLAY_Client_t;
+
+typedef struct
+{
+    uint8            Next; /* Client served first on the next tick */
+    DISPLAY_Client_t Clients[DISPLAY_MAX_CLIENTS];
+} DISPLAY_ClientTable_t;
+
+static DISPLAY_ClientTable_t ClientTbl;
+
+void DISPLAY_ClientInit(void)
+{
+    uint8 i;
+
+    memset(&ClientTbl, 0, sizeof(ClientTbl));
+
+    /* Handles opened before a restart are stale */
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        DISPLAY_LibDetach(i);
+    }
+}
+
+void DISPLAY_ClientClose(void)
+{
+    int i;
+
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        if (ClientTbl.Clients[i].Info.DrawMid != 0)
+        {
+            CFE_SB_DeletePipe(ClientTbl.Clients[i].Pipe);
+        }
+
+        DISPLAY_LibDetach((uint8)i);
+    }
+
+    memset(&ClientTbl, 0, sizeof(ClientTbl));
+}
+
+static DISPLAY_Client_t *DISPLAY_ClientFind(uint32 DrawMid)
+{
+    int i;
+
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        if (ClientTbl.Clients[i].Info.DrawMid == DrawMid)
+        {
+            return &ClientTbl.Clients[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+** Add a client drawing on DrawMid, or move the viewport of the existing
+** one. DrawMid must not be one of the display's own message IDs.
+*/
+CFE_Status_t DISPLAY_ClientRegister(uint32 DrawMid, uint16 X, uint16 Y, uint16 Width, uint16 Height, uint8 Layer)
+{
+    DISPLAY_Client_t *Client;
+    CFE_Status_t      status;
+    char              PipeName[CFE_MISSION_MAX_API_LEN];
+
+    if (DrawMid == 0 || !CFE_SB_IsValidMsgId(CFE_SB_ValueToMsgId(DrawMid)) || DrawMid == DISPLAY_CMD_MID ||
+        DrawMid == DISPLAY_SEND_HK_MID || DrawMid == DISPLAY_WAKEUP_MID || Width == 0 || Height == 0 || Layer >= DISPLAY_MAX_LAYERS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Client = DISPLAY_ClientFind(DrawMid);
+    if (Client == NULL)
+    {
+        Client = DISPLAY_ClientFind(0);
+        if (Client == NULL)
+        {
+            return DISPLAY_STATUS_ERROR_NOMEM;
+        }
+
+        snprintf(PipeName, sizeof(PipeName), "DISPLAY_CLI_%u", (unsigned int)(Client - ClientTbl.Clients));
+
+        status = CFE_SB_CreatePipe(&Client->Pipe, DISPLAY_CLIENT_PIPE_DEPTH, PipeName);
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+
+        status = CFE_SB_Subscribe(CFE_SB_ValueToMsgId(DrawMid), Client->Pipe);
+        if (status != CFE_SUCCESS)
+        {
+            CFE_SB_DeletePipe(Client->Pipe);
+            return status;
+        }
+
+        memset(&Client->Info, 0, sizeof(Client->Info));
+        Client->Info.DrawMid = DrawMid;
+        Client->MsgCredit    = 0;
+        Client->PixelCredit  = 0;
+
+        DISPLAY_LibAttach((uint8)(Client - ClientTbl.Clients), DrawMid);
+    }
+
+    Client->Info.X      = X;
+    Client->Info.Y      = Y;
+    Client->Info.Width  = Width;
+    Client->Info.Height = Height;
+    Client->Info.Layer  = Layer;
+
+    Client->Viewport.X = X;
+    Client->Viewport.Y = Y;
+    Client->Viewport.W = Width;
+    Client->Viewport.H = Height;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Remove a client. Anything it drew stays on screen until drawn over.
+*/
+CFE_Status_t DISPLAY_ClientUnregister(uint32 DrawMid)
+{
+    DISPLAY_Client_t *Client = (DrawMid != 0) ? DISPLAY_ClientFind(DrawMid) : NULL;
+
+    if (Client == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    DISPLAY_LibDetach((uint8)(Client - ClientTbl.Clients));
+    CFE_SB_DeletePipe(Client->Pipe);
+    memset(Client, 0, sizeof(*Client));
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Top up a budget for a new tick. Unused credit does not accumulate, but
+** debt from an overrun is carried.
+*/
+static int32 DISPLAY_ClientRefill(int32 Credit, uint32 Budget)
+{
+    Credit += (int32)Budget;
+
+    return (Credit > (int32)Budget) ? (int32)Budget : Credit;
+}
+
+/*
+** Run queued draws from all clients for one tick, round robin, within
+** each client's budget. The caller flushes once afterwards.
+*/
+void DISPLAY_ClientService(uint32 MsgBudget, uint32 PixelBudget, DISPLAY_ClientDispatch_t Dispatch,
+                           DISPLAY_ClientLibDispatch_t LibDispatch)
+{
+    DISPLAY_Client_t *Client;
+    CFE_SB_Buffer_t  *SBBufPtr = NULL;
+    DISPLAY_LibOp_t   Op;
+    bool              Queued;
+    CFE_Status_t      status;
+    bool              Drained[DISPLAY_MAX_CLIENTS];
+    bool              Progress;
+    uint32            Before, Cost;
+    uint8             Layer;
+    int               n, i;
+
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        Client     = &ClientTbl.Clients[i];
+        Drained[i] = (Client->Info.DrawMid == 0);
+
+        Client->MsgCredit   = DISPLAY_ClientRefill(Client->MsgCredit, MsgBudget);
+        Client->PixelCredit = DISPLAY_ClientRefill(Client->PixelCredit, PixelBudget);
+    }
+
+    do
+    {
+        Progress = false;
+
+        for (n = 0; n < DISPLAY_MAX_CLIENTS; n++)
+        {
+            i      = (ClientTbl.Next + n) % DISPLAY_MAX_CLIENTS;
+            Client = &ClientTbl.Clients[i];
+
+            if (Drained[i] || Client->MsgCredit <= 0 || Client->PixelCredit <= 0)
+            {
+                continue;
+            }
+
+            Queued = DISPLAY_LibTake((uint8)i, &Op);
+            if (!Queued && CFE_SB_ReceiveBuffer(&SBBufPtr, Client->Pipe, CFE_SB_POLL) != CFE_SUCCESS)
+            {
+                Drained[i] = true;
+                continue;
+            }
+
+            Before = DISPLAY_RenderGetPixelCount();
+            Layer  = DISPLAY_RenderGetLayer();
+            DISPLAY_RenderSetTarget(Client->Info.Layer, &Client->Viewport);
+
+            status = Queued ? LibDispatch(Client->Info.DrawMid, &Op) : Dispatch(SBBufPtr);
+            if (status == CFE_SUCCESS)
+            {
+                Client->Info.Draws++;
+            }
+            else
+            {
+                Client->Info.Rejected++;
+            }
+
+            DISPLAY_RenderSetTarget(Layer, NULL);
+            Cost = DISPLAY_RenderGetPixelCount() - Before;
+
+            Client->Info.Pixels += Cost;
+            Client->MsgCredit--;
+            Client->PixelCredit -= (int32)Cost;
+
+            Progress = true;
+        }
+    } while (Progress);
+
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        if (!Drained[i])
+        {
+            ClientTbl.Clients[i].Info.Deferred++;
+        }
+    }
+
+    ClientTbl.Next = (ClientTbl.Next + 1) % DISPLAY_MAX_CLIENTS;
+}
+
+void DISPLAY_ClientList(DISPLAY_ClientListTlm_Payload_t *Payload)
+{
+    int i;
+
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        Payload->Clients[i] = ClientTbl.Clients[i].Info;
+    }
+}
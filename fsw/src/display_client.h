@@ -0,0 +1,32 @@
+#ifndef DISPLAY_CLIENT__H_
+#define DISPLAY_CLIENT__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "cfe_sb.h"
+#include "display_lib.h"
+#include "display_msg.h"
+
+#define DISPLAY_CLIENT_PIPE_DEPTH 16 /* Draw messages a client may queue between ticks */
+
+/*
+** Runs one draw message from a client pipe with the client's viewport
+** selected. Returns CFE_SUCCESS when the message was a valid draw.
+*/
+typedef CFE_Status_t (*DISPLAY_ClientDispatch_t)(CFE_SB_Buffer_t *SBBufPtr);
+
+/*
+** Runs one draw a client queued through display_lib, likewise. Source is
+** the client's draw MID.
+*/
+typedef CFE_Status_t (*DISPLAY_ClientLibDispatch_t)(uint32 Source, const DISPLAY_LibOp_t *Op);
+
+void         DISPLAY_ClientInit(void);
+void         DISPLAY_ClientClose(void);
+CFE_Status_t DISPLAY_ClientRegister(uint32 DrawMid, uint16 X, uint16 Y, uint16 Width, uint16 Height, uint8 Layer);
+CFE_Status_t DISPLAY_ClientUnregister(uint32 DrawMid);
+void         DISPLAY_ClientService(uint32 MsgBudget, uint32 PixelBudget, DISPLAY_ClientDispatch_t Dispatch,
+                                   DISPLAY_ClientLibDispatch_t LibDispatch);
+void         DISPLAY_ClientList(DISPLAY_ClientListTlm_Payload_t *Payload);
+
+#endif // DISPLAY_CLIENT__H_
@@ -0,0 +1,158 @@
+#include "display_crc.h"
+#include "display_arena.h"
+#include "display_msg.h"
+#include "cfe_es.h"
+
+#include <string.h>
+
+/*
+** Per-tile CRCs of the composited frame. The renderer refreshes the tiles
+** under each area it has just composited, while those pixels are still in
+** cache, so answering a checksum request only combines stored tile CRCs.
+*/
+typedef struct
+{
+    const DISPLAY_Surface_t *Frame;
+    uint16                  *Tiles; /* Row order, TilesX per row */
+    uint32                   TilesX;
+    uint32                   TilesY;
+} DISPLAY_Crc_t;
+
+static DISPLAY_Crc_t Crc;
+
+/*
+** Size the tile table for Frame, from the frame pool. Frame must stay
+** valid until the next configure or close.
+*/
+CFE_Status_t DISPLAY_CrcConfigure(const DISPLAY_Surface_t *Frame)
+{
+    uint32 Count;
+
+    Crc.TilesX = (Frame->Width + DISPLAY_CRC_TILE - 1) / DISPLAY_CRC_TILE;
+    Crc.TilesY = (Frame->Height + DISPLAY_CRC_TILE - 1) / DISPLAY_CRC_TILE;
+    Count      = Crc.TilesX * Crc.TilesY;
+
+    Crc.Tiles = DISPLAY_ArenaAlloc(DISPLAY_POOL_FRAME, Count * sizeof(uint16), sizeof(uint16));
+    if (Crc.Tiles == NULL)
+    {
+        DISPLAY_CrcClose();
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    memset(Crc.Tiles, 0, Count * sizeof(uint16));
+    Crc.Frame = Frame;
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_CrcClose(void)
+{
+    memset(&Crc, 0, sizeof(Crc));
+}
+
+/*
+** Tile grid cells covering Rect, clipped to the frame. False when none.
+*/
+static bool DISPLAY_CrcTileSpan(const DISPLAY_Rect_t *Rect, DISPLAY_Rect_t *Span)
+{
+    DISPLAY_Rect_t Clip = *Rect;
+
+    if (Crc.Tiles == NULL || !DISPLAY_RectClipToSurface(&Clip, Crc.Frame))
+    {
+        return false;
+    }
+
+    Span->X = Clip.X / DISPLAY_CRC_TILE;
+    Span->Y = Clip.Y / DISPLAY_CRC_TILE;
+    Span->W = (Clip.X + Clip.W + DISPLAY_CRC_TILE - 1) / DISPLAY_CRC_TILE - Span->X;
+    Span->H = (Clip.Y + Clip.H + DISPLAY_CRC_TILE - 1) / DISPLAY_CRC_TILE - Span->Y;
+
+    return true;
+}
+
+/*
+** Recompute the CRCs of every tile that Rect touches
+*/
+void DISPLAY_CrcUpdate(const DISPLAY_Rect_t *Rect)
+{
+    const DISPLAY_Surface_t *Frame = Crc.Frame;
+    DISPLAY_Rect_t           Span;
+    uint32                   Bpp;
+    uint32                   RowBytes;
+    uint32                   Value;
+    const uint8             *Row;
+    int32                    tx, ty, x0, y0, x1, y1, y;
+
+    if (!DISPLAY_CrcTileSpan(Rect, &Span))
+    {
+        return;
+    }
+
+    Bpp = Frame->Format.BytesPerPixel;
+
+    for (ty = Span.Y; ty < Span.Y + Span.H; ty++)
+    {
+        y0 = ty * DISPLAY_CRC_TILE;
+        y1 = (y0 + DISPLAY_CRC_TILE < (int32)Frame->Height) ? y0 + DISPLAY_CRC_TILE : (int32)Frame->Height;
+
+        for (tx = Span.X; tx < Span.X + Span.W; tx++)
+        {
+            x0       = tx * DISPLAY_CRC_TILE;
+            x1       = (x0 + DISPLAY_CRC_TILE < (int32)Frame->Width) ? x0 + DISPLAY_CRC_TILE : (int32)Frame->Width;
+            RowBytes = (uint32)(x1 - x0) * Bpp;
+            Value    = 0;
+
+            for (y = y0; y < y1; y++)
+            {
+                Row   = Frame->Pixels + (y * Frame->Stride) + (x0 * Bpp);
+                Value = CFE_ES_CalculateCRC(Row, RowBytes, Value, CFE_MISSION_ES_DEFAULT_CRC);
+            }
+
+            Crc.Tiles[(ty * Crc.TilesX) + tx] = (uint16)Value;
+        }
+    }
+}
+
+/*
+** Checksum of the tiles Rect touches: the CRC of their CRCs in row order.
+** Area is set to the frame area those tiles cover.
+*/
+CFE_Status_t DISPLAY_CrcArea(const DISPLAY_Rect_t *Rect, DISPLAY_Rect_t *Area, uint16 *Result, uint16 *Tiles)
+{
+    DISPLAY_Rect_t Span;
+    uint32         Value = 0;
+    int32          ty;
+
+    if (!DISPLAY_CrcTileSpan(Rect, &Span))
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    for (ty = Span.Y; ty < Span.Y + Span.H; ty++)
+    {
+        Value = CFE_ES_CalculateCRC(&Crc.Tiles[(ty * Crc.TilesX) + Span.X], Span.W * sizeof(uint16), Value,
+                                    CFE_MISSION_ES_DEFAULT_CRC);
+    }
+
+    Area->X = Span.X * DISPLAY_CRC_TILE;
+    Area->Y = Span.Y * DISPLAY_CRC_TILE;
+    Area->W = Span.W * DISPLAY_CRC_TILE;
+    Area->H = Span.H * DISPLAY_CRC_TILE;
+    DISPLAY_RectClipToSurface(Area, Crc.Frame);
+
+    *Result = (uint16)Value;
+    *Tiles  = (uint16)(Span.W * Span.H);
+
+    return CFE_SUCCESS;
+}
+
+/*
+** The tile table in row order, or NULL before the frame is configured
+*/
+const uint16 *DISPLAY_CrcTiles(uint32 *TilesX, uint32 *TilesY)
+{
+    *TilesX = Crc.TilesX;
+    *TilesY = Crc.TilesY;
+
+    return Crc.Tiles;
+}
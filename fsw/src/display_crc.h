@@ -0,0 +1,14 @@
+#ifndef DISPLAY_CRC__H_
+#define DISPLAY_CRC__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_draw.h"
+
+CFE_Status_t DISPLAY_CrcConfigure(const DISPLAY_Surface_t *Frame);
+void         DISPLAY_CrcClose(void);
+void         DISPLAY_CrcUpdate(const DISPLAY_Rect_t *Rect);
+CFE_Status_t DISPLAY_CrcArea(const DISPLAY_Rect_t *Rect, DISPLAY_Rect_t *Area, uint16 *Result, uint16 *Tiles);
+const uint16 *DISPLAY_CrcTiles(uint32 *TilesX, uint32 *TilesY);
+
+#endif // DISPLAY_CRC__H_
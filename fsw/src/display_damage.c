@@ -0,0 +1,129 @@
+#include "display_damage.h"
+
+#include <string.h>
+
+/*
+** Estimated time, in nanoseconds, to copy Rect to the device
+*/
+uint64 DISPLAY_DamageCost(const DISPLAY_Rect_t *Rect, const DISPLAY_CostModel_t *Model, uint32 Bpp)
+{
+    uint64 Bytes = (uint64)Rect->W * (uint64)Rect->H * Bpp;
+
+    return Model->OverheadNs + (Bytes * Model->PerBytePs) / 1000;
+}
+
+void DISPLAY_DamageClear(DISPLAY_DamageList_t *List)
+{
+    List->Count = 0;
+}
+
+static bool DISPLAY_DamageContains(const DISPLAY_Rect_t *Outer, const DISPLAY_Rect_t *Inner)
+{
+    return (Inner->X >= Outer->X && Inner->Y >= Outer->Y && Inner->X + Inner->W <= Outer->X + Outer->W &&
+            Inner->Y + Inner->H <= Outer->Y + Outer->H);
+}
+
+/*
+** Added cost of copying the bounding box of A and B instead of A and B
+** separately. Negative when merging saves time.
+*/
+static int64 DISPLAY_DamageMergeGain(const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B,
+                                     const DISPLAY_CostModel_t *Model, uint32 Bpp)
+{
+    DISPLAY_Rect_t Union;
+
+    DISPLAY_RectUnion(&Union, A, B);
+
+    return (int64)DISPLAY_DamageCost(&Union, Model, Bpp) -
+           (int64)(DISPLAY_DamageCost(A, Model, Bpp) + DISPLAY_DamageCost(B, Model, Bpp));
+}
+
+/*
+** Record a damaged area. When the list is full the new area is folded
+** into whichever entry that costs least, so damage is never lost.
+*/
+void DISPLAY_DamageAdd(DISPLAY_DamageList_t *List, const DISPLAY_Rect_t *Rect, const DISPLAY_CostModel_t *Model,
+                       uint32 Bpp)
+{
+    int64  Gain, BestGain = 0;
+    uint32 i, Best = 0;
+
+    if (DISPLAY_RectIsEmpty(Rect))
+    {
+        return;
+    }
+
+    for (i = 0; i < List->Count; i++)
+    {
+        if (DISPLAY_DamageContains(&List->Rects[i], Rect))
+        {
+            return;
+        }
+    }
+
+    if (List->Count < DISPLAY_DAMAGE_MAX_RECTS)
+    {
+        List->Rects[List->Count++] = *Rect;
+        return;
+    }
+
+    for (i = 0; i < List->Count; i++)
+    {
+        Gain = DISPLAY_DamageMergeGain(&List->Rects[i], Rect, Model, Bpp);
+        if (i == 0 || Gain < BestGain)
+        {
+            BestGain = Gain;
+            Best     = i;
+        }
+    }
+
+    DISPLAY_RectUnion(&List->Rects[Best], &List->Rects[Best], Rect);
+}
+
+/*
+** Turn the damage list into the set of copies to perform: repeatedly merge
+** the pair whose bounding box is cheapest relative to copying both, while
+** that saves time. Many small nearby areas become one copy; distant areas
+** stay separate rather than dragging in the untouched pixels between them.
+** Returns the estimated cost of the plan in nanoseconds.
+*/
+uint64 DISPLAY_DamagePlan(DISPLAY_DamageList_t *List, const DISPLAY_CostModel_t *Model, uint32 Bpp)
+{
+    int64  Gain, BestGain;
+    uint32 i, j, BestI = 0, BestJ = 0;
+    uint64 Cost = 0;
+
+    while (List->Count > 1)
+    {
+        BestGain = 0;
+
+        for (i = 0; i < List->Count; i++)
+        {
+            for (j = i + 1; j < List->Count; j++)
+            {
+                Gain = DISPLAY_DamageMergeGain(&List->Rects[i], &List->Rects[j], Model, Bpp);
+                if (Gain < BestGain)
+                {
+                    BestGain = Gain;
+                    BestI    = i;
+                    BestJ    = j;
+                }
+            }
+        }
+
+        if (BestGain >= 0)
+        {
+            break;
+        }
+
+        DISPLAY_RectUnion(&List->Rects[BestI], &List->Rects[BestI], &List->Rects[BestJ]);
+        List->Rects[BestJ] = List->Rects[--List->Count];
+    }
+
+    for (i = 0; i < List->Count; i++)
+    {
+        Cost += DISPLAY_DamageCost(&List->Rects[i], Model, Bpp);
+    }
+
+    return Cost;
+}
@@ -0,0 +1,33 @@
+#ifndef DISPLAY_DAMAGE__H_
+#define DISPLAY_DAMAGE__H_
+
+#include "common_types.h"
+#include "display_draw.h"
+#include "display_msg.h"
+
+/*
+** Time to copy a rectangle to the device, modelled as a fixed cost per
+** copy plus a cost per byte
+*/
+typedef struct
+{
+    uint32 OverheadNs; /* Per copy */
+    uint32 PerBytePs;  /* Per byte, in picoseconds */
+} DISPLAY_CostModel_t;
+
+/*
+** Areas changed since the last flush. Rectangles may overlap.
+*/
+typedef struct
+{
+    uint32         Count;
+    DISPLAY_Rect_t Rects[DISPLAY_DAMAGE_MAX_RECTS];
+} DISPLAY_DamageList_t;
+
+uint64 DISPLAY_DamageCost(const DISPLAY_Rect_t *Rect, const DISPLAY_CostModel_t *Model, uint32 Bpp);
+void   DISPLAY_DamageClear(DISPLAY_DamageList_t *List);
+void   DISPLAY_DamageAdd(DISPLAY_DamageList_t *List, const DISPLAY_Rect_t *Rect, const DISPLAY_CostModel_t *Model,
+                         uint32 Bpp);
+uint64 DISPLAY_DamagePlan(DISPLAY_DamageList_t *List, const DISPLAY_CostModel_t *Model, uint32 Bpp);
+
+#endif // DISPLAY_DAMAGE__H_
@@ -0,0 +1,242 @@
+#include "display_dither.h"
+
+#include <string.h>
+
+/*
+** Ordered (4x4 Bayer) dithering down to RGB565.
+**
+** Each 8 bit channel gets a position dependent threshold added before it
+** is truncated to 5 or 6 bits, which trades banding for a fixed fine
+** pattern. Thresholds are precomputed per row phase and starting column
+** phase as whole vectors, so the inner loops do one add, one shift and one
+** clamp per channel for DISPLAY_DITHER_LANES pixels at a time.
+**
+** Input channels are corrected for the panel (see display_draw.c) as they
+** are gathered into lanes. There is no portable vector gather from a byte
+** table, and the gather is a byte at a time already, so the lookup rides
+** on loads the vector code needs anyway.
+*/
+
+/* Pixels handled per step: one 128 bit register of 16 bit lanes */
+#define DISPLAY_DITHER_LANES 8
+
+#if defined(__GNUC__)
+typedef uint16 DISPLAY_DitherVec_t __attribute__((vector_size(DISPLAY_DITHER_LANES * sizeof(uint16))));
+#else
+typedef struct
+{
+    uint16 v[DISPLAY_DITHER_LANES];
+} DISPLAY_DitherVec_t;
+#endif
+
+static const uint8 DISPLAY_Bayer4[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+
+/*
+** [row phase][column phase] thresholds for 5 bit (red, blue) and 6 bit
+** (green) channels, laid out for DISPLAY_DITHER_LANES consecutive pixels
+*/
+static DISPLAY_DitherVec_t Thresh5[4][4];
+static DISPLAY_DitherVec_t Thresh6[4][4];
+
+void DISPLAY_DitherInit(void)
+{
+    uint16 t5[DISPLAY_DITHER_LANES];
+    uint16 t6[DISPLAY_DITHER_LANES];
+    int    row, phase, lane;
+
+    for (row = 0; row < 4; row++)
+    {
+        for (phase = 0; phase < 4; phase++)
+        {
+            for (lane = 0; lane < DISPLAY_DITHER_LANES; lane++)
+            {
+                uint8 b  = DISPLAY_Bayer4[row][(phase + lane) & 3];
+                t5[lane] = b / 2; /* 0..7, one 5 bit step is 8 */
+                t6[lane] = b / 4; /* 0..3, one 6 bit step is 4 */
+            }
+            memcpy(&Thresh5[row][phase], t5, sizeof(t5));
+            memcpy(&Thresh6[row][phase], t6, sizeof(t6));
+        }
+    }
+}
+
+/*
+** Quantize DISPLAY_DITHER_LANES pixels of 8 bit channels to RGB565.
+** (c + t) >> n can reach 32 (or 64); subtracting its top bit clamps it.
+*/
+static inline void DISPLAY_DitherStep(uint16 *Out, const uint16 *r, const uint16 *g, const uint16 *b,
+                                      const DISPLAY_DitherVec_t *T5, const DISPLAY_DitherVec_t *T6)
+{
+#if defined(__GNUC__)
+    DISPLAY_DitherVec_t vr, vg, vb;
+
+    memcpy(&vr, r, sizeof(vr));
+    memcpy(&vg, g, sizeof(vg));
+    memcpy(&vb, b, sizeof(vb));
+
+    vr = (vr + *T5) >> 3;
+    vg = (vg + *T6) >> 2;
+    vb = (vb + *T5) >> 3;
+    vr -= vr >> 5;
+    vg -= vg >> 6;
+    vb -= vb >> 5;
+
+    vr = (vr << 11) | (vg << 5) | vb;
+    memcpy(Out, &vr, sizeof(vr));
+#else
+    int    lane;
+    uint16 qr, qg, qb;
+
+    for (lane = 0; lane < DISPLAY_DITHER_LANES; lane++)
+    {
+        qr        = (r[lane] + T5->v[lane]) >> 3;
+        qg        = (g[lane] + T6->v[lane]) >> 2;
+        qb        = (b[lane] + T5->v[lane]) >> 3;
+        qr       -= qr >> 5;
+        qg       -= qg >> 6;
+        qb       -= qb >> 5;
+        Out[lane] = (uint16)((qr << 11) | (qg << 5) | qb);
+    }
+#endif
+}
+
+/*
+** Convert a packed RGB888 image to RGB565. Dst may be the same buffer as
+** Src: each step reads its 24 source bytes before writing 16 bytes that
+** all lie below the next step's source.
+*/
+void DISPLAY_DitherRgb888To565(uint16 *Dst, const uint8 *Src, uint32 Width, uint32 Height)
+{
+    uint16 r[DISPLAY_DITHER_LANES], g[DISPLAY_DITHER_LANES], b[DISPLAY_DITHER_LANES];
+    uint16       Out[DISPLAY_DITHER_LANES];
+    const uint8 *Lut = DISPLAY_DrawGetLut();
+    uint32       x, y, n, lane;
+
+    for (y = 0; y < Height; y++)
+    {
+        for (x = 0; x < Width; x += DISPLAY_DITHER_LANES)
+        {
+            n = (Width - x < DISPLAY_DITHER_LANES) ? Width - x : DISPLAY_DITHER_LANES;
+
+            for (lane = 0; lane < n; lane++, Src += 3)
+            {
+                r[lane] = Lut[Src[0]];
+                g[lane] = Lut[Src[1]];
+                b[lane] = Lut[Src[2]];
+            }
+
+            DISPLAY_DitherStep(Out, r, g, b, &Thresh5[y & 3][x & 3], &Thresh6[y & 3][x & 3]);
+            memcpy(Dst, Out, n * sizeof(uint16));
+            Dst += n;
+        }
+    }
+}
+
+/*
+** Corrected color at position Along of Steps along the gradient
+*/
+static inline void DISPLAY_DitherLerp(uint16 *r, uint16 *g, uint16 *b, const uint8 *Lut, DISPLAY_Color_t From,
+                                      DISPLAY_Color_t To, int32 Along, int32 Steps)
+{
+    *r = Lut[From.red + (((int32)To.red - From.red) * Along) / Steps];
+    *g = Lut[From.green + (((int32)To.green - From.green) * Along) / Steps];
+    *b = Lut[From.blue + (((int32)To.blue - From.blue) * Along) / Steps];
+}
+
+/*
+** Fill Rect with a linear gradient from From to To, left to right or top
+** to bottom. RGB565 surfaces are dithered; deeper surfaces get the exact
+** colors, which is what a dither would converge to anyway. Only the part
+** of Rect inside Clip is drawn, exactly as it would be in the whole.
+**
+** The dither pattern repeats every 4 pixels both ways, so a horizontal
+** gradient is computed for 4 rows and copied down, and a vertical one is
+** computed for one register of pixels per row and copied across.
+*/
+void DISPLAY_DitherGradient(DISPLAY_Surface_t *Surface, const DISPLAY_Rect_t *Rect, const DISPLAY_Rect_t *Clip,
+                            DISPLAY_Color_t From, DISPLAY_Color_t To, bool Vertical)
+{
+    DISPLAY_Rect_t  Area;
+    DISPLAY_Color_t Color;
+    uint16          r[DISPLAY_DITHER_LANES], g[DISPLAY_DITHER_LANES], b[DISPLAY_DITHER_LANES];
+    uint16          Out[DISPLAY_DITHER_LANES];
+    const uint8    *Lut   = DISPLAY_DrawGetLut();
+    int32           Steps = (Vertical ? Rect->H : Rect->W) - 1;
+    uint32          Bpp   = Surface->Format.BytesPerPixel;
+    uint32          Pixel;
+    uint8          *Row;
+    int32           x, y, n, lane;
+    bool            Dither;
+
+    if (Surface->Pixels == NULL || !DISPLAY_RectIntersect(&Area, Rect, Clip) ||
+        !DISPLAY_RectClipToSurface(&Area, Surface))
+    {
+        return;
+    }
+    if (Steps <= 0)
+    {
+        Steps = 1;
+    }
+
+    Dither = DISPLAY_DrawIsRgb565(&Surface->Format);
+
+    for (y = Area.Y; y < Area.Y + Area.H; y++)
+    {
+        Row = Surface->Pixels + (y * Surface->Stride) + (Area.X * Bpp);
+
+        if (!Vertical && y >= Area.Y + 4)
+        {
+            memcpy(Row, Row - (4 * Surface->Stride), Area.W * Bpp);
+            continue;
+        }
+
+        if (Vertical)
+        {
+            DISPLAY_DitherLerp(&r[0], &g[0], &b[0], Lut, From, To, y - Rect->Y, Steps);
+            for (lane = 1; lane < DISPLAY_DITHER_LANES; lane++)
+            {
+                r[lane] = r[0];
+                g[lane] = g[0];
+                b[lane] = b[0];
+            }
+        }
+
+        for (x = Area.X; x < Area.X + Area.W; x += n)
+        {
+            n = (Area.X + Area.W - x < DISPLAY_DITHER_LANES) ? Area.X + Area.W - x : DISPLAY_DITHER_LANES;
+
+            if (!Vertical)
+            {
+                for (lane = 0; lane < n; lane++)
+                {
+                    DISPLAY_DitherLerp(&r[lane], &g[lane], &b[lane], Lut, From, To, x + lane - Rect->X, Steps);
+                }
+            }
+
+            if (Dither)
+            {
+                /* A vertical row is one color, so its first step serves the whole row */
+                if (!Vertical || x == Area.X)
+                {
+                    DISPLAY_DitherStep(Out, r, g, b, &Thresh5[y & 3][x & 3], &Thresh6[y & 3][x & 3]);
+                }
+                memcpy(Row + ((x - Area.X) * Bpp), Out, n * sizeof(uint16));
+                continue;
+            }
+
+            for (lane = 0; lane < n; lane++)
+            {
+                Color.red   = (uint8)r[lane];
+                Color.green = (uint8)g[lane];
+                Color.blue  = (uint8)b[lane];
+                Pixel       = DISPLAY_DrawPackRaw(&Surface->Format, Color);
+                memcpy(Row + ((x + lane - Area.X) * Bpp), &Pixel, Bpp);
+            }
+        }
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef DISPLAY_DITHER__H_
+#define DISPLAY_DITHER__H_
+
+#include "common_types.h"
+#include "display_draw.h"
+
+void DISPLAY_DitherInit(void);
+void DISPLAY_DitherRgb888To565(uint16 *Dst, const uint8 *Src, uint32 Width, uint32 Height);
+void DISPLAY_DitherGradient(DISPLAY_Surface_t *Surface, const DISPLAY_Rect_t *Rect, const DISPLAY_Rect_t *Clip,
+                            DISPLAY_Color_t From, DISPLAY_Color_t To, bool Vertical);
+
+#endif // DISPLAY_DITHER__H_
@@ -0,0 +1,398 @@
+#include "display_draw.h"
+
+#include <math.h>
+#include <string.h>
+
+/*
+** Color correction. Colors arrive as 8 bit sRGB, taken here as a 2.2
+** power law, and the panel's response is another power law. One 256 entry
+** table per setting maps a channel value to the drive value that gives the
+** intended luminance scaled by the brightness, so the conversions that use
+** it pay one lookup per channel.
+*/
+#define DISPLAY_DRAW_SRGB_GAMMA 2.2
+
+static uint8  DrawLut[256];
+static uint16 DrawLutGamma;
+static uint8  DrawLutBrightness;
+
+bool DISPLAY_RectIsEmpty(const DISPLAY_Rect_t *Rect)
+{
+    return (Rect->W <= 0 || Rect->H <= 0);
+}
+
+/*
+** Out = A & B. Returns false (and an empty Out) when they do not overlap.
+*/
+bool DISPLAY_RectIntersect(DISPLAY_Rect_t *Out, const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B)
+{
+    int32 x0 = (A->X > B->X) ? A->X : B->X;
+    int32 y0 = (A->Y > B->Y) ? A->Y : B->Y;
+    int32 x1 = (A->X + A->W < B->X + B->W) ? A->X + A->W : B->X + B->W;
+    int32 y1 = (A->Y + A->H < B->Y + B->H) ? A->Y + A->H : B->Y + B->H;
+
+    if (x1 <= x0 || y1 <= y0)
+    {
+        memset(Out, 0, sizeof(*Out));
+        return false;
+    }
+
+    Out->X = x0;
+    Out->Y = y0;
+    Out->W = x1 - x0;
+    Out->H = y1 - y0;
+    return true;
+}
+
+/*
+** Out = bounding box of A and B. Empty inputs are ignored.
+*/
+void DISPLAY_RectUnion(DISPLAY_Rect_t *Out, const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B)
+{
+    int32 x0, y0, x1, y1;
+
+    if (DISPLAY_RectIsEmpty(A))
+    {
+        *Out = *B;
+        return;
+    }
+    if (DISPLAY_RectIsEmpty(B))
+    {
+        *Out = *A;
+        return;
+    }
+
+    x0 = (A->X < B->X) ? A->X : B->X;
+    y0 = (A->Y < B->Y) ? A->Y : B->Y;
+    x1 = (A->X + A->W > B->X + B->W) ? A->X + A->W : B->X + B->W;
+    y1 = (A->Y + A->H > B->Y + B->H) ? A->Y + A->H : B->Y + B->H;
+
+    Out->X = x0;
+    Out->Y = y0;
+    Out->W = x1 - x0;
+    Out->H = y1 - y0;
+}
+
+/*
+** Cut the part of A outside B into at most 4 rectangles: full width bands
+** above and below B, then the pieces left and right of it. Returns how
+** many were written to Out.
+*/
+uint32 DISPLAY_RectSubtract(DISPLAY_Rect_t Out[4], const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B)
+{
+    DISPLAY_Rect_t Overlap;
+    uint32         n = 0;
+
+    if (!DISPLAY_RectIntersect(&Overlap, A, B))
+    {
+        if (!DISPLAY_RectIsEmpty(A))
+        {
+            Out[n++] = *A;
+        }
+        return n;
+    }
+
+    if (Overlap.Y > A->Y)
+    {
+        Out[n].X = A->X;
+        Out[n].Y = A->Y;
+        Out[n].W = A->W;
+        Out[n].H = Overlap.Y - A->Y;
+        n++;
+    }
+    if (Overlap.Y + Overlap.H < A->Y + A->H)
+    {
+        Out[n].X = A->X;
+        Out[n].Y = Overlap.Y + Overlap.H;
+        Out[n].W = A->W;
+        Out[n].H = A->Y + A->H - Out[n].Y;
+        n++;
+    }
+    if (Overlap.X > A->X)
+    {
+        Out[n].X = A->X;
+        Out[n].Y = Overlap.Y;
+        Out[n].W = Overlap.X - A->X;
+        Out[n].H = Overlap.H;
+        n++;
+    }
+    if (Overlap.X + Overlap.W < A->X + A->W)
+    {
+        Out[n].X = Overlap.X + Overlap.W;
+        Out[n].Y = Overlap.Y;
+        Out[n].W = A->X + A->W - Out[n].X;
+        Out[n].H = Overlap.H;
+        n++;
+    }
+
+    return n;
+}
+
+bool DISPLAY_RectClipToSurface(DISPLAY_Rect_t *Rect, const DISPLAY_Surface_t *Surface)
+{
+    DISPLAY_Rect_t Bounds = {0, 0, (int32)Surface->Width, (int32)Surface->Height};
+
+    return DISPLAY_RectIntersect(Rect, Rect, &Bounds);
+}
+
+void DISPLAY_DrawInit(void)
+{
+    DrawLutGamma = 0;
+    DISPLAY_DrawSetGamma(220, 100);
+}
+
+/*
+** Rebuild the correction table, when the settings have changed. Colors
+** already drawn keep the correction they were drawn with.
+*/
+void DISPLAY_DrawSetGamma(uint16 PanelGamma, uint8 Brightness)
+{
+    double Linear;
+    int    i;
+
+    if (PanelGamma == DrawLutGamma && Brightness == DrawLutBrightness)
+    {
+        return;
+    }
+
+    for (i = 0; i < 256; i++)
+    {
+        Linear     = pow(i / 255.0, DISPLAY_DRAW_SRGB_GAMMA) * Brightness / 100.0;
+        DrawLut[i] = (uint8)(pow(Linear, 100.0 / PanelGamma) * 255.0 + 0.5);
+    }
+
+    DrawLutGamma      = PanelGamma;
+    DrawLutBrightness = Brightness;
+}
+
+const uint8 *DISPLAY_DrawGetLut(void)
+{
+    return DrawLut;
+}
+
+/*
+** Convert an 8 bit per channel color into a raw pixel value, corrected
+** for the panel
+*/
+uint32 DISPLAY_DrawPackColor(const DISPLAY_PixelFormat_t *Format, DISPLAY_Color_t Color)
+{
+    Color.red   = DrawLut[Color.red];
+    Color.green = DrawLut[Color.green];
+    Color.blue  = DrawLut[Color.blue];
+
+    return DISPLAY_DrawPackRaw(Format, Color);
+}
+
+/*
+** As DISPLAY_DrawPackColor, for channels that are already drive values
+*/
+uint32 DISPLAY_DrawPackRaw(const DISPLAY_PixelFormat_t *Format, DISPLAY_Color_t Color)
+{
+    uint32 Pixel = 0;
+
+    Pixel |= ((uint32)Color.red >> (8 - Format->RedLength)) << Format->RedOffset;
+    Pixel |= ((uint32)Color.green >> (8 - Format->GreenLength)) << Format->GreenOffset;
+    Pixel |= ((uint32)Color.blue >> (8 - Format->BlueLength)) << Format->BlueOffset;
+
+    return Pixel;
+}
+
+void DISPLAY_DrawFillRect(DISPLAY_Surface_t *Surface, const DISPLAY_Rect_t *Rect, uint32 Pixel)
+{
+    DISPLAY_Rect_t Clip = *Rect;
+    uint8         *Row;
+    int32          x, y;
+
+    if (Surface->Pixels == NULL || !DISPLAY_RectClipToSurface(&Clip, Surface))
+    {
+        return;
+    }
+
+    Row = Surface->Pixels + (Clip.Y * Surface->Stride) + (Clip.X * Surface->Format.BytesPerPixel);
+
+    switch (Surface->Format.BytesPerPixel)
+    {
+        case 2:
+            for (x = 0; x < Clip.W; x++)
+            {
+                ((uint16 *)Row)[x] = (uint16)Pixel;
+            }
+            break;
+
+        case 4:
+            for (x = 0; x < Clip.W; x++)
+            {
+                ((uint32 *)Row)[x] = Pixel;
+            }
+            break;
+
+        default:
+            for (x = 0; x < Clip.W; x++)
+            {
+                memcpy(Row + (x * Surface->Format.BytesPerPixel), &Pixel, Surface->Format.BytesPerPixel);
+            }
+            break;
+    }
+
+    /* Replicate the first row, which is already in final form */
+    for (y = 1; y < Clip.H; y++)
+    {
+        memcpy(Row + (y * Surface->Stride), Row, Clip.W * Surface->Format.BytesPerPixel);
+    }
+}
+
+bool DISPLAY_DrawIsRgb565(const DISPLAY_PixelFormat_t *Format)
+{
+    return (Format->BytesPerPixel == 2 && Format->RedOffset == 11 && Format->RedLength == 5 &&
+            Format->GreenOffset == 5 && Format->GreenLength == 6 && Format->BlueOffset == 0 &&
+            Format->BlueLength == 5);
+}
+
+/*
+** Copy a Width x Height block of RGB565 pixels to the surface with its top
+** left corner at X, Y. Rows are copied straight through when the surface is
+** RGB565 itself and converted pixel by pixel otherwise. The pixels are
+** drive values, corrected when they were converted, if at all.
+*/
+void DISPLAY_DrawBlit565(DISPLAY_Surface_t *Surface, int32 X, int32 Y, const uint8 *Src, uint32 Width, uint32 Height)
+{
+    DISPLAY_Rect_t  Clip = {X, Y, (int32)Width, (int32)Height};
+    DISPLAY_Color_t Color;
+    const uint16   *s;
+    uint8          *d;
+    uint32          Bpp = Surface->Format.BytesPerPixel;
+    uint32          Pixel;
+    int32           x, y;
+
+    if (Surface->Pixels == NULL || !DISPLAY_RectClipToSurface(&Clip, Surface))
+    {
+        return;
+    }
+
+    Src += ((Clip.Y - Y) * Width + (Clip.X - X)) * sizeof(uint16);
+
+    for (y = 0; y < Clip.H; y++)
+    {
+        s = (const uint16 *)(Src + (y * Width * sizeof(uint16)));
+        d = Surface->Pixels + ((Clip.Y + y) * Surface->Stride) + (Clip.X * Bpp);
+
+        if (DISPLAY_DrawIsRgb565(&Surface->Format))
+        {
+            memcpy(d, s, Clip.W * sizeof(uint16));
+            continue;
+        }
+
+        for (x = 0; x < Clip.W; x++, d += Bpp)
+        {
+            Color.red   = (uint8)(((s[x] >> 11) & 0x1F) << 3);
+            Color.green = (uint8)(((s[x] >> 5) & 0x3F) << 2);
+            Color.blue  = (uint8)((s[x] & 0x1F) << 3);
+            Pixel       = DISPLAY_DrawPackRaw(&Surface->Format, Color);
+            memcpy(d, &Pixel, Bpp);
+        }
+    }
+}
+
+/*
+** One channel of Dst moved Alpha/255 of the way to Src, both packed
+*/
+static uint32 DISPLAY_DrawBlendChannel(uint32 Dst, uint32 Src, uint32 Alpha, uint8 Offset, uint8 Length)
+{
+    int32 Max = (int32)((1u << Length) - 1);
+    int32 d   = (int32)(Dst >> Offset) & Max;
+    int32 s   = (int32)(Src >> Offset) & Max;
+
+    return (uint32)(d + ((((s - d) * (int32)Alpha) + ((s >= d) ? 127 : -127)) / 255)) << Offset;
+}
+
+/*
+** Paint Pixel over a Width x Height block at (X, Y), each pixel weighted
+** by its byte of Coverage: 0 leaves the surface as it was and 255 stores
+** Pixel outright
+*/
+void DISPLAY_DrawBlendA8(DISPLAY_Surface_t *Surface, int32 X, int32 Y, const uint8 *Coverage, uint32 Width,
+                         uint32 Height, uint32 Pixel)
+{
+    const DISPLAY_PixelFormat_t *F    = &Surface->Format;
+    DISPLAY_Rect_t               Clip = {X, Y, (int32)Width, (int32)Height};
+    const uint8                 *c;
+    uint8                       *d;
+    uint32                       Bpp = F->BytesPerPixel;
+    uint32                       Old = 0;
+    uint32                       New;
+    int32                        x, y;
+
+    if (Surface->Pixels == NULL || !DISPLAY_RectClipToSurface(&Clip, Surface))
+    {
+        return;
+    }
+
+    Coverage += ((Clip.Y - Y) * Width) + (Clip.X - X);
+
+    for (y = 0; y < Clip.H; y++)
+    {
+        c = Coverage + (y * Width);
+        d = Surface->Pixels + ((Clip.Y + y) * Surface->Stride) + (Clip.X * Bpp);
+
+        for (x = 0; x < Clip.W; x++, d += Bpp)
+        {
+            if (c[x] == 0)
+            {
+                continue;
+            }
+
+            if (c[x] == 255)
+            {
+                memcpy(d, &Pixel, Bpp);
+                continue;
+            }
+
+            memcpy(&Old, d, Bpp);
+            New = DISPLAY_DrawBlendChannel(Old, Pixel, c[x], F->RedOffset, F->RedLength) |
+                  DISPLAY_DrawBlendChannel(Old, Pixel, c[x], F->GreenOffset, F->GreenLength) |
+                  DISPLAY_DrawBlendChannel(Old, Pixel, c[x], F->BlueOffset, F->BlueLength);
+            memcpy(d, &New, Bpp);
+        }
+    }
+}
+
+/*
+** Copy Count pixels from Src to Dst, skipping those equal to Key
+*/
+void DISPLAY_DrawCopyKeyed(uint8 *Dst, const uint8 *Src, uint32 Count, uint32 Bpp, uint32 Key)
+{
+    uint32 x;
+
+    switch (Bpp)
+    {
+        case 2:
+            for (x = 0; x < Count; x++)
+            {
+                if (((const uint16 *)Src)[x] != (uint16)Key)
+                {
+                    ((uint16 *)Dst)[x] = ((const uint16 *)Src)[x];
+                }
+            }
+            break;
+
+        case 4:
+            for (x = 0; x < Count; x++)
+            {
+                if (((const uint32 *)Src)[x] != Key)
+                {
+                    ((uint32 *)Dst)[x] = ((const uint32 *)Src)[x];
+                }
+            }
+            break;
+
+        default:
+            for (x = 0; x < Count; x++, Src += Bpp, Dst += Bpp)
+            {
+                if (memcmp(Src, &Key, Bpp) != 0)
+                {
+                    memcpy(Dst, Src, Bpp);
+                }
+            }
+            break;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef DISPLAY_DRAW__H_
+#define DISPLAY_DRAW__H_
+
+#include "common_types.h"
+#include "display_msg.h"
+
+/*
+** Rectangle in pixels. Signed so that partially off-screen requests can
+** be clipped rather than rejected.
+*/
+typedef struct
+{
+    int32 X;
+    int32 Y;
+    int32 W;
+    int32 H;
+} DISPLAY_Rect_t;
+
+/*
+** Bit layout of one pixel, as reported by the framebuffer driver
+*/
+typedef struct
+{
+    uint8 RedOffset;
+    uint8 RedLength;
+    uint8 GreenOffset;
+    uint8 GreenLength;
+    uint8 BlueOffset;
+    uint8 BlueLength;
+    uint8 BytesPerPixel;
+    uint8 Spare;
+} DISPLAY_PixelFormat_t;
+
+/*
+** A block of pixels in framebuffer format
+*/
+typedef struct
+{
+    uint8                *Pixels;
+    uint32                Width;
+    uint32                Height;
+    uint32                Stride; /* Bytes between the start of consecutive rows */
+    DISPLAY_PixelFormat_t Format;
+} DISPLAY_Surface_t;
+
+bool   DISPLAY_RectIsEmpty(const DISPLAY_Rect_t *Rect);
+bool   DISPLAY_RectIntersect(DISPLAY_Rect_t *Out, const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B);
+void   DISPLAY_RectUnion(DISPLAY_Rect_t *Out, const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B);
+uint32 DISPLAY_RectSubtract(DISPLAY_Rect_t Out[4], const DISPLAY_Rect_t *A, const DISPLAY_Rect_t *B);
+bool   DISPLAY_RectClipToSurface(DISPLAY_Rect_t *Rect, const DISPLAY_Surface_t *Surface);
+
+void         DISPLAY_DrawInit(void);
+void         DISPLAY_DrawSetGamma(uint16 PanelGamma, uint8 Brightness);
+const uint8 *DISPLAY_DrawGetLut(void);
+
+uint32 DISPLAY_DrawPackColor(const DISPLAY_PixelFormat_t *Format, DISPLAY_Color_t Color);
+uint32 DISPLAY_DrawPackRaw(const DISPLAY_PixelFormat_t *Format, DISPLAY_Color_t Color);
+void   DISPLAY_DrawFillRect(DISPLAY_Surface_t *Surface, const DISPLAY_Rect_t *Rect, uint32 Pixel);
+void   DISPLAY_DrawBlit565(DISPLAY_Surface_t *Surface, int32 X, int32 Y, const uint8 *Src, uint32 Width,
+                           uint32 Height);
+void   DISPLAY_DrawBlendA8(DISPLAY_Surface_t *Surface, int32 X, int32 Y, const uint8 *Coverage, uint32 Width,
+                           uint32 Height, uint32 Pixel);
+bool   DISPLAY_DrawIsRgb565(const DISPLAY_PixelFormat_t *Format);
+void   DISPLAY_DrawCopyKeyed(uint8 *Dst, const uint8 *Src, uint32 Count, uint32 Bpp, uint32 Key);
+
+#endif // DISPLAY_DRAW__H_
@@ -39,7 +39,22 @@
 #define DISPLAY_LEN_ERR_EID           7
 #define DISPLAY_PIPE_ERR_EID          8
 #define DISPLAY_TBL_ERR_EID           9
+#define DISPLAY_FB_INF_EID            10
+#define DISPLAY_FB_ERR_EID            11
+#define DISPLAY_IMAGE_INF_EID         12
+#define DISPLAY_IMAGE_ERR_EID         13
+#define DISPLAY_XFER_INF_EID          14
+#define DISPLAY_XFER_ERR_EID          15
+#define DISPLAY_CLIENT_INF_EID        16
+#define DISPLAY_CLIENT_ERR_EID        17
+#define DISPLAY_RECORD_INF_EID        18
+#define DISPLAY_RECORD_ERR_EID        19
+#define DISPLAY_ANIM_INF_EID          20
+#define DISPLAY_ANIM_ERR_EID          21
+#define DISPLAY_SHOT_INF_EID          22
+#define DISPLAY_SHOT_ERR_EID          23
+#define DISPLAY_TEXT_ERR_EID          24
 
-#define DISPLAY_EVENT_COUNTS 9
+#define DISPLAY_EVENT_COUNTS 24
 
 #endif /* DISPLAY_EVENTS_H */
@@ -1,12 +1,15 @@
 #include "display_fb.h"
 #include "display_msg.h"
+#include "display_stream.h"
 #include "common_types.h"
 #include "cfe_error.h"
 #include <fcntl.h>
 #include <linux/fb.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 
+#include <errno.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -15,24 +18,64 @@ static int                      FBFd  = -1;
 static struct fb_var_screeninfo VInfo = {0};
 static struct fb_fix_screeninfo FInfo = {0};
 
-CFE_Status_t DISPLAY_FbInit(DISPLAY_Table_t *TblPtr)
+/* Identity of the device node that is currently mapped */
+static char  FBPath[PORT_NAME_SIZE] = {0};
+static dev_t FBRdev                 = 0;
+static ino_t FBIno                  = 0;
+
+static DISPLAY_FbInfo_t FBInfo = {0};
+
+/*
+** Edge of the square block, in pixels, used when a rotated copy walks the
+** destination across lines. 16x16 pixels keeps both the source rows and the
+** destination lines of one block resident in L1 on the targets we fly.
+*/
+#define DISPLAY_FB_TILE 16
+
+/*
+** Bytes turned round at a time by the 180 degree copy; a whole number of
+** cache lines
+*/
+#define DISPLAY_FB_BOUNCE 512
+
+/*
+** Refresh period from the driver's video timings: pixel clock in
+** picoseconds times the pixels of a whole frame, blanking included
+*/
+static uint32 DISPLAY_FbRefreshUs(void)
+{
+    uint64 Pixels = (uint64)(VInfo.left_margin + VInfo.right_margin + VInfo.hsync_len + VInfo.xres) *
+                    (uint64)(VInfo.upper_margin + VInfo.lower_margin + VInfo.vsync_len + VInfo.yres);
+
+    return (uint32)((Pixels * VInfo.pixclock) / 1000000);
+}
+
+/*
+** Open the device at TblPtr->DevicePath, read its geometry and map it.
+** On failure nothing is left open or mapped.
+*/
+CFE_Status_t DISPLAY_FbInit(const DISPLAY_Table_t *TblPtr)
 {
     CFE_Status_t status = CFE_SUCCESS;
+    struct stat  filestats;
+
     if (TblPtr == NULL)
     {
         status = DISPLAY_STATUS_ERROR_NULL;
     }
 
+    // Drop any previous mapping first so a re-init never leaks the old one
+    DISPLAY_FbClose();
+
     // Open device file
     if (status == CFE_SUCCESS)
     {
         FBFd = open(TblPtr->DevicePath, O_RDWR);
-        if (FBFd < 0)
+        if (FBFd < 0 || fstat(FBFd, &filestats) != 0)
         {
             status = DISPLAY_STATUS_ERROR_OPEN;
         }
     }
-    
 
     // Get fixed info
     if (status == CFE_SUCCESS)
@@ -53,18 +96,372 @@ CFE_Status_t DISPLAY_FbInit(DISPLAY_Table_t *TblPtr)
     }
 
     /* Mem Map the screen pixels to local address space */
-    uint32 screensize = VInfo.xres * VInfo.yres * (VInfo.bits_per_pixel / 8);
-    FBPtr = (uint8 *) mmap(0, screensize, PROT_READ | PROT_WRITE, MAP_SHARED, FBFd, 0);
-    if (FBPtr == MAP_FAILED)
+    if (status == CFE_SUCCESS)
     {
-        status = DISPLAY_STATUS_ERROR_OPEN;
+        FBInfo.BytesPerPixel = VInfo.bits_per_pixel / 8;
+        FBInfo.LineLength    = FInfo.line_length;
+        if (FBInfo.LineLength == 0)
+        {
+            FBInfo.LineLength = VInfo.xres * FBInfo.BytesPerPixel;
+        }
+        FBInfo.Size = FBInfo.LineLength * VInfo.yres;
+
+        FBPtr = (uint8 *) mmap(0, FBInfo.Size, PROT_READ | PROT_WRITE, MAP_SHARED, FBFd, 0);
+        if (FBPtr == MAP_FAILED)
+        {
+            FBPtr  = NULL;
+            status = DISPLAY_STATUS_ERROR_OPEN;
+        }
     }
 
-    for (int i = 0; i < 8; i++)
+    if (status == CFE_SUCCESS)
     {
-        memset(FBPtr, (1 << i), FInfo.smem_len);
-        sleep(1);
+        strncpy(FBPath, TblPtr->DevicePath, sizeof(FBPath) - 1);
+        FBPath[sizeof(FBPath) - 1] = 0;
+        FBRdev = filestats.st_rdev;
+        FBIno  = filestats.st_ino;
+
+        FBInfo.Ptr    = FBPtr;
+        FBInfo.Width  = VInfo.xres;
+        FBInfo.Height = VInfo.yres;
+        FBInfo.Generation++;
+
+        FBInfo.Format.RedOffset     = VInfo.red.offset;
+        FBInfo.Format.RedLength     = VInfo.red.length;
+        FBInfo.Format.GreenOffset   = VInfo.green.offset;
+        FBInfo.Format.GreenLength   = VInfo.green.length;
+        FBInfo.Format.BlueOffset    = VInfo.blue.offset;
+        FBInfo.Format.BlueLength    = VInfo.blue.length;
+        FBInfo.Format.BytesPerPixel = FBInfo.BytesPerPixel;
+
+        /* The first wait tells whether there is a vertical blank to wait on */
+        FBInfo.RefreshUs = DISPLAY_FbRefreshUs();
+        FBInfo.Vsync     = true;
+
+        memset(FBPtr, 0, FBInfo.Size);
+    }
+    else
+    {
+        DISPLAY_FbClose();
     }
 
     return status;
 }
+
+/*
+** Unmap and close the device. Safe to call when nothing is open.
+*/
+void DISPLAY_FbClose(void)
+{
+    if (FBPtr != NULL)
+    {
+        munmap(FBPtr, FBInfo.Size);
+        FBPtr = NULL;
+    }
+
+    if (FBFd >= 0)
+    {
+        close(FBFd);
+        FBFd = -1;
+    }
+
+    FBPath[0]        = 0;
+    FBInfo.Ptr       = NULL;
+    FBInfo.Width     = 0;
+    FBInfo.Height    = 0;
+    FBInfo.Size      = 0;
+    FBInfo.RefreshUs = 0;
+    FBInfo.Vsync     = false;
+}
+
+/*
+** Compare the mapped device against the table and the filesystem, and
+** close, remap or re-probe as needed. Returns CFE_SUCCESS while a device
+** is mapped; callers detect a remap through DISPLAY_FbInfo_t.Generation.
+*/
+CFE_Status_t DISPLAY_FbCheck(const DISPLAY_Table_t *TblPtr)
+{
+    struct stat              filestats;
+    struct fb_var_screeninfo Probe;
+
+    if (TblPtr == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NULL;
+    }
+
+    if (FBPtr != NULL)
+    {
+        // Table now names a different device
+        if (strncmp(FBPath, TblPtr->DevicePath, sizeof(FBPath)) != 0)
+        {
+            return DISPLAY_FbInit(TblPtr);
+        }
+
+        // Device node vanished or was recreated (driver reload, hotplug)
+        if (stat(FBPath, &filestats) != 0)
+        {
+            DISPLAY_FbClose();
+            return DISPLAY_STATUS_ERROR_OPEN;
+        }
+        if (filestats.st_rdev != FBRdev || filestats.st_ino != FBIno)
+        {
+            return DISPLAY_FbInit(TblPtr);
+        }
+
+        // Geometry changed underneath us (fbset, rotate in the driver)
+        if (ioctl(FBFd, FBIOGET_VSCREENINFO, &Probe) == -1)
+        {
+            DISPLAY_FbClose();
+            return DISPLAY_STATUS_ERROR_READ;
+        }
+        if (Probe.xres != VInfo.xres || Probe.yres != VInfo.yres || Probe.bits_per_pixel != VInfo.bits_per_pixel)
+        {
+            return DISPLAY_FbInit(TblPtr);
+        }
+
+        return CFE_SUCCESS;
+    }
+
+    // Nothing mapped: try again only once the device node is back
+    if (stat(TblPtr->DevicePath, &filestats) != 0)
+    {
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    return DISPLAY_FbInit(TblPtr);
+}
+
+/*
+** Power the panel down, or back up. The mapping stays valid either way.
+*/
+CFE_Status_t DISPLAY_FbBlank(bool Blank)
+{
+    if (FBFd < 0)
+    {
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    if (ioctl(FBFd, FBIOBLANK, Blank ? FB_BLANK_POWERDOWN : FB_BLANK_UNBLANK) == -1)
+    {
+        return DISPLAY_STATUS_ERROR_WRITE;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Block until the panel's next vertical blank starts. A driver that cannot
+** wait for it is marked so in DISPLAY_FbInfo_t.Vsync.
+*/
+CFE_Status_t DISPLAY_FbWaitVsync(void)
+{
+    __u32 Crtc = 0;
+
+    if (FBFd < 0)
+    {
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    if (ioctl(FBFd, FBIO_WAITFORVSYNC, &Crtc) == -1)
+    {
+        if (errno != EINTR)
+        {
+            FBInfo.Vsync = false;
+        }
+        return DISPLAY_STATUS_ERROR_READ;
+    }
+
+    return CFE_SUCCESS;
+}
+
+bool DISPLAY_FbIsMapped(void)
+{
+    return (FBPtr != NULL);
+}
+
+const DISPLAY_FbInfo_t *DISPLAY_FbGetInfo(void)
+{
+    return &FBInfo;
+}
+
+/*
+** Copy one rectangle of logical pixels to the device through the
+** destination mapping Dst = Origin + x * Dx + y * Dy (bytes). The rectangle
+** is walked in DISPLAY_FB_TILE blocks so that a 90/270 degree transpose
+** touches a bounded set of device lines per block instead of striding the
+** whole frame for every source row.
+*/
+static void DISPLAY_FbCopyTiled(const DISPLAY_Surface_t *Src, const DISPLAY_Rect_t *Rect, uint8 *Origin, intptr_t Dx,
+                                intptr_t Dy)
+{
+    uint32 Bpp = Src->Format.BytesPerPixel;
+    int32  tx, ty, x, y, xEnd, yEnd;
+
+    for (ty = Rect->Y; ty < Rect->Y + Rect->H; ty += DISPLAY_FB_TILE)
+    {
+        yEnd = (ty + DISPLAY_FB_TILE < Rect->Y + Rect->H) ? ty + DISPLAY_FB_TILE : Rect->Y + Rect->H;
+
+        for (tx = Rect->X; tx < Rect->X + Rect->W; tx += DISPLAY_FB_TILE)
+        {
+            xEnd = (tx + DISPLAY_FB_TILE < Rect->X + Rect->W) ? tx + DISPLAY_FB_TILE : Rect->X + Rect->W;
+
+            for (y = ty; y < yEnd; y++)
+            {
+                const uint8 *s = Src->Pixels + (y * Src->Stride) + (tx * Bpp);
+                uint8       *d = Origin + (y * Dy) + (tx * Dx);
+
+                switch (Bpp)
+                {
+                    case 2:
+                        for (x = tx; x < xEnd; x++, s += 2, d += Dx)
+                        {
+                            *(uint16 *)d = *(const uint16 *)s;
+                        }
+                        break;
+
+                    case 4:
+                        for (x = tx; x < xEnd; x++, s += 4, d += Dx)
+                        {
+                            *(uint32 *)d = *(const uint32 *)s;
+                        }
+                        break;
+
+                    default:
+                        for (x = tx; x < xEnd; x++, s += Bpp, d += Dx)
+                        {
+                            memcpy(d, s, Bpp);
+                        }
+                        break;
+                }
+            }
+        }
+    }
+}
+
+/*
+** Copy Count pixels from Src to the device row at Dst in reverse order, for
+** the 180 degree mounting. They are turned round in a small buffer so the
+** device row is still written front to back, in whole lines.
+*/
+static void DISPLAY_FbCopyReversed(uint8 *Dst, const uint8 *Src, uint32 Count, uint32 Bpp)
+{
+    uint8        Bounce[DISPLAY_FB_BOUNCE];
+    const uint8 *s = Src + (Count * Bpp);
+    uint8       *b;
+    uint32       n, i;
+
+    /* The first chunk ends on a line boundary of Dst, so the rest start on one */
+    n = (DISPLAY_FB_BOUNCE - ((uintptr_t)Dst & (DISPLAY_STREAM_LINE - 1))) / Bpp;
+
+    while (Count > 0)
+    {
+        if (n > Count)
+        {
+            n = Count;
+        }
+
+        b = Bounce;
+        switch (Bpp)
+        {
+            case 2:
+                for (i = 0; i < n; i++, b += 2)
+                {
+                    s -= 2;
+                    *(uint16 *)b = *(const uint16 *)s;
+                }
+                break;
+
+            case 4:
+                for (i = 0; i < n; i++, b += 4)
+                {
+                    s -= 4;
+                    *(uint32 *)b = *(const uint32 *)s;
+                }
+                break;
+
+            default:
+                for (i = 0; i < n; i++, b += Bpp)
+                {
+                    s -= Bpp;
+                    memcpy(b, s, Bpp);
+                }
+                break;
+        }
+
+        DISPLAY_StreamCopy(Dst, Bounce, n * Bpp);
+        Dst += n * Bpp;
+        Count -= n;
+        n = DISPLAY_FB_BOUNCE / Bpp;
+    }
+}
+
+/*
+** Copy Rect of the logical back buffer Src to the panel, applying the
+** mounting rotation. Src must be the logical size for that rotation and
+** share the device pixel format.
+*/
+void DISPLAY_FbPresent(const DISPLAY_Surface_t *Src, const DISPLAY_Rect_t *Rect, uint8 Rotation)
+{
+    DISPLAY_Rect_t Clip = *Rect;
+    uint32         Bpp  = FBInfo.BytesPerPixel;
+    intptr_t       Line = FBInfo.LineLength;
+    uint32         LogicalW, LogicalH;
+    uint8         *Origin;
+    int32          y;
+
+    if (FBPtr == NULL || Src->Pixels == NULL || Src->Format.BytesPerPixel != Bpp)
+    {
+        return;
+    }
+
+    if (Rotation == DISPLAY_ROTATE_90 || Rotation == DISPLAY_ROTATE_270)
+    {
+        LogicalW = FBInfo.Height;
+        LogicalH = FBInfo.Width;
+    }
+    else
+    {
+        LogicalW = FBInfo.Width;
+        LogicalH = FBInfo.Height;
+    }
+
+    if (Src->Width != LogicalW || Src->Height != LogicalH || !DISPLAY_RectClipToSurface(&Clip, Src))
+    {
+        return;
+    }
+
+    switch (Rotation)
+    {
+        case DISPLAY_ROTATE_90:
+            /* Logical row y lands in device column Width - 1 - y */
+            Origin = FBPtr + (FBInfo.Width - 1) * Bpp;
+            DISPLAY_FbCopyTiled(Src, &Clip, Origin, Line, -(intptr_t)Bpp);
+            break;
+
+        case DISPLAY_ROTATE_180:
+            /* Logical row y is device row Height - 1 - y, right to left */
+            for (y = Clip.Y; y < Clip.Y + Clip.H; y++)
+            {
+                DISPLAY_FbCopyReversed(FBPtr + ((FBInfo.Height - 1 - y) * Line) +
+                                           ((FBInfo.Width - Clip.X - Clip.W) * Bpp),
+                                       Src->Pixels + (y * Src->Stride) + (Clip.X * Bpp), Clip.W, Bpp);
+            }
+            break;
+
+        case DISPLAY_ROTATE_270:
+            /* Logical row y lands in device column y, bottom to top */
+            Origin = FBPtr + (FBInfo.Height - 1) * Line;
+            DISPLAY_FbCopyTiled(Src, &Clip, Origin, -Line, (intptr_t)Bpp);
+            break;
+
+        default:
+            for (y = Clip.Y; y < Clip.Y + Clip.H; y++)
+            {
+                DISPLAY_StreamCopy(FBPtr + (y * Line) + (Clip.X * Bpp),
+                                   Src->Pixels + (y * Src->Stride) + (Clip.X * Bpp), Clip.W * Bpp);
+            }
+            break;
+    }
+
+    DISPLAY_StreamFence();
+}
@@ -1,10 +1,37 @@
 #ifndef DISPLAY_FB__H_
 #define DISPLAY_FB__H_
 
+#include "common_types.h"
 #include "cfe_error.h"
 #include "display_table.h"
+#include "display_draw.h"
 
-CFE_Status_t DISPLAY_FbInit(DISPLAY_Table_t *TblPtr);
+/*
+** Geometry of the currently mapped framebuffer device
+*/
+typedef struct
+{
+    uint8 *Ptr;           /* mmap'd device memory, NULL while unmapped */
+    uint32 Size;          /* Bytes mapped at Ptr */
+    uint32 Width;         /* Visible pixels per line */
+    uint32 Height;        /* Visible lines */
+    uint32 BytesPerPixel;
+    uint32 LineLength;    /* Bytes between the start of consecutive lines */
+    uint32 Generation;    /* Incremented on every successful map */
+    uint32 RefreshUs;     /* Refresh period from the driver's video timings, 0 if it gives none */
+    bool   Vsync;         /* Driver can wait for the vertical blank, assumed until a wait fails */
 
-#endif // DISPLAY_FB__H_
+    DISPLAY_PixelFormat_t Format;
+} DISPLAY_FbInfo_t;
+
+CFE_Status_t DISPLAY_FbInit(const DISPLAY_Table_t *TblPtr);
+CFE_Status_t DISPLAY_FbCheck(const DISPLAY_Table_t *TblPtr);
+void         DISPLAY_FbClose(void);
+bool         DISPLAY_FbIsMapped(void);
+CFE_Status_t DISPLAY_FbBlank(bool Blank);
+CFE_Status_t DISPLAY_FbWaitVsync(void);
+void         DISPLAY_FbPresent(const DISPLAY_Surface_t *Src, const DISPLAY_Rect_t *Rect, uint8 Rotation);
 
+const DISPLAY_FbInfo_t *DISPLAY_FbGetInfo(void);
+
+#endif // DISPLAY_FB__H_
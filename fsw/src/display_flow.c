@@ -0,0 +1,138 @@
+#include "display_flow.h"
+#include "display_render.h"
+
+#include <string.h>
+
+/*
+** Command pipe backpressure. The main loop reads the command pipe without
+** waiting for as long as it holds messages and pends only once it is
+** empty, so a message read without waiting was queued behind the one
+** before. Once half the pipe's depth has been read back to back like that
+** the pipe counts as congested, and it stays so until it is found empty.
+**
+** A congested pipe is worked off at drawing speed rather than panel speed:
+** ground draws stop flushing one by one and frame ticks still run the
+** clients but do not flush, so draws pile up in the render queue, where
+** those a later draw covers are never drawn; those are what DrawsCoalesced
+** counts. A frame is still presented after every quarter of the pipe's
+** depth of skipped ones, and as soon as the pipe drains.
+**
+** The flow packet goes out when the pipe becomes congested and when it
+** drains, for producers to slow down on.
+*/
+typedef struct
+{
+    uint32 HighWater; /* Back to back reads that congest the pipe */
+    uint32 MaxSkip;   /* Frames skipped in a row at most */
+    uint32 Run;       /* Back to back reads so far */
+    uint32 Skipped;   /* Frames skipped in a row */
+    uint32 Held;      /* Frames skipped since the last one presented */
+    uint32 Culled;    /* Render's culled draws when the first of them was skipped */
+
+    DISPLAY_FlowTlm_Payload_t Stats;
+} DISPLAY_Flow_t;
+
+static DISPLAY_Flow_t Flow;
+
+void DISPLAY_FlowInit(uint16 PipeDepth)
+{
+    memset(&Flow, 0, sizeof(Flow));
+
+    Flow.HighWater = (PipeDepth > 1) ? PipeDepth / 2 : 1;
+    Flow.MaxSkip   = (PipeDepth > 3) ? PipeDepth / 4 : 1;
+}
+
+/*
+** Note a message read from the pipe, Queued if it was waiting there
+*/
+void DISPLAY_FlowReceived(bool Queued, DISPLAY_FlowTlm_Payload_t *Payload, DISPLAY_FlowSend_t Send)
+{
+    Flow.Run = Queued ? Flow.Run + 1 : 0;
+
+    if (Flow.Stats.Congested && Flow.Run > Flow.Stats.Backlog)
+    {
+        Flow.Stats.Backlog = (uint16)((Flow.Run > 0xFFFF) ? 0xFFFF : Flow.Run);
+    }
+
+    if (!Flow.Stats.Congested && Flow.Run >= Flow.HighWater)
+    {
+        Flow.Stats.Congested = 1;
+        Flow.Stats.Backlog   = (uint16)Flow.Run;
+        Flow.Stats.Congestions++;
+        Flow.Skipped = 0;
+
+        *Payload = Flow.Stats;
+        Send();
+    }
+}
+
+/*
+** Whether the frame a message would present should be skipped, and if so
+** count it dropped
+*/
+bool DISPLAY_FlowSkipFrame(void)
+{
+    if (!Flow.Stats.Congested || Flow.Skipped >= Flow.MaxSkip)
+    {
+        Flow.Skipped = 0;
+        return false;
+    }
+
+    if (Flow.Held == 0)
+    {
+        Flow.Culled = DISPLAY_RenderGetCulled();
+    }
+
+    Flow.Skipped++;
+    Flow.Held++;
+    Flow.Stats.FramesDropped++;
+
+    return true;
+}
+
+/*
+** Whether frames have been skipped since the last one presented
+*/
+bool DISPLAY_FlowHeld(void)
+{
+    return Flow.Held > 0;
+}
+
+/*
+** A frame was presented. Draws culled since the first frame it carries was
+** skipped were held back by the skipping, and are counted coalesced.
+*/
+void DISPLAY_FlowPresented(void)
+{
+    if (Flow.Held > 0)
+    {
+        Flow.Stats.DrawsCoalesced += DISPLAY_RenderGetCulled() - Flow.Culled;
+        Flow.Held = 0;
+    }
+}
+
+/*
+** The pipe was found empty. Call once anything held back is presented.
+*/
+void DISPLAY_FlowDrained(DISPLAY_FlowTlm_Payload_t *Payload, DISPLAY_FlowSend_t Send)
+{
+    Flow.Run     = 0;
+    Flow.Skipped = 0;
+
+    if (!Flow.Stats.Congested)
+    {
+        return;
+    }
+
+    Flow.Stats.Congested = 0;
+
+    *Payload = Flow.Stats;
+    Send();
+}
+
+void DISPLAY_FlowGetStats(uint8 *Congested, uint32 *FramesDropped, uint32 *DrawsCoalesced)
+{
+    *Congested      = Flow.Stats.Congested;
+    *FramesDropped  = Flow.Stats.FramesDropped;
+    *DrawsCoalesced = Flow.Stats.DrawsCoalesced;
+}
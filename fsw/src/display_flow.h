@@ -0,0 +1,18 @@
+#ifndef DISPLAY_FLOW__H_
+#define DISPLAY_FLOW__H_
+
+#include "common_types.h"
+#include "display_msg.h"
+
+/* Transmit the flow packet just filled in */
+typedef void (*DISPLAY_FlowSend_t)(void);
+
+void DISPLAY_FlowInit(uint16 PipeDepth);
+void DISPLAY_FlowReceived(bool Queued, DISPLAY_FlowTlm_Payload_t *Payload, DISPLAY_FlowSend_t Send);
+bool DISPLAY_FlowSkipFrame(void);
+bool DISPLAY_FlowHeld(void);
+void DISPLAY_FlowPresented(void);
+void DISPLAY_FlowDrained(DISPLAY_FlowTlm_Payload_t *Payload, DISPLAY_FlowSend_t Send);
+void DISPLAY_FlowGetStats(uint8 *Congested, uint32 *FramesDropped, uint32 *DrawsCoalesced);
+
+#endif // DISPLAY_FLOW__H_
@@ -0,0 +1,302 @@
+#include "display_font.h"
+#include "display_arena.h"
+#include "display_image.h"
+#include "display_render.h"
+
+#include <string.h>
+
+/*
+** Text in compressed fonts.
+**
+** Fonts stay compressed in their image slots. A glyph is expanded to one
+** byte of coverage per pixel the first time it is drawn and kept in a
+** cache in the glyph pool, so text redrawn every frame is decoded once
+** and then only blended. The cache is a fixed number of equal cells found
+** through a hash of the font's load serial and the character code; when
+** it is full, the glyph drawn least recently makes way. A font reloaded
+** into its slot gets a new serial, so its old glyphs are never found again
+** and simply age out.
+**
+** Queued draws read their glyph when the render queue is drawn, so the
+** queue is drawn before a cell is reused.
+*/
+#define DISPLAY_FONT_HASH_SIZE 256 /* Buckets, a power of two */
+#define DISPLAY_FONT_NONE      0xFFFF
+
+typedef struct
+{
+    uint32 Serial; /* Of the font the glyph came from */
+    uint8  Code;
+    uint16 Next;  /* In the hash bucket */
+    uint16 Newer; /* In the use order */
+    uint16 Older;
+} DISPLAY_FontCell_t;
+
+typedef struct
+{
+    uint8             *Pixels; /* Cells, DISPLAY_FONT_CELL_PIXELS bytes each */
+    uint16             Cells;
+    uint16             Used;
+    uint16             Newest;
+    uint16             Oldest;
+    uint16             Hash[DISPLAY_FONT_HASH_SIZE];
+    DISPLAY_FontCell_t Cell[DISPLAY_FONT_MAX_CELLS];
+    uint32             Hits;
+    uint32             Misses;
+} DISPLAY_FontCache_t;
+
+static DISPLAY_FontCache_t Cache;
+
+static void DISPLAY_FontEmpty(void)
+{
+    memset(&Cache, 0, sizeof(Cache));
+    memset(Cache.Hash, 0xFF, sizeof(Cache.Hash));
+    Cache.Newest = DISPLAY_FONT_NONE;
+    Cache.Oldest = DISPLAY_FONT_NONE;
+}
+
+/*
+** Give the cache as many cells as the glyph pool holds, up to
+** DISPLAY_FONT_MAX_CELLS
+*/
+CFE_Status_t DISPLAY_FontInit(void)
+{
+    uint32 Cells;
+
+    DISPLAY_FontClose();
+
+    Cells = DISPLAY_ArenaAvailable(DISPLAY_POOL_GLYPH) / DISPLAY_FONT_CELL_PIXELS;
+    if (Cells > DISPLAY_FONT_MAX_CELLS)
+    {
+        Cells = DISPLAY_FONT_MAX_CELLS;
+    }
+
+    Cache.Pixels = (Cells > 0) ? DISPLAY_ArenaAlloc(DISPLAY_POOL_GLYPH, Cells * DISPLAY_FONT_CELL_PIXELS, 4) : NULL;
+    if (Cache.Pixels == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    Cache.Cells = (uint16)Cells;
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_FontClose(void)
+{
+    DISPLAY_ArenaReset(DISPLAY_POOL_GLYPH);
+    DISPLAY_FontEmpty();
+}
+
+static uint32 DISPLAY_FontHash(uint32 Serial, uint8 Code)
+{
+    return ((Serial * 2654435761u) ^ Code) & (DISPLAY_FONT_HASH_SIZE - 1);
+}
+
+static void DISPLAY_FontUnlink(uint16 i)
+{
+    DISPLAY_FontCell_t *Cell = &Cache.Cell[i];
+
+    if (Cell->Newer != DISPLAY_FONT_NONE)
+    {
+        Cache.Cell[Cell->Newer].Older = Cell->Older;
+    }
+    else
+    {
+        Cache.Newest = Cell->Older;
+    }
+
+    if (Cell->Older != DISPLAY_FONT_NONE)
+    {
+        Cache.Cell[Cell->Older].Newer = Cell->Newer;
+    }
+    else
+    {
+        Cache.Oldest = Cell->Newer;
+    }
+}
+
+static void DISPLAY_FontMakeNewest(uint16 i)
+{
+    DISPLAY_FontCell_t *Cell = &Cache.Cell[i];
+
+    Cell->Newer = DISPLAY_FONT_NONE;
+    Cell->Older = Cache.Newest;
+
+    if (Cache.Newest != DISPLAY_FONT_NONE)
+    {
+        Cache.Cell[Cache.Newest].Newer = i;
+    }
+    else
+    {
+        Cache.Oldest = i;
+    }
+    Cache.Newest = i;
+}
+
+/*
+** Take the cell of the glyph drawn least recently out of its bucket
+*/
+static uint16 DISPLAY_FontEvict(void)
+{
+    uint16  i    = Cache.Oldest;
+    uint16 *Link = &Cache.Hash[DISPLAY_FontHash(Cache.Cell[i].Serial, Cache.Cell[i].Code)];
+
+    while (*Link != i)
+    {
+        Link = &Cache.Cell[*Link].Next;
+    }
+    *Link = Cache.Cell[i].Next;
+
+    DISPLAY_FontUnlink(i);
+
+    /* A queued draw may still read it */
+    DISPLAY_RenderSync();
+
+    return i;
+}
+
+/*
+** Expand Length bytes of runs into Count bytes of coverage. Runs that go
+** past the end are cut off, and pixels they leave out are empty.
+*/
+static void DISPLAY_FontExpand(uint8 *Out, uint32 Count, const uint8 *Runs, uint32 Length, uint8 Bpp)
+{
+    uint32 Max = (1u << Bpp) - 1;
+    uint32 n   = 0;
+    uint32 Value, Run, i;
+
+    for (i = 0; i < Length && n < Count; i++)
+    {
+        Value = Runs[i] & 0x0F;
+        if (Value > Max)
+        {
+            Value = Max;
+        }
+
+        Run = (uint32)(Runs[i] >> 4) + 1;
+        if (Run > Count - n)
+        {
+            Run = Count - n;
+        }
+
+        memset(Out + n, (int)((Value * 255) / Max), Run);
+        n += Run;
+    }
+
+    memset(Out + n, 0, Count - n);
+}
+
+/*
+** Coverage of a glyph from the cache, expanding it on a miss. NULL if the
+** glyph is too large to cache or its runs lie outside the font.
+*/
+static const uint8 *DISPLAY_FontGlyph(const uint8 *Font, uint32 Size, uint32 Serial, uint8 Code,
+                                      const DISPLAY_FontGlyph_t *Glyph)
+{
+    const DISPLAY_FontHeader_t *Header = (const DISPLAY_FontHeader_t *)Font;
+    uint32                      Bucket = DISPLAY_FontHash(Serial, Code);
+    uint16                      i;
+
+    for (i = Cache.Hash[Bucket]; i != DISPLAY_FONT_NONE; i = Cache.Cell[i].Next)
+    {
+        if (Cache.Cell[i].Serial == Serial && Cache.Cell[i].Code == Code)
+        {
+            Cache.Hits++;
+            DISPLAY_FontUnlink(i);
+            DISPLAY_FontMakeNewest(i);
+            return Cache.Pixels + (i * DISPLAY_FONT_CELL_PIXELS);
+        }
+    }
+
+    if ((uint32)Glyph->Width * Glyph->Height > DISPLAY_FONT_CELL_PIXELS || Glyph->Offset > Size ||
+        Glyph->Length > Size - Glyph->Offset)
+    {
+        return NULL;
+    }
+
+    Cache.Misses++;
+    i = (Cache.Used < Cache.Cells) ? Cache.Used++ : DISPLAY_FontEvict();
+
+    DISPLAY_FontExpand(Cache.Pixels + (i * DISPLAY_FONT_CELL_PIXELS), (uint32)Glyph->Width * Glyph->Height,
+                       Font + Glyph->Offset, Glyph->Length, Header->Bpp);
+
+    Cache.Cell[i].Serial = Serial;
+    Cache.Cell[i].Code   = Code;
+    Cache.Cell[i].Next   = Cache.Hash[Bucket];
+    Cache.Hash[Bucket]   = i;
+    DISPLAY_FontMakeNewest(i);
+
+    return Cache.Pixels + (i * DISPLAY_FONT_CELL_PIXELS);
+}
+
+/*
+** Draw up to Length characters of Text in the font in image slot Font,
+** the top of the line at Y. Returns DISPLAY_STATUS_ERROR_RANGE if the slot
+** holds no valid font, or DISPLAY_STATUS_ERROR_READ if some glyphs could
+** not be drawn; the others are drawn all the same.
+*/
+CFE_Status_t DISPLAY_FontDrawText(uint16 Font, int32 X, int32 Y, DISPLAY_Color_t Color, const char *Text,
+                                  uint32 Length)
+{
+    const DISPLAY_FontHeader_t *Header;
+    const DISPLAY_FontGlyph_t  *Glyphs;
+    const DISPLAY_FontGlyph_t  *Glyph;
+    const uint8                *Data;
+    const uint8                *Coverage;
+    CFE_Status_t                status = CFE_SUCCESS;
+    uint32                      Size, Serial, i;
+    uint8                       Code;
+    int32                       Baseline;
+
+    Data = (Cache.Pixels != NULL) ? DISPLAY_ImageGetFont(Font, &Size, &Serial) : NULL;
+    if (Data == NULL || Size < sizeof(*Header))
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Header = (const DISPLAY_FontHeader_t *)Data;
+    if (Header->Magic != DISPLAY_FONT_MAGIC || (Header->Bpp != 1 && Header->Bpp != 2 && Header->Bpp != 4) ||
+        (uint32)Header->Count * sizeof(*Glyph) > Size - sizeof(*Header))
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Glyphs   = (const DISPLAY_FontGlyph_t *)(Data + sizeof(*Header));
+    Baseline = Y + Header->Ascent;
+
+    for (i = 0; i < Length && Text[i] != 0; i++)
+    {
+        Code = (uint8)Text[i];
+        if (Code < Header->First || Code - Header->First >= Header->Count)
+        {
+            continue;
+        }
+
+        Glyph = &Glyphs[Code - Header->First];
+        if (Glyph->Width != 0 && Glyph->Height != 0)
+        {
+            Coverage = DISPLAY_FontGlyph(Data, Size, Serial, Code, Glyph);
+            if (Coverage != NULL)
+            {
+                DISPLAY_RenderGlyph(X + Glyph->Left, Baseline - Glyph->Top, Coverage, Glyph->Width, Glyph->Height,
+                                    Color);
+            }
+            else
+            {
+                status = DISPLAY_STATUS_ERROR_READ;
+            }
+        }
+
+        X += Glyph->Advance;
+    }
+
+    return status;
+}
+
+void DISPLAY_FontGetStats(uint32 *Hits, uint32 *Misses, uint16 *Cached)
+{
+    *Hits   = Cache.Hits;
+    *Misses = Cache.Misses;
+    *Cached = Cache.Used;
+}
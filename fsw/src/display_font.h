@@ -0,0 +1,59 @@
+#ifndef DISPLAY_FONT__H_
+#define DISPLAY_FONT__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_msg.h"
+
+/*
+** Font file layout, host byte order:
+**
+**   DISPLAY_FontHeader_t
+**   DISPLAY_FontGlyph_t, Count of them, for codes First to First + Count - 1
+**   glyph runs
+**
+** A glyph is Width x Height coverage values, in row order, of Bpp bits
+** each: 0 leaves what is under the glyph and the largest value paints the
+** text color. They are stored as runs, one byte per run: the low four bits
+** hold the value and the high four bits one less than the number of
+** pixels it covers. A glyph with no pixels, such as a space, has no runs.
+*/
+#define DISPLAY_FONT_MAGIC 0x544E4644 /* "DFNT" read as little endian */
+
+typedef struct
+{
+    uint32 Magic;
+    uint8  Bpp;        /* Coverage bits per pixel: 1, 2 or 4 */
+    uint8  LineHeight; /* Pixels from the top of one line to the next */
+    uint8  Ascent;     /* Pixels from the top of a line to its baseline */
+    uint8  First;      /* Code of the first glyph */
+    uint16 Count;      /* Glyphs in the font */
+    uint16 Spare;
+} DISPLAY_FontHeader_t;
+
+typedef struct
+{
+    uint32 Offset; /* Of the glyph's runs, from the start of the file */
+    uint16 Length; /* Bytes of runs */
+    uint8  Width;
+    uint8  Height;
+    int8   Left;    /* From the pen to the glyph's left edge */
+    int8   Top;     /* From the baseline up to the glyph's top row */
+    uint8  Advance; /* Pen movement to the next glyph */
+    uint8  Spare;
+} DISPLAY_FontGlyph_t;
+
+/*
+** Expanded glyphs are cached in cells of this many pixels, one byte of
+** coverage each, carved from the glyph pool. Larger glyphs cannot be drawn.
+*/
+#define DISPLAY_FONT_CELL_PIXELS 512
+#define DISPLAY_FONT_MAX_CELLS   128
+
+CFE_Status_t DISPLAY_FontInit(void);
+void         DISPLAY_FontClose(void);
+CFE_Status_t DISPLAY_FontDrawText(uint16 Font, int32 X, int32 Y, DISPLAY_Color_t Color, const char *Text,
+                                  uint32 Length);
+void         DISPLAY_FontGetStats(uint32 *Hits, uint32 *Misses, uint16 *Cached);
+
+#endif // DISPLAY_FONT__H_
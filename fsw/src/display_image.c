@@ -0,0 +1,357 @@
+#include "display_image.h"
+#include "display_arena.h"
+#include "display_dither.h"
+#include "display_job.h"
+#include "display_render.h"
+
+#include <string.h>
+
+/*
+** Resident image store. Pixels of all slots live back to back in the image
+** pool of the arena; freeing a slot slides the images above it down and
+** hands the space back to the top of the pool.
+**
+** Fonts are kept here too, as they were uploaded. Every load of a slot is
+** given a new serial number, so whatever was derived from an earlier font
+** in the same slot can tell it is out of date.
+**
+** RGB888 uploads are converted by a job, a few rows at a time, after the
+** slot is already READY. Whoever asks for the pixels first finishes the
+** conversion, so no one ever sees a part converted image.
+*/
+#define DISPLAY_IMAGE_CONVERT_ROWS 4 /* Per job slice, a whole dither pattern */
+
+typedef struct
+{
+    DISPLAY_ImageSlotInfo_t Info;
+    uint8                  *Pixels;
+    uint32                  Serial;
+    bool                    Converting; /* From RGB888, by DISPLAY_ImageConvertJob */
+    uint16                  Converted;  /* Rows done */
+} DISPLAY_ImageSlot_t;
+
+typedef struct
+{
+    uint8              *Top;    /* End of the highest image */
+    uint32              Serial; /* Last handed out */
+    DISPLAY_ImageSlot_t Slots[DISPLAY_MAX_IMAGE_SLOTS];
+} DISPLAY_ImageStore_t;
+
+static DISPLAY_ImageStore_t Images;
+
+/* Keep every image 4 byte aligned within the arena */
+#define DISPLAY_IMAGE_ALIGN(n) (((n) + 3u) & ~3u)
+
+CFE_Status_t DISPLAY_ImageInit(void)
+{
+    DISPLAY_ImageClose();
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_ImageClose(void)
+{
+    uint32 Serial = Images.Serial;
+
+    DISPLAY_ArenaReset(DISPLAY_POOL_IMAGE);
+    memset(&Images, 0, sizeof(Images));
+
+    /* Serials are never reused, even across a restart of the store */
+    Images.Serial = Serial;
+}
+
+/*
+** Bytes a Width x Height slot in Format holds once committed
+*/
+static uint32 DISPLAY_ImageStoredSize(uint8 Format, uint16 Width, uint16 Height)
+{
+    if (Format == DISPLAY_IMAGE_FORMAT_FONT)
+    {
+        return (uint32)Width * Height;
+    }
+
+    return (uint32)Width * Height * sizeof(uint16);
+}
+
+/*
+** Close a Size byte hole at Gap by sliding every image above it down
+*/
+static void DISPLAY_ImageRemoveGap(uint8 *Gap, uint32 Size)
+{
+    int i;
+
+    memmove(Gap, Gap + Size, Images.Top - (Gap + Size));
+    Images.Top -= Size;
+    DISPLAY_ArenaShrink(DISPLAY_POOL_IMAGE, Size);
+
+    for (i = 0; i < DISPLAY_MAX_IMAGE_SLOTS; i++)
+    {
+        if (Images.Slots[i].Info.State != DISPLAY_IMAGE_SLOT_FREE && Images.Slots[i].Pixels > Gap)
+        {
+            Images.Slots[i].Pixels -= Size;
+        }
+    }
+}
+
+/*
+** Claim LoadSize bytes of arena for a Width x Height image in Format in
+** Slot and return where the uploaded data goes. LoadSize is the size of
+** the data as sent, which may be larger than the stored RGB565 image. The
+** slot stays LOADING until DISPLAY_ImageCommit.
+*/
+CFE_Status_t DISPLAY_ImageReserve(uint16 Slot, const char *Name, uint16 Width, uint16 Height, uint8 Format,
+                                  uint32 LoadSize, uint8 **Pixels)
+{
+    DISPLAY_ImageSlot_t *SlotPtr;
+    uint32               Size = DISPLAY_IMAGE_ALIGN(LoadSize);
+    uint32               Free;
+
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS || Width == 0 || Height == 0 ||
+        LoadSize < DISPLAY_ImageStoredSize(Format, Width, Height))
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    /* An upload that cannot fit leaves the image already in the slot be */
+    SlotPtr = &Images.Slots[Slot];
+    Free    = DISPLAY_ArenaAvailable(DISPLAY_POOL_IMAGE);
+    if (SlotPtr->Info.State != DISPLAY_IMAGE_SLOT_FREE)
+    {
+        Free += SlotPtr->Info.Size;
+    }
+    if (Size > Free)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    DISPLAY_ImageFree(Slot);
+
+    SlotPtr->Pixels = DISPLAY_ArenaAlloc(DISPLAY_POOL_IMAGE, Size, 4);
+    if (SlotPtr->Pixels == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+    Images.Top = SlotPtr->Pixels + Size;
+
+    strncpy(SlotPtr->Info.Name, Name, sizeof(SlotPtr->Info.Name) - 1);
+    SlotPtr->Info.Name[sizeof(SlotPtr->Info.Name) - 1] = 0;
+    SlotPtr->Info.Width  = Width;
+    SlotPtr->Info.Height = Height;
+    SlotPtr->Info.Size   = Size;
+    SlotPtr->Info.State  = DISPLAY_IMAGE_SLOT_LOADING;
+
+    *Pixels = SlotPtr->Pixels;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Give back the space above the stored size of Slot once it is final.
+** Images above it move, so the render queue is drawn first.
+*/
+static void DISPLAY_ImageShrink(DISPLAY_ImageSlot_t *SlotPtr)
+{
+    uint32 Final = DISPLAY_IMAGE_ALIGN(DISPLAY_ImageStoredSize(SlotPtr->Info.Format, SlotPtr->Info.Width,
+                                                               SlotPtr->Info.Height));
+
+    if (SlotPtr->Info.Size > Final)
+    {
+        DISPLAY_RenderSync();
+        DISPLAY_ImageRemoveGap(SlotPtr->Pixels + Final, SlotPtr->Info.Size - Final);
+        SlotPtr->Info.Size = Final;
+    }
+}
+
+/*
+** Job step: convert the next few rows of an RGB888 upload in place. Rows
+** are taken in order, so each row's RGB565 output lands at or below data
+** still to be read. Done at once if the slot has since been freed or
+** finished.
+*/
+static bool DISPLAY_ImageConvertJob(uint32 Slot)
+{
+    DISPLAY_ImageSlot_t *SlotPtr = &Images.Slots[Slot];
+    uint32               Width   = SlotPtr->Info.Width;
+    uint32               Rows;
+
+    if (!SlotPtr->Converting)
+    {
+        return true;
+    }
+
+    Rows = SlotPtr->Info.Height - SlotPtr->Converted;
+    if (Rows > DISPLAY_IMAGE_CONVERT_ROWS)
+    {
+        Rows = DISPLAY_IMAGE_CONVERT_ROWS;
+    }
+
+    DISPLAY_DitherRgb888To565((uint16 *)SlotPtr->Pixels + ((uint32)SlotPtr->Converted * Width),
+                              SlotPtr->Pixels + ((uint32)SlotPtr->Converted * Width * 3), Width, Rows);
+    SlotPtr->Converted += Rows;
+
+    if (SlotPtr->Converted < SlotPtr->Info.Height)
+    {
+        return false;
+    }
+
+    SlotPtr->Converting = false;
+    DISPLAY_ImageShrink(SlotPtr);
+
+    return true;
+}
+
+/*
+** Mark the slot READY, converting the uploaded data from Format to RGB565
+** in place and returning any space this frees to the arena. RGB888 is
+** converted by a job started here. Fonts are kept as they are.
+*/
+CFE_Status_t DISPLAY_ImageCommit(uint16 Slot, uint8 Format)
+{
+    DISPLAY_ImageSlot_t *SlotPtr;
+
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS || Images.Slots[Slot].Info.State != DISPLAY_IMAGE_SLOT_LOADING)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    SlotPtr = &Images.Slots[Slot];
+
+    SlotPtr->Info.Format = (Format == DISPLAY_IMAGE_FORMAT_FONT) ? Format : DISPLAY_IMAGE_FORMAT_RGB565;
+    SlotPtr->Info.State  = DISPLAY_IMAGE_SLOT_READY;
+    SlotPtr->Serial      = ++Images.Serial;
+
+    if (Format == DISPLAY_IMAGE_FORMAT_RGB888)
+    {
+        SlotPtr->Converting = true;
+        SlotPtr->Converted  = 0;
+        DISPLAY_JobStart(DISPLAY_ImageConvertJob, Slot);
+    }
+    else
+    {
+        DISPLAY_ImageShrink(SlotPtr);
+    }
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t DISPLAY_ImageFree(uint16 Slot)
+{
+    DISPLAY_ImageSlot_t *SlotPtr;
+
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    SlotPtr = &Images.Slots[Slot];
+    if (SlotPtr->Info.State == DISPLAY_IMAGE_SLOT_FREE)
+    {
+        return CFE_SUCCESS;
+    }
+
+    DISPLAY_ImageRemoveGap(SlotPtr->Pixels, SlotPtr->Info.Size);
+    memset(SlotPtr, 0, sizeof(*SlotPtr));
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Bytes of upload data for a Width x Height image in Format, 0 if the
+** format is unknown
+*/
+uint32 DISPLAY_ImageFormatSize(uint8 Format, uint16 Width, uint16 Height)
+{
+    switch (Format)
+    {
+        case DISPLAY_IMAGE_FORMAT_RGB565:
+            return (uint32)Width * Height * 2;
+
+        case DISPLAY_IMAGE_FORMAT_RGB888:
+            return (uint32)Width * Height * 3;
+
+        case DISPLAY_IMAGE_FORMAT_FONT:
+            return (uint32)Width * Height;
+
+        default:
+            return 0;
+    }
+}
+
+const DISPLAY_ImageSlotInfo_t *DISPLAY_ImageGetSlot(uint16 Slot)
+{
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS)
+    {
+        return NULL;
+    }
+
+    return &Images.Slots[Slot].Info;
+}
+
+/*
+** Pixels of a READY image slot, or NULL. A slot still being converted is
+** finished first, which may move the images above it.
+*/
+const uint8 *DISPLAY_ImageGetPixels(uint16 Slot)
+{
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS || Images.Slots[Slot].Info.State != DISPLAY_IMAGE_SLOT_READY ||
+        Images.Slots[Slot].Info.Format == DISPLAY_IMAGE_FORMAT_FONT)
+    {
+        return NULL;
+    }
+
+    while (!DISPLAY_ImageConvertJob(Slot))
+    {
+    }
+
+    return Images.Slots[Slot].Pixels;
+}
+
+/*
+** Data of a READY font slot, its size and the serial of its load, or NULL.
+** Like images, fonts move when a lower slot is freed.
+*/
+const uint8 *DISPLAY_ImageGetFont(uint16 Slot, uint32 *Size, uint32 *Serial)
+{
+    const DISPLAY_ImageSlot_t *SlotPtr;
+
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS || Images.Slots[Slot].Info.State != DISPLAY_IMAGE_SLOT_READY ||
+        Images.Slots[Slot].Info.Format != DISPLAY_IMAGE_FORMAT_FONT)
+    {
+        return NULL;
+    }
+
+    SlotPtr = &Images.Slots[Slot];
+    *Size   = (uint32)SlotPtr->Info.Width * SlotPtr->Info.Height;
+    *Serial = SlotPtr->Serial;
+
+    return SlotPtr->Pixels;
+}
+
+/*
+** Pixels of a LOADING slot, or NULL. Images move when a lower slot is
+** freed, so callers filling a slot over time must fetch this every time.
+*/
+uint8 *DISPLAY_ImageGetLoadingPixels(uint16 Slot)
+{
+    if (Slot >= DISPLAY_MAX_IMAGE_SLOTS || Images.Slots[Slot].Info.State != DISPLAY_IMAGE_SLOT_LOADING)
+    {
+        return NULL;
+    }
+
+    return Images.Slots[Slot].Pixels;
+}
+
+void DISPLAY_ImageList(DISPLAY_ImageListTlm_Payload_t *Payload)
+{
+    DISPLAY_PoolStats_t Pools[DISPLAY_POOL_COUNT];
+    int                 i;
+
+    DISPLAY_ArenaGetStats(Pools);
+    Payload->ArenaSize = Pools[DISPLAY_POOL_IMAGE].Size;
+    Payload->ArenaUsed = Pools[DISPLAY_POOL_IMAGE].Used;
+
+    for (i = 0; i < DISPLAY_MAX_IMAGE_SLOTS; i++)
+    {
+        Payload->Slots[i] = Images.Slots[i].Info;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef DISPLAY_IMAGE__H_
+#define DISPLAY_IMAGE__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_msg.h"
+
+CFE_Status_t DISPLAY_ImageInit(void);
+void         DISPLAY_ImageClose(void);
+
+CFE_Status_t DISPLAY_ImageReserve(uint16 Slot, const char *Name, uint16 Width, uint16 Height, uint8 Format,
+                                  uint32 LoadSize, uint8 **Pixels);
+CFE_Status_t DISPLAY_ImageCommit(uint16 Slot, uint8 Format);
+uint32       DISPLAY_ImageFormatSize(uint8 Format, uint16 Width, uint16 Height);
+CFE_Status_t DISPLAY_ImageFree(uint16 Slot);
+
+const DISPLAY_ImageSlotInfo_t *DISPLAY_ImageGetSlot(uint16 Slot);
+const uint8                   *DISPLAY_ImageGetPixels(uint16 Slot);
+const uint8                   *DISPLAY_ImageGetFont(uint16 Slot, uint32 *Size, uint32 *Serial);
+uint8                         *DISPLAY_ImageGetLoadingPixels(uint16 Slot);
+
+void DISPLAY_ImageList(DISPLAY_ImageListTlm_Payload_t *Payload);
+
+#endif // DISPLAY_IMAGE__H_
@@ -0,0 +1,142 @@
+#include "display_job.h"
+
+#include <string.h>
+#include <time.h>
+
+/*
+** Resumable jobs. Work that grows with the size of a request is not done
+** inside the command that asks for it but left here as a job, which the
+** main loop runs a slice at a time between messages, for at most the
+** table's budget per pass. Housekeeping, table management and frame ticks
+** then wait for one pass at most, however large the request was.
+**
+** Jobs run in the order they were started. Whatever needs a job's result
+** before it is done finishes that job itself, so the order of commands is
+** kept without waiting on jobs here.
+*/
+typedef struct
+{
+    DISPLAY_JobStep_t Step;
+    uint32            Arg;
+} DISPLAY_Job_t;
+
+typedef struct
+{
+    DISPLAY_Job_t Jobs[DISPLAY_MAX_JOBS];
+    uint32        Head;
+    uint32        Count;
+    uint32        BudgetUs;
+    uint32        Done;
+    uint32        MaxPassUs; /* Longest pass since the last report */
+} DISPLAY_JobQueue_t;
+
+static DISPLAY_JobQueue_t JobQueue;
+
+static uint64 DISPLAY_JobNowUs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64)Now.tv_sec * 1000000) + ((uint64)Now.tv_nsec / 1000);
+}
+
+void DISPLAY_JobInit(void)
+{
+    memset(&JobQueue, 0, sizeof(JobQueue));
+}
+
+/*
+** Time per pass of the main loop; 0 runs each job to the end as it starts
+*/
+void DISPLAY_JobSetBudget(uint32 BudgetUs)
+{
+    JobQueue.BudgetUs = BudgetUs;
+}
+
+void DISPLAY_JobStart(DISPLAY_JobStep_t Step, uint32 Arg)
+{
+    DISPLAY_Job_t *Job;
+
+    if (JobQueue.BudgetUs == 0 || JobQueue.Count == DISPLAY_MAX_JOBS)
+    {
+        while (!Step(Arg))
+        {
+        }
+        JobQueue.Done++;
+        return;
+    }
+
+    Job       = &JobQueue.Jobs[(JobQueue.Head + JobQueue.Count) % DISPLAY_MAX_JOBS];
+    Job->Step = Step;
+    Job->Arg  = Arg;
+    JobQueue.Count++;
+}
+
+bool DISPLAY_JobPending(void)
+{
+    return JobQueue.Count > 0;
+}
+
+/*
+** Run the oldest job one slice further, dropping it once it is done
+*/
+static void DISPLAY_JobStep(void)
+{
+    DISPLAY_Job_t *Job = &JobQueue.Jobs[JobQueue.Head];
+
+    if (Job->Step(Job->Arg))
+    {
+        JobQueue.Head = (JobQueue.Head + 1) % DISPLAY_MAX_JOBS;
+        JobQueue.Count--;
+        JobQueue.Done++;
+    }
+}
+
+/*
+** One pass: slices until the budget is spent, and always at least one
+*/
+void DISPLAY_JobRun(void)
+{
+    uint64 StartUs, ElapsedUs;
+
+    if (JobQueue.Count == 0)
+    {
+        return;
+    }
+
+    StartUs = DISPLAY_JobNowUs();
+    do
+    {
+        DISPLAY_JobStep();
+        ElapsedUs = DISPLAY_JobNowUs() - StartUs;
+    } while (JobQueue.Count > 0 && ElapsedUs < JobQueue.BudgetUs);
+
+    if (ElapsedUs > JobQueue.MaxPassUs)
+    {
+        JobQueue.MaxPassUs = (uint32)ElapsedUs;
+    }
+}
+
+/*
+** Run every job to the end now
+*/
+void DISPLAY_JobFinish(void)
+{
+    while (JobQueue.Count > 0)
+    {
+        DISPLAY_JobStep();
+    }
+}
+
+/*
+** Jobs pending, jobs finished, and the longest pass since the last call
+*/
+void DISPLAY_JobGetStats(uint8 *Pending, uint32 *Done, uint16 *MaxPassUs)
+{
+    *Pending   = (uint8)JobQueue.Count;
+    *Done      = JobQueue.Done;
+    *MaxPassUs = (uint16)((JobQueue.MaxPassUs > 0xFFFF) ? 0xFFFF : JobQueue.MaxPassUs);
+
+    JobQueue.MaxPassUs = 0;
+}
@@ -0,0 +1,22 @@
+#ifndef DISPLAY_JOB__H_
+#define DISPLAY_JOB__H_
+
+#include "common_types.h"
+
+#define DISPLAY_MAX_JOBS 8 /* Jobs pending at once; more are run to the end as they start */
+
+/*
+** Does one slice of a job, a few tens of microseconds of work at most.
+** Returns true once there is nothing left to do.
+*/
+typedef bool (*DISPLAY_JobStep_t)(uint32 Arg);
+
+void DISPLAY_JobInit(void);
+void DISPLAY_JobSetBudget(uint32 BudgetUs);
+void DISPLAY_JobStart(DISPLAY_JobStep_t Step, uint32 Arg);
+bool DISPLAY_JobPending(void);
+void DISPLAY_JobRun(void);
+void DISPLAY_JobFinish(void);
+void DISPLAY_JobGetStats(uint8 *Pending, uint32 *Done, uint16 *MaxPassUs);
+
+#endif // DISPLAY_JOB__H_
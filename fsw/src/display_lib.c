@@ -0,0 +1,372 @@
+#include "display_lib.h"
+#include "display_msgids.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*
+** Rings between producer apps and the display, one per client slot.
+**
+** Head is written only by the producer and Tail only by the display app,
+** each published with a release store and read with an acquire load, so
+** neither side takes a lock or waits for the other. A full ring is
+** reported to the producer instead of overwritten.
+**
+** Generation is odd while a client holds the slot and is bumped whenever
+** it is attached or detached. Handles and queued draws carry the
+** generation they were made under, so a handle kept past its client's
+** unregistration is refused, and anything it queued in the meantime is
+** dropped rather than drawn into the next client's viewport.
+*/
+typedef struct
+{
+    uint32          Generation;
+    uint32          DrawMid;
+    uint32          Head;      /* Draws queued, ever; the sequence of the last one */
+    uint32          Tail;      /* Draws taken, ever */
+    uint32          Taken;     /* Sequence of the last draw taken */
+    uint32          Presented; /* Sequence of the last draw flushed */
+    DISPLAY_LibOp_t Ops[DISPLAY_LIB_RING_DEPTH];
+} DISPLAY_LibRing_t;
+
+static DISPLAY_LibRing_t Rings[DISPLAY_MAX_CLIENTS];
+
+/*
+** Library entry point, run once by ES before any app starts
+*/
+CFE_Status_t DISPLAY_LibInit(void)
+{
+    memset(Rings, 0, sizeof(Rings));
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Handle for drawing as the client registered on DrawMid
+*/
+CFE_Status_t DISPLAY_LibOpen(uint32 DrawMid, DISPLAY_LibHandle_t *Handle)
+{
+    uint32 Generation;
+    uint8  Slot;
+
+    if (Handle == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NULL;
+    }
+
+    for (Slot = 0; Slot < DISPLAY_MAX_CLIENTS; Slot++)
+    {
+        Generation = __atomic_load_n(&Rings[Slot].Generation, __ATOMIC_ACQUIRE);
+
+        if ((Generation & 1) != 0 && __atomic_load_n(&Rings[Slot].DrawMid, __ATOMIC_RELAXED) == DrawMid &&
+            __atomic_load_n(&Rings[Slot].Generation, __ATOMIC_ACQUIRE) == Generation)
+        {
+            Handle->Slot       = Slot;
+            Handle->Generation = Generation;
+            return CFE_SUCCESS;
+        }
+    }
+
+    return DISPLAY_STATUS_ERROR_RANGE;
+}
+
+static DISPLAY_LibRing_t *DISPLAY_LibRing(const DISPLAY_LibHandle_t *Handle)
+{
+    if (Handle == NULL || Handle->Slot >= DISPLAY_MAX_CLIENTS ||
+        __atomic_load_n(&Rings[Handle->Slot].Generation, __ATOMIC_ACQUIRE) != Handle->Generation)
+    {
+        return NULL;
+    }
+
+    return &Rings[Handle->Slot];
+}
+
+static CFE_Status_t DISPLAY_LibPush(const DISPLAY_LibHandle_t *Handle, DISPLAY_LibOp_t *Op, uint32 *Sequence)
+{
+    DISPLAY_LibRing_t *Ring = DISPLAY_LibRing(Handle);
+    uint32             Head;
+
+    if (Ring == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    /* Keeps X + Width and Y + Height well inside int32 when the draw is clipped */
+    if (Op->X < DISPLAY_LIB_MIN_COORD || Op->X > DISPLAY_LIB_MAX_COORD || Op->Y < DISPLAY_LIB_MIN_COORD ||
+        Op->Y > DISPLAY_LIB_MAX_COORD || Op->Width > DISPLAY_LIB_MAX_SIZE || Op->Height > DISPLAY_LIB_MAX_SIZE)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Head = __atomic_load_n(&Ring->Head, __ATOMIC_RELAXED);
+    if (Head - __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE) >= DISPLAY_LIB_RING_DEPTH)
+    {
+        return DISPLAY_STATUS_ERROR_BUSY;
+    }
+
+    Op->Generation = Handle->Generation;
+    Op->Sequence   = Head + 1;
+    Op->Sent       = CFE_TIME_GetTime();
+
+    Ring->Ops[Head % DISPLAY_LIB_RING_DEPTH] = *Op;
+    __atomic_store_n(&Ring->Head, Head + 1, __ATOMIC_RELEASE);
+
+    if (Sequence != NULL)
+    {
+        *Sequence = Op->Sequence;
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Queue a filled rectangle. Sequence, if given, receives the number to
+** compare with DISPLAY_LibPresented.
+*/
+CFE_Status_t DISPLAY_LibFillRect(const DISPLAY_LibHandle_t *Handle, int32 X, int32 Y, uint32 Width, uint32 Height,
+                                 DISPLAY_Color_t Color, uint32 *Sequence)
+{
+    DISPLAY_LibOp_t Op;
+
+    memset(&Op, 0, sizeof(Op));
+    Op.Op     = DISPLAY_LIB_OP_FILL;
+    Op.X      = X;
+    Op.Y      = Y;
+    Op.Width  = Width;
+    Op.Height = Height;
+    Op.Color  = Color;
+
+    return DISPLAY_LibPush(Handle, &Op, Sequence);
+}
+
+CFE_Status_t DISPLAY_LibGradient(const DISPLAY_LibHandle_t *Handle, int32 X, int32 Y, uint32 Width, uint32 Height,
+                                 DISPLAY_Color_t From, DISPLAY_Color_t To, bool Vertical, uint32 *Sequence)
+{
+    DISPLAY_LibOp_t Op;
+
+    memset(&Op, 0, sizeof(Op));
+    Op.Op       = DISPLAY_LIB_OP_GRADIENT;
+    Op.X        = X;
+    Op.Y        = Y;
+    Op.Width    = Width;
+    Op.Height   = Height;
+    Op.Color    = From;
+    Op.To       = To;
+    Op.Vertical = Vertical;
+
+    return DISPLAY_LibPush(Handle, &Op, Sequence);
+}
+
+/*
+** Queue a draw of a resident image. The slot is checked when the draw
+** runs, not here.
+*/
+CFE_Status_t DISPLAY_LibDrawImage(const DISPLAY_LibHandle_t *Handle, uint16 Image, int32 X, int32 Y,
+                                  uint32 *Sequence)
+{
+    DISPLAY_LibOp_t Op;
+
+    memset(&Op, 0, sizeof(Op));
+    Op.Op    = DISPLAY_LIB_OP_IMAGE;
+    Op.Image = Image;
+    Op.X     = X;
+    Op.Y     = Y;
+
+    return DISPLAY_LibPush(Handle, &Op, Sequence);
+}
+
+/*
+** Queue a blit of the caller's own RGB565 pixels, which are read in place
+** when the draw runs: they must stay as they are until
+** DISPLAY_LibPresented reaches the returned sequence.
+*/
+CFE_Status_t DISPLAY_LibBlit565(const DISPLAY_LibHandle_t *Handle, int32 X, int32 Y, const uint8 *Pixels,
+                                uint32 Width, uint32 Height, uint32 *Sequence)
+{
+    DISPLAY_LibOp_t Op;
+
+    if (Pixels == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NULL;
+    }
+
+    memset(&Op, 0, sizeof(Op));
+    Op.Op     = DISPLAY_LIB_OP_BLIT;
+    Op.X      = X;
+    Op.Y      = Y;
+    Op.Width  = Width;
+    Op.Height = Height;
+    Op.Pixels = Pixels;
+
+    return DISPLAY_LibPush(Handle, &Op, Sequence);
+}
+
+/*
+** Sequence of the last draw the display has finished with: flushed to the
+** panel, or dropped as invalid. 0 for a stale handle.
+*/
+uint32 DISPLAY_LibPresented(const DISPLAY_LibHandle_t *Handle)
+{
+    DISPLAY_LibRing_t *Ring = DISPLAY_LibRing(Handle);
+
+    if (Ring == NULL)
+    {
+        return 0;
+    }
+
+    return __atomic_load_n(&Ring->Presented, __ATOMIC_ACQUIRE);
+}
+
+/*
+** Software bus buffer holding an image upload command for the given image,
+** with Data pointed at where its Width * Height pixels go. NULL if the
+** format is unknown, the image is too large for one upload, or the bus has
+** no buffer to give.
+*/
+CFE_SB_Buffer_t *DISPLAY_LibUploadAlloc(uint16 Image, uint16 Width, uint16 Height, uint8 Format, const char *Name,
+                                        uint8 **Data)
+{
+    DISPLAY_ImageUploadCmd_t *Cmd;
+    CFE_SB_Buffer_t          *SBBufPtr;
+    size_t                    Size;
+
+    switch (Format)
+    {
+        case DISPLAY_IMAGE_FORMAT_RGB565:
+            Size = (size_t)Width * Height * 2;
+            break;
+
+        case DISPLAY_IMAGE_FORMAT_RGB888:
+            Size = (size_t)Width * Height * 3;
+            break;
+
+        case DISPLAY_IMAGE_FORMAT_FONT:
+            Size = (size_t)Width * Height;
+            break;
+
+        default:
+            return NULL;
+    }
+
+    if (Data == NULL || Size == 0 || Size > DISPLAY_IMAGE_UPLOAD_MAX_BYTES)
+    {
+        return NULL;
+    }
+
+    Size += offsetof(DISPLAY_ImageUploadCmd_t, Data);
+
+    SBBufPtr = CFE_SB_AllocateMessageBuffer(Size);
+    if (SBBufPtr == NULL)
+    {
+        return NULL;
+    }
+
+    Cmd = (DISPLAY_ImageUploadCmd_t *)SBBufPtr;
+    memset(Cmd, 0, offsetof(DISPLAY_ImageUploadCmd_t, Data));
+
+    CFE_MSG_Init(&SBBufPtr->Msg, CFE_SB_ValueToMsgId(DISPLAY_CMD_MID), Size);
+    CFE_MSG_SetFcnCode(&SBBufPtr->Msg, DISPLAY_IMAGE_UPLOAD_CC);
+
+    Cmd->Slot   = Image;
+    Cmd->Width  = Width;
+    Cmd->Height = Height;
+    Cmd->Format = Format;
+    if (Name != NULL)
+    {
+        strncpy(Cmd->Name, Name, sizeof(Cmd->Name) - 1);
+    }
+
+    *Data = Cmd->Data;
+
+    return SBBufPtr;
+}
+
+/*
+** Send an upload from DISPLAY_LibUploadAlloc. The buffer belongs to the
+** bus afterwards, or is released here if it could not be sent.
+*/
+CFE_Status_t DISPLAY_LibUploadSend(CFE_SB_Buffer_t *SBBufPtr)
+{
+    CFE_Status_t status;
+
+    if (SBBufPtr == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NULL;
+    }
+
+    status = CFE_SB_TransmitBuffer(SBBufPtr, true);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_SB_ReleaseMessageBuffer(SBBufPtr);
+    }
+
+    return status;
+}
+
+/*
+** Give Slot to the client on DrawMid. Anything left on its ring from an
+** earlier client is skipped.
+*/
+void DISPLAY_LibAttach(uint8 Slot, uint32 DrawMid)
+{
+    DISPLAY_LibRing_t *Ring = &Rings[Slot];
+    uint32             Head;
+
+    DISPLAY_LibDetach(Slot);
+
+    Head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+
+    __atomic_store_n(&Ring->DrawMid, DrawMid, __ATOMIC_RELAXED);
+    Ring->Taken = Head;
+    __atomic_store_n(&Ring->Presented, Head, __ATOMIC_RELEASE);
+    __atomic_store_n(&Ring->Tail, Head, __ATOMIC_RELEASE);
+    __atomic_store_n(&Ring->Generation, Ring->Generation + 1, __ATOMIC_RELEASE);
+}
+
+void DISPLAY_LibDetach(uint8 Slot)
+{
+    DISPLAY_LibRing_t *Ring = &Rings[Slot];
+
+    if ((Ring->Generation & 1) != 0)
+    {
+        __atomic_store_n(&Ring->Generation, Ring->Generation + 1, __ATOMIC_RELEASE);
+    }
+}
+
+/*
+** Next draw queued on Slot by its current client, if any
+*/
+bool DISPLAY_LibTake(uint8 Slot, DISPLAY_LibOp_t *Op)
+{
+    DISPLAY_LibRing_t *Ring = &Rings[Slot];
+    uint32             Tail = Ring->Tail;
+
+    while (Tail != __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE))
+    {
+        *Op = Ring->Ops[Tail % DISPLAY_LIB_RING_DEPTH];
+        Tail++;
+        __atomic_store_n(&Ring->Tail, Tail, __ATOMIC_RELEASE);
+
+        if (Op->Generation == Ring->Generation)
+        {
+            Ring->Taken = Op->Sequence;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+** Report every draw taken so far as presented; called after the flush
+** that sent them to the panel
+*/
+void DISPLAY_LibPresent(void)
+{
+    int i;
+
+    for (i = 0; i < DISPLAY_MAX_CLIENTS; i++)
+    {
+        __atomic_store_n(&Rings[i].Presented, Rings[i].Taken, __ATOMIC_RELEASE);
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef DISPLAY_LIB__H_
+#define DISPLAY_LIB__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "cfe_sb.h"
+#include "cfe_time.h"
+#include "display_msg.h"
+
+/*
+** In-process drawing for apps on the same processor as the display.
+**
+** The display_lib module is loaded as a cFE library ahead of the display
+** app and the apps that draw through it, with DISPLAY_LibInit as its entry
+** point. An app that has been registered as a client, by the
+** DISPLAY_CLIENT_REGISTER_CC ground command as usual, opens a handle on its
+** draw MID and then calls the draw functions below. Each one places the
+** draw on a ring shared with the display app and returns at once; the
+** display runs it on the next frame tick, inside the client's viewport and
+** budgets, exactly as if it had arrived on the client's pipe. There is no
+** message to build, send, receive or check.
+**
+** A ring has one producer: each client draws from a single task. A handle
+** goes stale when its client is unregistered or the display app restarts,
+** and every call with it then fails with DISPLAY_STATUS_ERROR_RANGE.
+** Draws made here are acknowledged like any other, under the client's draw
+** MID with DISPLAY_ACK_SOURCE_LIB set: the ring numbers its draws itself,
+** apart from any the client sends on its pipe. They are not written to the
+** command log.
+**
+** Positions and sizes have the range of the draw commands: X and Y fit in
+** an int16 and Width and Height in a uint16. A draw outside that range is
+** refused with DISPLAY_STATUS_ERROR_RANGE.
+**
+** Image uploads are too large for the ring and still go through the
+** software bus, but without a copy: DISPLAY_LibUploadAlloc hands out a
+** message buffer with the upload command already laid out, the caller
+** writes its pixels straight into it, and DISPLAY_LibUploadSend passes the
+** buffer itself to the display's command pipe.
+*/
+#define DISPLAY_LIB_RING_DEPTH 32 /* Draws a client may have queued, a power of two */
+
+#define DISPLAY_LIB_MIN_COORD DISPLAY_DRAW_MIN_COORD
+#define DISPLAY_LIB_MAX_COORD DISPLAY_DRAW_MAX_COORD
+#define DISPLAY_LIB_MAX_SIZE  DISPLAY_DRAW_MAX_SIZE
+
+#define DISPLAY_LIB_OP_FILL     1
+#define DISPLAY_LIB_OP_GRADIENT 2
+#define DISPLAY_LIB_OP_IMAGE    3
+#define DISPLAY_LIB_OP_BLIT     4
+
+typedef struct
+{
+    uint8  Slot;
+    uint32 Generation;
+} DISPLAY_LibHandle_t;
+
+/*
+** One queued draw, in viewport coordinates
+*/
+typedef struct
+{
+    uint32             Generation; /* Of the handle it was made with */
+    uint32             Sequence;   /* Returned to the producer */
+    CFE_TIME_SysTime_t Sent;
+    uint8              Op;         /* DISPLAY_LIB_OP_* */
+    uint8              Vertical;
+    uint16             Image;      /* Image slot */
+    int32              X;
+    int32              Y;
+    uint32             Width;
+    uint32             Height;
+    DISPLAY_Color_t    Color;
+    DISPLAY_Color_t    To;
+    const uint8       *Pixels; /* Blit source, owned by the producer */
+} DISPLAY_LibOp_t;
+
+/* Library entry point */
+CFE_Status_t DISPLAY_LibInit(void);
+
+/* For producer apps */
+CFE_Status_t DISPLAY_LibOpen(uint32 DrawMid, DISPLAY_LibHandle_t *Handle);
+CFE_Status_t DISPLAY_LibFillRect(const DISPLAY_LibHandle_t *Handle, int32 X, int32 Y, uint32 Width, uint32 Height,
+                                 DISPLAY_Color_t Color, uint32 *Sequence);
+CFE_Status_t DISPLAY_LibGradient(const DISPLAY_LibHandle_t *Handle, int32 X, int32 Y, uint32 Width, uint32 Height,
+                                 DISPLAY_Color_t From, DISPLAY_Color_t To, bool Vertical, uint32 *Sequence);
+CFE_Status_t DISPLAY_LibDrawImage(const DISPLAY_LibHandle_t *Handle, uint16 Image, int32 X, int32 Y,
+                                  uint32 *Sequence);
+CFE_Status_t DISPLAY_LibBlit565(const DISPLAY_LibHandle_t *Handle, int32 X, int32 Y, const uint8 *Pixels,
+                                uint32 Width, uint32 Height, uint32 *Sequence);
+uint32       DISPLAY_LibPresented(const DISPLAY_LibHandle_t *Handle);
+
+CFE_SB_Buffer_t *DISPLAY_LibUploadAlloc(uint16 Image, uint16 Width, uint16 Height, uint8 Format, const char *Name,
+                                        uint8 **Data);
+CFE_Status_t     DISPLAY_LibUploadSend(CFE_SB_Buffer_t *SBBufPtr);
+
+/* For the display app */
+void DISPLAY_LibAttach(uint8 Slot, uint32 DrawMid);
+void DISPLAY_LibDetach(uint8 Slot);
+bool DISPLAY_LibTake(uint8 Slot, DISPLAY_LibOp_t *Op);
+void DISPLAY_LibPresent(void);
+
+#endif // DISPLAY_LIB__H_
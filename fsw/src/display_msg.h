@@ -39,6 +39,158 @@
 #define DISPLAY_RESET_COUNTERS_CC 1
 #define DISPLAY_PROCESS_CC        2
 #define DISPLAY_FILLRECT_CC       3
+#define DISPLAY_IMAGE_UPLOAD_CC   4
+#define DISPLAY_IMAGE_FREE_CC     5
+#define DISPLAY_IMAGE_LIST_CC     6
+#define DISPLAY_DRAW_IMAGE_CC     7
+#define DISPLAY_XFER_BEGIN_CC     8
+#define DISPLAY_XFER_CHUNK_CC     9
+#define DISPLAY_XFER_COMMIT_CC    10
+#define DISPLAY_XFER_ABORT_CC     11
+#define DISPLAY_XFER_STATUS_CC    12
+#define DISPLAY_GRADIENT_CC       13
+#define DISPLAY_CLIENT_REGISTER_CC   14
+#define DISPLAY_CLIENT_UNREGISTER_CC 15
+#define DISPLAY_CLIENT_LIST_CC       16
+#define DISPLAY_LAYER_SET_CC         17
+#define DISPLAY_LAYER_SELECT_CC      18
+#define DISPLAY_RECORD_START_CC      19
+#define DISPLAY_RECORD_STOP_CC       20
+#define DISPLAY_ANIM_SET_CC          21
+#define DISPLAY_ANIM_STOP_CC         22
+#define DISPLAY_CRC_CC               23
+#define DISPLAY_SCREENSHOT_CC        24
+#define DISPLAY_TEXT_CC              25
+
+/*
+** Image slot store limits
+*/
+#define DISPLAY_MAX_IMAGE_SLOTS        32   /* Number of resident image slots */
+#define DISPLAY_IMAGE_NAME_LEN         16   /* Including the terminating NUL */
+#define DISPLAY_IMAGE_UPLOAD_MAX_BYTES 8192 /* Largest pixel payload of one upload command */
+
+/*
+** Pixel formats accepted by image uploads. Images are stored as RGB565;
+** RGB888 data is converted with ordered dithering when the upload completes.
+** A slot may instead hold a font for DISPLAY_TEXT_CC, stored as sent: its
+** Width x Height bytes are the font file laid out as in display_font.h, so
+** any shape that holds it will do, Height 1 for instance.
+*/
+#define DISPLAY_IMAGE_FORMAT_RGB565 0 /* uint16 per pixel, host byte order */
+#define DISPLAY_IMAGE_FORMAT_RGB888 1 /* 3 bytes per pixel: red, green, blue */
+#define DISPLAY_IMAGE_FORMAT_FONT   2 /* Compressed font, one byte per "pixel" */
+
+/*
+** Text drawing
+*/
+#define DISPLAY_TEXT_MAX_LEN 64 /* Characters in one text command, including any NUL */
+
+/*
+** Memory pools carved out of the arena reserved at startup
+*/
+#define DISPLAY_POOL_FRAME 0 /* Layer and composite buffers */
+#define DISPLAY_POOL_GLYPH 1 /* Glyph caches */
+#define DISPLAY_POOL_IMAGE 2 /* Resident image slots */
+#define DISPLAY_POOL_RING  3 /* Command and draw queues */
+#define DISPLAY_POOL_COUNT 4
+
+/*
+** Segmented transfer limits
+*/
+#define DISPLAY_XFER_CHUNK_MAX_BYTES 8192 /* Largest payload of one chunk command */
+#define DISPLAY_XFER_MAX_CHUNKS      1024 /* Chunks per transfer */
+
+/*
+** Layers, composited bottom to top in Z order. Defaults: Z equals the
+** layer number, the background is opaque and the others treat black as
+** transparent.
+*/
+#define DISPLAY_LAYER_BACKGROUND 0
+#define DISPLAY_LAYER_TELEMETRY  1
+#define DISPLAY_LAYER_ALERT      2
+#define DISPLAY_LAYER_CURSOR     3
+#define DISPLAY_MAX_LAYERS       4
+
+/*
+** Producer apps that draw into their own viewport
+*/
+#define DISPLAY_MAX_CLIENTS 8
+
+/*
+** Separate damaged areas kept between flushes
+*/
+#define DISPLAY_DAMAGE_MAX_RECTS 16
+
+/*
+** Command recorder
+*/
+#define DISPLAY_RECORD_PATH_LEN 64 /* Log file name, including the terminating NUL */
+
+/*
+** Animations evaluated on the frame tick. Each moves, resizes, recolors
+** or blinks one filled rectangle or resident image through a list of
+** keyframes that repeats every period.
+*/
+#define DISPLAY_MAX_ANIMS     16
+#define DISPLAY_ANIM_MAX_KEYS 8
+
+#define DISPLAY_ANIM_TARGET_RECT  0 /* Filled rectangle in Color */
+#define DISPLAY_ANIM_TARGET_IMAGE 1 /* Resident image slot */
+
+#define DISPLAY_ANIM_PROP_X       0 /* Value added to X, pixels */
+#define DISPLAY_ANIM_PROP_Y       1 /* Value added to Y, pixels */
+#define DISPLAY_ANIM_PROP_WIDTH   2 /* Width in pixels, rectangles only */
+#define DISPLAY_ANIM_PROP_HEIGHT  3 /* Height in pixels, rectangles only */
+#define DISPLAY_ANIM_PROP_COLOR   4 /* 0xRRGGBB, rectangles only */
+#define DISPLAY_ANIM_PROP_VISIBLE 5 /* Nonzero shows the primitive; never interpolated */
+
+#define DISPLAY_ANIM_EASE_LINEAR      0
+#define DISPLAY_ANIM_EASE_STEP        1 /* Hold each key until the next */
+#define DISPLAY_ANIM_EASE_IN          2 /* Quadratic */
+#define DISPLAY_ANIM_EASE_OUT         3
+#define DISPLAY_ANIM_EASE_IN_OUT      4 /* Smoothstep */
+
+#define DISPLAY_ANIM_MODE_LOOP 0 /* Restart every period */
+#define DISPLAY_ANIM_MODE_ONCE 1 /* Hold the last key after one period */
+
+/*
+** Edge in pixels of the square tiles the displayed frame is checksummed in
+*/
+#define DISPLAY_CRC_TILE 16
+
+/*
+** Screenshot streaming. Captures are sent in DISPLAY_CRC_TILE tiles, run
+** length encoded, several to a packet.
+*/
+#define DISPLAY_SHOT_DATA_BYTES 1536 /* Tile records per packet; holds any one tile */
+
+#define DISPLAY_SHOT_MODE_FULL  0 /* Every tile */
+#define DISPLAY_SHOT_MODE_DELTA 1 /* Tiles whose CRC changed since they were last sent */
+
+#define DISPLAY_SHOT_FLAG_DELTA 0x01 /* Capture holds changed tiles only */
+#define DISPLAY_SHOT_FLAG_LAST  0x02 /* Final packet of the capture */
+
+#define DISPLAY_SHOT_ENCODING_RAW 0 /* Pixels in row order */
+#define DISPLAY_SHOT_ENCODING_RLE 1 /* PackBits over whole pixels, see DISPLAY_ShotTileHeader_t */
+
+/*
+** Routines the copy to the panel can use, see DISPLAY_PerfTlm_Payload_t
+*/
+#define DISPLAY_PRESENT_PATH_SCALAR 0 /* Ordinary stores */
+#define DISPLAY_PRESENT_PATH_SSE2   1 /* Full cache lines of 16 byte non-temporal stores */
+#define DISPLAY_PRESENT_PATH_AVX    2 /* Full cache lines of 32 byte non-temporal stores */
+
+/*
+** How flushes are timed to the panel refresh, see DISPLAY_PerfTlm_Payload_t
+*/
+#define DISPLAY_PACE_NONE  0 /* Copied at once; no refresh period is known */
+#define DISPLAY_PACE_VSYNC 1 /* After the driver's vertical blank */
+#define DISPLAY_PACE_TIMER 2 /* At the refresh start estimated from the last one and the period */
+
+/*
+** Set in a draw acknowledgement's Source for draws made through display_lib
+*/
+#define DISPLAY_ACK_SOURCE_LIB 0x80000000
 
 /*
 ** DISPLAY App error codes
@@ -46,6 +198,11 @@
 #define DISPLAY_STATUS_ERROR_NULL ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 1))
 #define DISPLAY_STATUS_ERROR_OPEN ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 2))
 #define DISPLAY_STATUS_ERROR_READ ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 3))
+#define DISPLAY_STATUS_ERROR_NOMEM ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 4))
+#define DISPLAY_STATUS_ERROR_RANGE ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 5))
+#define DISPLAY_STATUS_ERROR_CRC   ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 6))
+#define DISPLAY_STATUS_ERROR_WRITE ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 7))
+#define DISPLAY_STATUS_ERROR_BUSY  ((CFE_Status_t) (CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE | 8))
 
 /*************************************************************************/
 
@@ -67,6 +224,10 @@ typedef struct
 typedef DISPLAY_NoArgsCmd_t DISPLAY_NoopCmd_t;
 typedef DISPLAY_NoArgsCmd_t DISPLAY_ResetCountersCmd_t;
 typedef DISPLAY_NoArgsCmd_t DISPLAY_ProcessCmd_t;
+typedef DISPLAY_NoArgsCmd_t DISPLAY_ImageListCmd_t;
+typedef DISPLAY_NoArgsCmd_t DISPLAY_XferStatusCmd_t;
+typedef DISPLAY_NoArgsCmd_t DISPLAY_ClientListCmd_t;
+typedef DISPLAY_NoArgsCmd_t DISPLAY_RecordStopCmd_t;
 
 typedef struct
 {
@@ -76,6 +237,14 @@ typedef struct
     uint8 alpha;
 } DISPLAY_Color_t;
 
+/*
+** Fill and gradient positions are read as signed and must fit an int16,
+** and sizes a uint16; draws outside that range are refused
+*/
+#define DISPLAY_DRAW_MIN_COORD -32768
+#define DISPLAY_DRAW_MAX_COORD 32767
+#define DISPLAY_DRAW_MAX_SIZE  0xFFFF
+
 typedef struct
 {
     CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
@@ -86,17 +255,322 @@ typedef struct
     uint32          sizeY;
 } DISPLAY_FillRectCmd_t;
 
+/*
+** Draw commands (fill rectangle, gradient, draw image and text), from the ground
+** or a client, may carry this after their other fields to be acknowledged
+** once they reach the panel, in DISPLAY_ACK_TLM_MID. Sequence is the
+** sender's own count. Sent is the sender's CFE_TIME_GetTime when it issued
+** the command; left zero, the command header's time is used where the
+** mission's headers have one, and otherwise the time the display ran it.
+*/
+typedef struct
+{
+    uint32 Sequence;
+    uint32 SentSeconds;
+    uint32 SentSubseconds;
+} DISPLAY_DrawSeq_t;
+
+/*
+** Store an image in a slot, replacing whatever the slot held.
+** Data holds Width * Height pixels in Format, in row order, and the command
+** is only as long as that: its length must be
+** offsetof(DISPLAY_ImageUploadCmd_t, Data) + Width * Height * pixel size.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  Slot;
+    uint16                  Width;
+    uint16                  Height;
+    uint8                   Format; /**< \brief One of DISPLAY_IMAGE_FORMAT_* */
+    uint8                   Spare;
+    char                    Name[DISPLAY_IMAGE_NAME_LEN];
+    uint8                   Data[DISPLAY_IMAGE_UPLOAD_MAX_BYTES];
+} DISPLAY_ImageUploadCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  Slot;
+    uint16                  Spare;
+} DISPLAY_ImageFreeCmd_t;
+
+/*
+** Draw a resident image with its top left corner at X, Y
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  Slot;
+    int16                   X;
+    int16                   Y;
+    uint16                  Spare;
+} DISPLAY_DrawImageCmd_t;
+
+/*
+** Start a segmented upload of a Width x Height image in Format into Slot.
+** TotalSize bytes follow in chunks of ChunkSize bytes (the last may be
+** short). TransferId is chosen by the sender and tags every chunk, so
+** chunks left over from an earlier transfer are rejected.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  TransferId;
+    uint16                  Slot;
+    uint16                  Width;
+    uint16                  Height;
+    uint32                  TotalSize;
+    uint16                  ChunkSize;
+    uint8                   Format; /**< \brief One of DISPLAY_IMAGE_FORMAT_* */
+    uint8                   Spare;
+    char                    Name[DISPLAY_IMAGE_NAME_LEN];
+} DISPLAY_XferBeginCmd_t;
+
+/*
+** One chunk of a segmented upload. Offset must equal Sequence * ChunkSize,
+** and the command is only as long as its data:
+** offsetof(DISPLAY_XferChunkCmd_t, Data) + Length.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  TransferId;
+    uint16                  Sequence;
+    uint32                  Offset;
+    uint16                  Length;
+    uint16                  Spare;
+    uint8                   Data[DISPLAY_XFER_CHUNK_MAX_BYTES];
+} DISPLAY_XferChunkCmd_t;
+
+/*
+** Finish a segmented upload. Crc is CFE_ES_CalculateCRC of all TotalSize
+** bytes using the mission default CRC type.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  TransferId;
+    uint16                  Spare;
+    uint32                  Crc;
+} DISPLAY_XferCommitCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  TransferId;
+    uint16                  Spare;
+} DISPLAY_XferAbortCmd_t;
+
+/*
+** Fill a rectangle with a linear gradient from colorFrom to colorTo,
+** left to right, or top to bottom when vertical is nonzero. Dithered to
+** hide banding on RGB565 panels.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    DISPLAY_Color_t         colorFrom;
+    DISPLAY_Color_t         colorTo;
+    uint32                  startX;
+    uint32                  startY;
+    uint32                  sizeX;
+    uint32                  sizeY;
+    uint8                   vertical;
+    uint8                   spare[3];
+} DISPLAY_GradientCmd_t;
+
+/*
+** Give the app publishing DrawMid its own pipe and screen area. Draw
+** commands sent on DrawMid use the same command codes and formats as the
+** ground draw commands, with coordinates relative to the top left corner
+** of the viewport, and are clipped to it. Registering a DrawMid again
+** moves its viewport.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint32                  DrawMid;
+    uint16                  X;
+    uint16                  Y;
+    uint16                  Width;
+    uint16                  Height;
+    uint8                   Layer; /**< \brief DISPLAY_LAYER_* the client draws on */
+    uint8                   Spare[3];
+} DISPLAY_ClientRegisterCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint32                  DrawMid;
+} DISPLAY_ClientUnregisterCmd_t;
+
+/*
+** Restack or hide a layer. With keyEnabled, pixels of the layer equal to
+** keyColor show the layers below; otherwise the layer is opaque.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8                   layer;
+    uint8                   z;
+    uint8                   visible;
+    uint8                   keyEnabled;
+    DISPLAY_Color_t         keyColor;
+} DISPLAY_LayerSetCmd_t;
+
+/*
+** Choose the layer that ground draw commands go to
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8                   layer;
+    uint8                   spare[3];
+} DISPLAY_LayerSelectCmd_t;
+
+/*
+** Log every handled command and client draw message to Filename,
+** replacing the file if it exists
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    char                    Filename[DISPLAY_RECORD_PATH_LEN];
+} DISPLAY_RecordStartCmd_t;
+
+/*
+** One keyframe: the property takes Value at Time into the period and is
+** interpolated towards the next key with the animation's easing
+*/
+typedef struct
+{
+    uint16 Time; /**< \brief Milliseconds from the start of the period, not decreasing */
+    uint16 Spare;
+    int32  Value;
+} DISPLAY_AnimKey_t;
+
+/*
+** Define animation Id, replacing (and erasing) any previous one with that
+** Id. X, Y, Width, Height and Color describe the primitive at rest, in
+** frame coordinates on Layer; Width and Height are ignored for images.
+** Only the first KeyCount keys are used.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8                   Id;
+    uint8                   Target;   /**< \brief One of DISPLAY_ANIM_TARGET_* */
+    uint8                   Property; /**< \brief One of DISPLAY_ANIM_PROP_* */
+    uint8                   Easing;   /**< \brief One of DISPLAY_ANIM_EASE_* */
+    uint8                   Layer;
+    uint8                   Mode;     /**< \brief One of DISPLAY_ANIM_MODE_* */
+    uint8                   KeyCount;
+    uint8                   Spare;
+    uint32                  PeriodMs;
+    int16                   X;
+    int16                   Y;
+    uint16                  Width;
+    uint16                  Height;
+    uint16                  Slot;
+    uint16                  Spare2;
+    DISPLAY_Color_t         Color;
+    DISPLAY_AnimKey_t       Keys[DISPLAY_ANIM_MAX_KEYS];
+} DISPLAY_AnimSetCmd_t;
+
+/*
+** Stop animation Id. With Clear nonzero its last frame is erased to the
+** layer's key color; otherwise it stays on screen as drawn.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8                   Id;
+    uint8                   Clear;
+    uint8                   Spare[2];
+} DISPLAY_AnimStopCmd_t;
+
+/*
+** Report the checksum of the displayed frame over the given rectangle, in
+** frame coordinates, or over the whole frame when W or H is zero
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  X;
+    uint16                  Y;
+    uint16                  W;
+    uint16                  H;
+} DISPLAY_CrcCmd_t;
+
+/*
+** Start streaming what the panel shows, in DISPLAY_SHOT_TLM_MID packets at
+** the table's byte rate. Refused while a capture is still being sent.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8                   Mode;      /**< \brief One of DISPLAY_SHOT_MODE_* */
+    uint8                   Spare[3];
+} DISPLAY_ScreenshotCmd_t;
+
+/*
+** Draw one line of text in a font held in an image slot, the top of the
+** line at Y and the first character at X. Text ends at its first NUL or
+** at DISPLAY_TEXT_MAX_LEN characters; characters the font has no glyph
+** for are left out. Glyphs are blended into what is already drawn.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint16                  Font;      /**< \brief Image slot holding the font */
+    int16                   X;
+    int16                   Y;
+    uint16                  Spare;
+    DISPLAY_Color_t         Color;
+    char                    Text[DISPLAY_TEXT_MAX_LEN];
+} DISPLAY_TextCmd_t;
+
 
 /*************************************************************************/
 /*
 ** Type definition (DISPLAY App housekeeping)
 */
 
+typedef struct
+{
+    uint32 Size;      /**< \brief Bytes reserved for the pool */
+    uint32 Used;      /**< \brief Bytes currently allocated */
+    uint32 HighWater; /**< \brief Largest Used since startup */
+    uint32 Failures;  /**< \brief Allocations refused for lack of space */
+} DISPLAY_PoolStats_t;
+
 typedef struct
 {
     uint8 CommandErrorCounter;
     uint8 CommandCounter;
-    uint8 spare[2];
+    uint8 FbMapped;         /**< \brief 1 while the framebuffer device is mapped */
+    uint8 FbMapCounter;     /**< \brief Successful device (re)maps, wraps at 255 */
+
+    DISPLAY_PoolStats_t Pools[DISPLAY_POOL_COUNT]; /**< \brief Indexed by DISPLAY_POOL_* */
+
+    uint32 RecordMessages; /**< \brief Messages logged since recording started */
+    uint32 RecordBytes;    /**< \brief Log file size, including entries not yet written */
+    uint8  Recording;      /**< \brief 1 while the recorder is active */
+    uint8  AnimActive;     /**< \brief Animations defined */
+    uint8  Spare[2];
+    uint32 AnimRedraws;    /**< \brief Animation frames that changed the screen */
+    uint32 GlyphHits;      /**< \brief Glyphs drawn from the glyph cache */
+    uint32 GlyphMisses;    /**< \brief Glyphs expanded from their font */
+    uint16 GlyphCached;    /**< \brief Glyphs in the cache now */
+    uint8  GlyphHitPct;    /**< \brief Hits per hundred glyphs drawn since the last housekeeping */
+    uint8  PipeCongested;  /**< \brief Command pipe backed up, see DISPLAY_FlowTlm_t */
+    uint32 FramesDropped;  /**< \brief Frames not presented while the pipe was congested */
+    uint32 DrawsCoalesced; /**< \brief Draws covered by later ones while frames were skipped, so never drawn */
+    uint32 JobsDone;       /**< \brief Long operations, such as image conversions, finished */
+    uint16 JobMaxPassUs;   /**< \brief Longest main loop pass of job work since the last housekeeping */
+    uint8  JobsPending;    /**< \brief Long operations under way */
+    uint8  Spare2;
 } DISPLAY_HkTlm_Payload_t;
 
 typedef struct
@@ -105,4 +579,266 @@ typedef struct
     DISPLAY_HkTlm_Payload_t Payload;   /**< \brief Telemetry payload */
 } DISPLAY_HkTlm_t;
 
+/*
+** Type definition (image slot listing, sent in response to DISPLAY_IMAGE_LIST_CC)
+*/
+#define DISPLAY_IMAGE_SLOT_FREE    0
+#define DISPLAY_IMAGE_SLOT_LOADING 1
+#define DISPLAY_IMAGE_SLOT_READY   2
+
+typedef struct
+{
+    char   Name[DISPLAY_IMAGE_NAME_LEN];
+    uint16 Width;
+    uint16 Height;
+    uint32 Size;  /**< \brief Bytes held in the image arena */
+    uint8  State;  /**< \brief One of DISPLAY_IMAGE_SLOT_* */
+    uint8  Format; /**< \brief DISPLAY_IMAGE_FORMAT_FONT, or RGB565 for any image */
+    uint8  Spare[2];
+} DISPLAY_ImageSlotInfo_t;
+
+typedef struct
+{
+    uint32                  ArenaSize;
+    uint32                  ArenaUsed;
+    DISPLAY_ImageSlotInfo_t Slots[DISPLAY_MAX_IMAGE_SLOTS];
+} DISPLAY_ImageListTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t      TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_ImageListTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} DISPLAY_ImageListTlm_t;
+
+/*
+** Type definition (segmented transfer status, sent in response to
+** DISPLAY_XFER_STATUS_CC and on every commit attempt)
+*/
+#define DISPLAY_XFER_STATE_IDLE   0
+#define DISPLAY_XFER_STATE_ACTIVE 1
+
+typedef struct
+{
+    uint16 TransferId;
+    uint8  State;     /**< \brief One of DISPLAY_XFER_STATE_* */
+    uint8  Spare;
+    uint16 Slot;
+    uint16 NumChunks;
+    uint16 ChunksReceived;
+    uint16 FirstMissing;       /**< \brief Lowest sequence not yet received, NumChunks when none */
+    uint16 DuplicateChunks;    /**< \brief Chunks received again and ignored */
+    uint16 RejectedChunks;     /**< \brief Chunks with a bad id, sequence, offset or length */
+    uint32 TotalSize;
+    uint8  Received[DISPLAY_XFER_MAX_CHUNKS / 8]; /**< \brief Bit per sequence, LSB first */
+} DISPLAY_XferStatusTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t       TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_XferStatusTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} DISPLAY_XferStatusTlm_t;
+
+/*
+** Type definition (client listing, sent in response to DISPLAY_CLIENT_LIST_CC)
+*/
+typedef struct
+{
+    uint32 DrawMid;  /**< \brief 0 for an unused entry */
+    uint16 X;
+    uint16 Y;
+    uint16 Width;
+    uint16 Height;
+    uint8  Layer;
+    uint8  Spare[3];
+    uint32 Draws;    /**< \brief Draw messages serviced */
+    uint32 Pixels;   /**< \brief Pixels written by those draws */
+    uint32 Rejected; /**< \brief Messages that were not draw commands or failed */
+    uint32 Deferred; /**< \brief Ticks on which the client ran out of budget */
+} DISPLAY_ClientInfo_t;
+
+typedef struct
+{
+    DISPLAY_ClientInfo_t Clients[DISPLAY_MAX_CLIENTS];
+} DISPLAY_ClientListTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t       TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_ClientListTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} DISPLAY_ClientListTlm_t;
+
+/*
+** Type definition (flush performance, sent with housekeeping)
+*/
+typedef struct
+{
+    uint16 X;
+    uint16 Y;
+    uint16 W;
+    uint16 H;
+} DISPLAY_TlmRect_t;
+
+typedef struct
+{
+    uint32            OverheadNs;     /**< \brief Per-copy cost in use */
+    uint32            PerBytePs;      /**< \brief Per-byte cost in use, picoseconds */
+    uint32            CalOverheadNs;  /**< \brief Per-copy cost measured when the device was configured */
+    uint32            CalPerBytePs;   /**< \brief Per-byte cost measured when the device was configured */
+    uint32            Flushes;
+    uint32            DamageRects;    /**< \brief Damaged areas recorded, all flushes */
+    uint32            Copies;         /**< \brief Device copies after merging, all flushes */
+    uint32            BytesCopied;
+    uint32            LastEstimateNs; /**< \brief Modelled cost of the last flush */
+    uint32            LastActualNs;   /**< \brief Measured time of the last flush */
+    uint32            IdleFlushes;    /**< \brief Flushes skipped with nothing to present */
+    uint32            ActiveMs;       /**< \brief Time spent presenting changes since the device was configured */
+    uint32            IdleMs;         /**< \brief Time spent with nothing to present, blanked or not */
+    uint32            Blanks;         /**< \brief Times the panel was blanked for idleness */
+    uint32            CalScalarKBps;  /**< \brief Full-frame copy rate with ordinary stores, 1000 bytes/s */
+    uint32            CalStreamKBps;  /**< \brief Same with non-temporal stores, 0 if the CPU has none */
+    uint32            BandedJobs;     /**< \brief Draws and copies split into bands across the worker pool */
+    uint32            DrawsCulled;    /**< \brief Draws never drawn, as later draws in the same frame covered them */
+    uint32            DrawsClipped;   /**< \brief Draws drawn only in part for the same reason */
+    uint32            PixelsSkipped;  /**< \brief Pixels the culled and clipped draws did not write */
+    uint32            RefreshUs;      /**< \brief Panel refresh period flushes are timed to, 0 if unknown */
+    uint32            LatePresents;   /**< \brief Flushes whose copy ran on past the refresh it was timed to */
+    uint32            LastJitterUs;   /**< \brief Start of the last copy away from the refresh as predicted */
+    uint32            MaxJitterUs;    /**< \brief Largest LastJitterUs since the last housekeeping */
+    uint8             LastCount;      /**< \brief Copies in the last flush */
+    uint8             Blanked;        /**< \brief 1 while the panel is blanked */
+    uint8             PresentPath;    /**< \brief DISPLAY_PRESENT_PATH_x chosen by the calibration */
+    uint8             Workers;        /**< \brief Child tasks in the band worker pool */
+    uint8             PacePath;       /**< \brief DISPLAY_PACE_x in use */
+    uint8             Spare;
+    DISPLAY_TlmRect_t LastPlan[DISPLAY_DAMAGE_MAX_RECTS]; /**< \brief Copies of the last flush, frame coordinates */
+} DISPLAY_PerfTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_PerfTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} DISPLAY_PerfTlm_t;
+
+/*
+** Type definition (displayed content checksum, sent in response to
+** DISPLAY_CRC_CC)
+**
+** Every DISPLAY_CRC_TILE square tile of the frame has a CRC of its pixels,
+** taken row by row in device pixel format before rotation. Crc is the CRC
+** of the CRCs, each as a uint16 in host order, of the tiles the requested
+** rectangle touches, in row order. Area is that rectangle widened to whole
+** tiles. All CRCs are CFE_MISSION_ES_DEFAULT_CRC.
+*/
+typedef struct
+{
+    DISPLAY_TlmRect_t Area;    /**< \brief Frame area covered */
+    uint16            Crc;
+    uint16            Tiles;   /**< \brief Tiles combined */
+    uint32            Flushes; /**< \brief Flush count when taken; identifies the frame */
+} DISPLAY_CrcTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_CrcTlm_Payload_t  Payload;   /**< \brief Telemetry payload */
+} DISPLAY_CrcTlm_t;
+
+/*
+** Type definition (draw acknowledgement)
+**
+** Sent after each flush that presented sequenced draws, one packet per
+** sender: ground commands under DISPLAY_CMD_MID, clients under their
+** DrawMid. Draws a client made through display_lib are numbered apart from
+** those on its pipe and come under DrawMid | DISPLAY_ACK_SOURCE_LIB.
+** Sequence is the newest sequence presented, compared with wraparound, so
+** every draw from Source up to it is on the panel. Latencies run from the
+** draw's sent time to the end of the flush.
+*/
+
+typedef struct
+{
+    uint32 Source;       /**< \brief MID the draws came in on, see DISPLAY_ACK_SOURCE_LIB */
+    uint32 Sequence;     /**< \brief Newest sequence presented */
+    uint32 Draws;        /**< \brief Sequenced draws from Source in this flush */
+    uint32 LatencyUs;    /**< \brief Sent to presented, for Sequence */
+    uint32 MaxLatencyUs; /**< \brief Longest of the Draws */
+    uint32 Flushes;      /**< \brief Flush count after presenting; identifies the frame */
+} DISPLAY_AckTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_AckTlm_Payload_t  Payload;   /**< \brief Telemetry payload */
+} DISPLAY_AckTlm_t;
+
+/*
+** Type definition (command pipe flow)
+**
+** Sent when the command pipe becomes congested and again when it drains.
+** Producers feeding the pipe should slow down while Congested is set.
+** While congested, frames are presented less often and queued draws that
+** later draws cover are never drawn.
+*/
+typedef struct
+{
+    uint8  Congested;      /**< \brief 1 while the command pipe is backed up */
+    uint8  Spare;
+    uint16 Backlog;        /**< \brief Most messages found queued back to back in this spell */
+    uint32 Congestions;    /**< \brief Times the pipe has become congested */
+    uint32 FramesDropped;  /**< \brief Frames not presented while congested */
+    uint32 DrawsCoalesced; /**< \brief Draws never drawn because frames were skipped and later draws covered them */
+} DISPLAY_FlowTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_FlowTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} DISPLAY_FlowTlm_t;
+
+/*
+** Type definition (screenshot stream)
+**
+** Data holds TileCount records, each a DISPLAY_ShotTileHeader_t followed
+** by Length bytes. Tile numbers count DISPLAY_CRC_TILE squares in row
+** order across a Width x Height frame in logical (unrotated) orientation;
+** edge tiles are cut to the frame. Pixels are BytesPerPixel bytes in host
+** order with the given channel layout. RLE data is a sequence of control
+** bytes: C < 128 is followed by C + 1 literal pixels, C >= 128 by one pixel
+** repeated C - 126 times. Packets are only as long as the data they carry.
+*/
+typedef struct
+{
+    uint16 Tile;
+    uint8  Encoding; /**< \brief One of DISPLAY_SHOT_ENCODING_* */
+    uint8  Spare;
+    uint16 Length;   /**< \brief Encoded bytes that follow */
+} DISPLAY_ShotTileHeader_t;
+
+typedef struct
+{
+    uint16 CaptureId;
+    uint16 Sequence;   /**< \brief Packet number within the capture, from 0 */
+    uint16 Width;
+    uint16 Height;
+    uint16 Tiles;      /**< \brief Tiles in the whole capture */
+    uint16 TileCount;  /**< \brief Tile records in this packet */
+    uint16 DataLength; /**< \brief Bytes of Data used */
+    uint8  Flags;      /**< \brief DISPLAY_SHOT_FLAG_* */
+    uint8  BytesPerPixel;
+    uint8  RedOffset;
+    uint8  RedLength;
+    uint8  GreenOffset;
+    uint8  GreenLength;
+    uint8  BlueOffset;
+    uint8  BlueLength;
+    uint8  Spare[2];
+    uint8  Data[DISPLAY_SHOT_DATA_BYTES];
+} DISPLAY_ShotTlm_Payload_t;
+
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    DISPLAY_ShotTlm_Payload_t Payload;   /**< \brief Telemetry payload */
+} DISPLAY_ShotTlm_t;
+
 #endif /* DISPLAY_MSG_H */
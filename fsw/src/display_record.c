@@ -0,0 +1,202 @@
+#include "display_record.h"
+#include "display_arena.h"
+#include "display_msg.h"
+#include "cfe_msg.h"
+#include "cfe_time.h"
+#include "osapi.h"
+
+#include <string.h>
+
+/*
+** Command recorder. Every handled message is appended to a log file with
+** the time it was handled, so a slow frame seen in operation can be
+** replayed on the ground with exactly the same input. Entries collect in
+** a buffer from the ring pool and reach the file in blocks, on the
+** housekeeping cycle and when recording stops.
+*/
+typedef struct
+{
+    bool      Active;
+    osal_id_t Fd;
+    uint8    *Buffer;
+    uint32    Fill;
+    uint32    Messages;
+    uint32    Bytes;
+} DISPLAY_Record_t;
+
+static DISPLAY_Record_t Rec;
+
+CFE_Status_t DISPLAY_RecordInit(void)
+{
+    memset(&Rec, 0, sizeof(Rec));
+
+    Rec.Buffer = DISPLAY_ArenaAlloc(DISPLAY_POOL_RING, DISPLAY_RECORD_BUFFER_SIZE, DISPLAY_ARENA_ALIGN);
+    if (Rec.Buffer == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    return CFE_SUCCESS;
+}
+
+static CFE_Status_t DISPLAY_RecordWrite(const void *Data, uint32 Size)
+{
+    if (OS_write(Rec.Fd, Data, Size) != (int32)Size)
+    {
+        return DISPLAY_STATUS_ERROR_WRITE;
+    }
+
+    Rec.Bytes += Size;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Open Path, replacing any existing file, and start logging. A recording
+** already in progress is closed first.
+*/
+CFE_Status_t DISPLAY_RecordStart(const char *Path)
+{
+    DISPLAY_RecordFileHeader_t Header;
+    CFE_Status_t               status;
+
+    if (Rec.Buffer == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    DISPLAY_RecordStop();
+
+    if (OS_OpenCreate(&Rec.Fd, Path, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY) != OS_SUCCESS)
+    {
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    Rec.Active   = true;
+    Rec.Fill     = 0;
+    Rec.Messages = 0;
+    Rec.Bytes    = 0;
+
+    Header.Magic     = DISPLAY_RECORD_MAGIC;
+    Header.Version   = DISPLAY_RECORD_VERSION;
+    Header.EntrySize = sizeof(DISPLAY_RecordEntry_t);
+
+    status = DISPLAY_RecordWrite(&Header, sizeof(Header));
+    if (status != CFE_SUCCESS)
+    {
+        DISPLAY_RecordStop();
+    }
+
+    return status;
+}
+
+/*
+** Write out staged entries. On a write error the recording is closed.
+*/
+CFE_Status_t DISPLAY_RecordFlush(void)
+{
+    CFE_Status_t status = CFE_SUCCESS;
+
+    if (Rec.Active && Rec.Fill > 0)
+    {
+        status   = DISPLAY_RecordWrite(Rec.Buffer, Rec.Fill);
+        Rec.Fill = 0;
+
+        if (status != CFE_SUCCESS)
+        {
+            Rec.Active = false;
+            OS_close(Rec.Fd);
+        }
+    }
+
+    return status;
+}
+
+CFE_Status_t DISPLAY_RecordStop(void)
+{
+    CFE_Status_t status;
+
+    if (!Rec.Active)
+    {
+        return CFE_SUCCESS;
+    }
+
+    status = DISPLAY_RecordFlush();
+    if (Rec.Active)
+    {
+        Rec.Active = false;
+        OS_close(Rec.Fd);
+    }
+
+    return status;
+}
+
+/*
+** Append one message to the log. Does nothing while not recording.
+*/
+CFE_Status_t DISPLAY_RecordMessage(uint8 Source, const CFE_SB_Buffer_t *SBBufPtr)
+{
+    DISPLAY_RecordEntry_t Entry;
+    CFE_TIME_SysTime_t    Now;
+    CFE_MSG_Size_t        Size = 0;
+    CFE_Status_t          status;
+
+    if (!Rec.Active)
+    {
+        return CFE_SUCCESS;
+    }
+
+    CFE_MSG_GetSize(&SBBufPtr->Msg, &Size);
+    Now = CFE_TIME_GetTime();
+
+    Entry.Seconds    = Now.Seconds;
+    Entry.Subseconds = Now.Subseconds;
+    Entry.Length     = (uint16)Size;
+    Entry.Source     = Source;
+    Entry.Spare      = 0;
+
+    if (Rec.Fill + sizeof(Entry) + Size > DISPLAY_RECORD_BUFFER_SIZE)
+    {
+        status = DISPLAY_RecordFlush();
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    Rec.Messages++;
+
+    /* Messages too big to stage go straight to the file */
+    if (sizeof(Entry) + Size > DISPLAY_RECORD_BUFFER_SIZE)
+    {
+        status = DISPLAY_RecordWrite(&Entry, sizeof(Entry));
+        if (status == CFE_SUCCESS)
+        {
+            status = DISPLAY_RecordWrite(SBBufPtr, Size);
+        }
+        if (status != CFE_SUCCESS)
+        {
+            Rec.Active = false;
+            OS_close(Rec.Fd);
+        }
+
+        return status;
+    }
+
+    memcpy(Rec.Buffer + Rec.Fill, &Entry, sizeof(Entry));
+    memcpy(Rec.Buffer + Rec.Fill + sizeof(Entry), SBBufPtr, Size);
+    Rec.Fill += sizeof(Entry) + Size;
+
+    return CFE_SUCCESS;
+}
+
+bool DISPLAY_RecordIsActive(void)
+{
+    return Rec.Active;
+}
+
+void DISPLAY_RecordGetStats(uint32 *Messages, uint32 *Bytes)
+{
+    *Messages = Rec.Messages;
+    *Bytes    = Rec.Bytes + Rec.Fill;
+}
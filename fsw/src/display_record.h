@@ -0,0 +1,50 @@
+#ifndef DISPLAY_RECORD__H_
+#define DISPLAY_RECORD__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "cfe_sb.h"
+
+/*
+** Command log file layout, host byte order:
+**
+**   DISPLAY_RecordFileHeader_t
+**   { DISPLAY_RecordEntry_t, Length bytes of message } ...
+**
+** Messages are the complete software bus packets as received, headers
+** included.
+*/
+#define DISPLAY_RECORD_MAGIC   0x43455244 /* "DREC" read as little endian */
+#define DISPLAY_RECORD_VERSION 1
+
+#define DISPLAY_RECORD_SOURCE_CMD    0 /* Command pipe, through DISPLAY_ProcessCommandPacket */
+#define DISPLAY_RECORD_SOURCE_CLIENT 1 /* A client draw pipe, serviced on the frame tick */
+
+/* Entries are staged here and written out in blocks */
+#define DISPLAY_RECORD_BUFFER_SIZE 4096
+
+typedef struct
+{
+    uint32 Magic;
+    uint16 Version;
+    uint16 EntrySize; /* sizeof(DISPLAY_RecordEntry_t) */
+} DISPLAY_RecordFileHeader_t;
+
+typedef struct
+{
+    uint32 Seconds;    /* cFE time the message was handled */
+    uint32 Subseconds;
+    uint16 Length;     /* Message bytes that follow */
+    uint8  Source;     /* DISPLAY_RECORD_SOURCE_* */
+    uint8  Spare;
+} DISPLAY_RecordEntry_t;
+
+CFE_Status_t DISPLAY_RecordInit(void);
+CFE_Status_t DISPLAY_RecordStart(const char *Path);
+CFE_Status_t DISPLAY_RecordStop(void);
+CFE_Status_t DISPLAY_RecordMessage(uint8 Source, const CFE_SB_Buffer_t *SBBufPtr);
+CFE_Status_t DISPLAY_RecordFlush(void);
+bool         DISPLAY_RecordIsActive(void);
+void         DISPLAY_RecordGetStats(uint32 *Messages, uint32 *Bytes);
+
+#endif // DISPLAY_RECORD__H_
@@ -0,0 +1,1069 @@
+#include "display_render.h"
+#include "display_arena.h"
+#include "display_band.h"
+#include "display_crc.h"
+#include "display_damage.h"
+#include "display_dither.h"
+#include "display_fb.h"
+#include "display_msg.h"
+#include "display_perfids.h"
+#include "display_shot.h"
+#include "display_stream.h"
+#include "cfe_es.h"
+#include "cfe_time.h"
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+/*
+** Drawing targets one of several layers, each a full frame in logical
+** (unrotated) coordinates. Every draw records the area it changed in one
+** damage list shared by all layers. On flush the list is merged into a
+** set of copies using a cost model of the device, and for each copy the
+** layers are composited bottom to top into Back and the result copied to
+** the device with rotation applied.
+**
+** Target is the part of the selected layer that draws currently land in:
+** all of it, or a client viewport. It shares the layer's pixels and
+** stride, so clipping to Target clips to the viewport for free.
+**
+** A flush with no damage presents nothing. The display counts as idle
+** from the first such flush until something is presented again, and once
+** it has been idle for the table's timeout the panel is blanked; the next
+** flush with damage unblanks it before presenting.
+**
+** Draws are not drawn when they are made but queued, and the queue is
+** drawn at the start of the next flush (or when it fills, or before the
+** layers are reconfigured). Every draw sets every pixel of its rectangle
+** on its layer, so before drawing each queued draw is cut down to the
+** parts that no later draw on the same layer covers: a frame that clears
+** the screen and then paints panels over it writes each pixel once. Draws
+** are still damaged and charged to the pixel count when they are made.
+** A queued blit reads its image when the queue is drawn; image slots only
+** change under ground commands other than draws, and the queue is drawn
+** before each of those runs.
+** Text is the exception: its glyphs are blended over what is already
+** there, so a glyph hides nothing and is drawn wherever no later draw
+** covers it. A queued glyph reads its coverage from the glyph cache,
+** which draws the queue before it reuses a cell (display_font.c).
+**
+** Large draws and the composite and copy of large damaged areas are cut
+** into bands of rows and shared with the worker pool (display_band.c).
+** A band is drawn as the part of the whole draw inside its rows, so it
+** draws exactly what the whole draw would have drawn there.
+*/
+typedef struct
+{
+    DISPLAY_Surface_t Surface;
+    uint8             Z;
+    bool              Visible;
+    bool              KeyEnabled;
+    DISPLAY_Color_t   KeyColor;
+    uint32            Key; /* KeyColor packed for Surface */
+} DISPLAY_Layer_t;
+
+typedef struct
+{
+    DISPLAY_Surface_t         Back; /* Composited frame, as sent to the device */
+    DISPLAY_Layer_t           Layers[DISPLAY_MAX_LAYERS];
+    uint8                     Order[DISPLAY_MAX_LAYERS]; /* Layer numbers, bottom first */
+    uint8                     Layer;                     /* Layer that draws go to */
+    DISPLAY_Surface_t         Target;
+    int32                     TargetX;
+    int32                     TargetY;
+    uint32                    PixelCount;
+    uint8                     Rotation;
+    uint32                    FbGeneration;
+    DISPLAY_DamageList_t      Damage;
+    DISPLAY_CostModel_t       Model;    /* In use: table values, or calibrated where they are zero */
+    DISPLAY_CostModel_t       TblModel; /* As last read from the table */
+    DISPLAY_PerfTlm_Payload_t Perf;
+    uint32                    IdleBlankMs;
+    uint64                    ConfiguredMs; /* cFE time of the first configuration, 0 before */
+    uint64                    IdleSinceMs;  /* Start of the current idle spell */
+    uint64                    IdleTotalMs;  /* Length of finished idle spells */
+    bool                      Idle;
+    bool                      BlankTried;   /* Blanking attempted in this idle spell */
+    uint32                    TblRefreshUs; /* As last read from the table */
+    uint64                    RefreshNs;    /* Start of the refresh last flushed to, 0 before the first */
+} DISPLAY_Render_t;
+
+/*
+** A queued draw, as shared with the workers drawing its bands
+*/
+typedef struct
+{
+    DISPLAY_BandFunc_t Func;
+    uint8              Layer;
+    DISPLAY_Surface_t  Target; /* Render.Target when the draw was made */
+    int32              TargetX;
+    int32              TargetY;
+    DISPLAY_Rect_t     Rect; /* As requested, in target coordinates */
+    DISPLAY_Rect_t     Area; /* Rect clipped to the target, in layer coordinates */
+    DISPLAY_Rect_t     Part; /* Piece being drawn, in target coordinates */
+    uint32             Pixel;
+    DISPLAY_Color_t    From;
+    DISPLAY_Color_t    To;
+    bool               Vertical;
+    bool               Blends; /* Does not set every pixel of Rect */
+    const uint8       *Src;    /* RGB565, or coverage for a glyph, Rect.W by Rect.H */
+} DISPLAY_RenderDraw_t;
+
+/* Draws held back for culling, and the pieces one may be cut into */
+#define DISPLAY_RENDER_QUEUE_DEPTH 32
+#define DISPLAY_RENDER_MAX_PARTS   8
+
+static DISPLAY_Render_t     Render;
+static DISPLAY_RenderDraw_t RenderQueue[DISPLAY_RENDER_QUEUE_DEPTH];
+static uint32               RenderQueued;
+
+/* Repetitions of the small and whole frame copies timed by the calibration */
+#define DISPLAY_RENDER_CAL_SMALL 64
+#define DISPLAY_RENDER_CAL_LARGE 4
+
+/*
+** Rebuild the bottom to top order after a Z change. Equal Z keeps layer
+** number order.
+*/
+static void DISPLAY_RenderSortLayers(void)
+{
+    uint8 Tmp;
+    int   i, j;
+
+    for (i = 0; i < DISPLAY_MAX_LAYERS; i++)
+    {
+        Render.Order[i] = (uint8)i;
+    }
+
+    for (i = 1; i < DISPLAY_MAX_LAYERS; i++)
+    {
+        for (j = i; j > 0 && Render.Layers[Render.Order[j - 1]].Z > Render.Layers[Render.Order[j]].Z; j--)
+        {
+            Tmp                 = Render.Order[j];
+            Render.Order[j]     = Render.Order[j - 1];
+            Render.Order[j - 1] = Tmp;
+        }
+    }
+}
+
+/*
+** Mark the whole frame for recompositing
+*/
+static void DISPLAY_RenderDamageAll(void)
+{
+    DISPLAY_Rect_t Full = {0, 0, (int32)Render.Back.Width, (int32)Render.Back.Height};
+
+    DISPLAY_DamageClear(&Render.Damage);
+    DISPLAY_DamageAdd(&Render.Damage, &Full, &Render.Model, Render.Back.Format.BytesPerPixel);
+}
+
+static uint64 DISPLAY_RenderNowNs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64)Now.tv_sec * 1000000000u) + (uint64)Now.tv_nsec;
+}
+
+static uint64 DISPLAY_RenderNowMs(void)
+{
+    CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+
+    return ((uint64)Now.Seconds * 1000) + (((uint64)Now.Subseconds * 1000) >> 32);
+}
+
+/*
+** A flush found nothing to present: start or continue an idle spell and
+** blank the panel once it has lasted the timeout
+*/
+static void DISPLAY_RenderIdle(uint64 NowMs)
+{
+    Render.Perf.IdleFlushes++;
+
+    if (!Render.Idle)
+    {
+        Render.Idle        = true;
+        Render.IdleSinceMs = NowMs;
+    }
+
+    if (Render.IdleBlankMs != 0 && !Render.BlankTried && NowMs >= Render.IdleSinceMs + Render.IdleBlankMs)
+    {
+        Render.BlankTried = true;
+        if (DISPLAY_FbBlank(true) == CFE_SUCCESS)
+        {
+            Render.Perf.Blanked = 1;
+            Render.Perf.Blanks++;
+        }
+    }
+}
+
+/*
+** Something is about to be presented: end any idle spell and unblank
+*/
+static void DISPLAY_RenderWake(uint64 NowMs)
+{
+    if (Render.Idle)
+    {
+        Render.IdleTotalMs += (NowMs > Render.IdleSinceMs) ? NowMs - Render.IdleSinceMs : 0;
+        Render.Idle = false;
+    }
+
+    if (Render.Perf.Blanked)
+    {
+        DISPLAY_FbBlank(false);
+        Render.Perf.Blanked = 0;
+    }
+
+    Render.BlankTried = false;
+}
+
+/*
+** Cost model in use: values set in the table win over the calibration
+*/
+static void DISPLAY_RenderUpdateModel(void)
+{
+    Render.Model.OverheadNs = Render.TblModel.OverheadNs;
+    if (Render.Model.OverheadNs == 0)
+    {
+        Render.Model.OverheadNs = Render.Perf.CalOverheadNs;
+    }
+
+    Render.Model.PerBytePs = Render.TblModel.PerBytePs;
+    if (Render.Model.PerBytePs == 0)
+    {
+        Render.Model.PerBytePs = Render.Perf.CalPerBytePs;
+    }
+
+    Render.Perf.OverheadNs = Render.Model.OverheadNs;
+    Render.Perf.PerBytePs  = Render.Model.PerBytePs;
+}
+
+/*
+** Refresh timing in use: the driver's vertical blank and period where it
+** has them, otherwise the table's period
+*/
+static void DISPLAY_RenderUpdatePace(void)
+{
+    const DISPLAY_FbInfo_t *FbInfo = DISPLAY_FbGetInfo();
+
+    Render.Perf.RefreshUs = (FbInfo->RefreshUs != 0) ? FbInfo->RefreshUs : Render.TblRefreshUs;
+
+    if (FbInfo->Vsync)
+    {
+        Render.Perf.PacePath = DISPLAY_PACE_VSYNC;
+    }
+    else if (Render.Perf.RefreshUs != 0)
+    {
+        Render.Perf.PacePath = DISPLAY_PACE_TIMER;
+    }
+    else
+    {
+        Render.Perf.PacePath = DISPLAY_PACE_NONE;
+    }
+}
+
+/*
+** Hold a flush for the start of the panel's next refresh, so the copy
+** goes out in the blanking interval rather than across the lines being
+** scanned out, and return when that refresh started as best known. Only
+** frame ticks wait; see DISPLAY_RenderFlush.
+**
+** With the driver's vertical blank, jitter is how far the wakeup lands
+** from the phase of the refreshes before it; with the timer, how late the
+** wakeup is for the refresh estimated from the last one and the period.
+*/
+static uint64 DISPLAY_RenderPace(void)
+{
+    uint64          PeriodNs = (uint64)Render.Perf.RefreshUs * 1000;
+    uint64          Now      = DISPLAY_RenderNowNs();
+    uint64          Due      = Now;
+    uint64          Jitter   = 0;
+    uint64          Phase;
+    bool            Vsync;
+    struct timespec Until;
+
+    if (PeriodNs != 0 && Render.RefreshNs != 0)
+    {
+        Due = Render.RefreshNs + (((Now - Render.RefreshNs) + PeriodNs - 1) / PeriodNs) * PeriodNs;
+    }
+
+    Vsync = (Render.Perf.PacePath == DISPLAY_PACE_VSYNC && DISPLAY_FbWaitVsync() == CFE_SUCCESS);
+    if (Render.Perf.PacePath == DISPLAY_PACE_VSYNC && !Vsync)
+    {
+        /* A driver with no vertical blank is found out on the first wait */
+        DISPLAY_RenderUpdatePace();
+    }
+
+    if (Vsync)
+    {
+        Now = DISPLAY_RenderNowNs();
+        if (PeriodNs != 0 && Render.RefreshNs != 0)
+        {
+            Phase  = (Now - Render.RefreshNs) % PeriodNs;
+            Jitter = (Phase < PeriodNs - Phase) ? Phase : PeriodNs - Phase;
+        }
+        Render.RefreshNs = Now;
+    }
+    else if (PeriodNs != 0)
+    {
+        Until.tv_sec  = (time_t)(Due / 1000000000u);
+        Until.tv_nsec = (long)(Due % 1000000000u);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Until, NULL) == EINTR)
+        {
+        }
+
+        Now              = DISPLAY_RenderNowNs();
+        Jitter           = (Now > Due) ? Now - Due : 0;
+        Render.RefreshNs = Due;
+    }
+    else
+    {
+        return Now;
+    }
+
+    Render.Perf.LastJitterUs = (uint32)(Jitter / 1000);
+    if (Render.Perf.LastJitterUs > Render.Perf.MaxJitterUs)
+    {
+        Render.Perf.MaxJitterUs = Render.Perf.LastJitterUs;
+    }
+
+    return Render.RefreshNs;
+}
+
+/*
+** Average time of one device copy of Rect
+*/
+static uint64 DISPLAY_RenderTimePresent(const DISPLAY_Rect_t *Rect, int Count)
+{
+    uint64 Start = DISPLAY_RenderNowNs();
+    int    i;
+
+    for (i = 0; i < Count; i++)
+    {
+        DISPLAY_FbPresent(&Render.Back, Rect, Render.Rotation);
+    }
+
+    return (DISPLAY_RenderNowNs() - Start) / Count;
+}
+
+static uint32 DISPLAY_RenderKBps(uint64 Bytes, uint64 Ns)
+{
+    uint64 KBps = (Bytes * 1000000) / ((Ns > 0) ? Ns : 1);
+
+    return (KBps > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32)KBps;
+}
+
+/*
+** Time device copies of one pixel and of the whole frame and fit the cost
+** model to them. The whole frame is timed with ordinary stores and with
+** the CPU's non-temporal stores, if it has any, and the faster is kept for
+** presenting. Run right after the frame was copied out, so the copies
+** rewrite what the device already shows.
+*/
+static void DISPLAY_RenderCalibrate(void)
+{
+    DISPLAY_Rect_t Pixel  = {0, 0, 1, 1};
+    DISPLAY_Rect_t Full   = {0, 0, (int32)Render.Back.Width, (int32)Render.Back.Height};
+    uint8          Stream = DISPLAY_StreamDetect();
+    uint64         Small, Large, StreamNs, Bytes;
+
+    Bytes = (uint64)Full.W * (uint64)Full.H * Render.Back.Format.BytesPerPixel;
+
+    DISPLAY_StreamSelect(DISPLAY_PRESENT_PATH_SCALAR);
+    Large                     = DISPLAY_RenderTimePresent(&Full, DISPLAY_RENDER_CAL_LARGE);
+    Render.Perf.CalScalarKBps = DISPLAY_RenderKBps(Bytes, Large);
+    Render.Perf.CalStreamKBps = 0;
+
+    if (Stream != DISPLAY_PRESENT_PATH_SCALAR)
+    {
+        DISPLAY_StreamSelect(Stream);
+        StreamNs                  = DISPLAY_RenderTimePresent(&Full, DISPLAY_RENDER_CAL_LARGE);
+        Render.Perf.CalStreamKBps = DISPLAY_RenderKBps(Bytes, StreamNs);
+
+        if (StreamNs < Large)
+        {
+            Large = StreamNs;
+        }
+        else
+        {
+            DISPLAY_StreamSelect(DISPLAY_PRESENT_PATH_SCALAR);
+        }
+    }
+    Render.Perf.PresentPath = DISPLAY_StreamGetPath();
+
+    Small = DISPLAY_RenderTimePresent(&Pixel, DISPLAY_RENDER_CAL_SMALL);
+
+    Render.Perf.CalOverheadNs = (Small > 0) ? (uint32)Small : 1;
+    Render.Perf.CalPerBytePs  = (Large > Small) ? (uint32)(((Large - Small) * 1000) / Bytes) : 1;
+
+    DISPLAY_RenderUpdateModel();
+}
+
+/*
+** Default layer stack: the background layer is opaque and every layer
+** above it treats black as transparent, so an empty overlay shows what is
+** underneath.
+*/
+void DISPLAY_RenderInit(void)
+{
+    int i;
+
+    memset(&Render, 0, sizeof(Render));
+    RenderQueued = 0;
+
+    for (i = 0; i < DISPLAY_MAX_LAYERS; i++)
+    {
+        Render.Layers[i].Z          = (uint8)i;
+        Render.Layers[i].Visible    = true;
+        Render.Layers[i].KeyEnabled = (i != DISPLAY_LAYER_BACKGROUND);
+    }
+
+    DISPLAY_RenderSortLayers();
+}
+
+/*
+** Match the layer and composite buffers to the mapped device and the table
+** rotation. The buffers survive a remap to the same geometry, so a device
+** that comes back is repainted from the last frame rather than starting
+** blank.
+*/
+CFE_Status_t DISPLAY_RenderConfigure(const DISPLAY_Table_t *TblPtr)
+{
+    const DISPLAY_FbInfo_t *FbInfo = DISPLAY_FbGetInfo();
+    DISPLAY_Layer_t        *L;
+    uint32                  Width, Height, Stride;
+    uint8                  *Pixels[DISPLAY_MAX_LAYERS + 1];
+    int                     i;
+
+    /* Queued draws are drawn with the colors and buffers they were made for */
+    DISPLAY_RenderSync();
+
+    Render.TblModel.OverheadNs = TblPtr->FlushOverheadNs;
+    Render.TblModel.PerBytePs  = TblPtr->FlushPerBytePs;
+    Render.IdleBlankMs         = TblPtr->IdleBlankMs;
+    Render.TblRefreshUs        = TblPtr->RefreshUs;
+    DISPLAY_RenderUpdateModel();
+    DISPLAY_RenderUpdatePace();
+    DISPLAY_DrawSetGamma(TblPtr->PanelGamma, TblPtr->Brightness);
+
+    if (!DISPLAY_FbIsMapped())
+    {
+        return CFE_SUCCESS;
+    }
+
+    if (FbInfo->Generation == Render.FbGeneration && TblPtr->Rotation == Render.Rotation)
+    {
+        return CFE_SUCCESS;
+    }
+
+    if (TblPtr->Rotation == DISPLAY_ROTATE_90 || TblPtr->Rotation == DISPLAY_ROTATE_270)
+    {
+        Width  = FbInfo->Height;
+        Height = FbInfo->Width;
+    }
+    else
+    {
+        Width  = FbInfo->Width;
+        Height = FbInfo->Height;
+    }
+    Stride = Width * FbInfo->BytesPerPixel;
+
+    if (Render.Back.Pixels == NULL || Render.Back.Width != Width || Render.Back.Height != Height ||
+        memcmp(&Render.Back.Format, &FbInfo->Format, sizeof(Render.Back.Format)) != 0)
+    {
+        /* The frame pool holds only what the current geometry needs */
+        DISPLAY_ArenaReset(DISPLAY_POOL_FRAME);
+        DISPLAY_CrcClose();
+        DISPLAY_ShotClose();
+        Render.Back.Pixels = NULL;
+        for (i = 0; i < DISPLAY_MAX_LAYERS; i++)
+        {
+            Render.Layers[i].Surface.Pixels = NULL;
+        }
+        DISPLAY_RenderSetTarget(Render.Layer, NULL);
+
+        for (i = 0; i < DISPLAY_MAX_LAYERS + 1; i++)
+        {
+            Pixels[i] = DISPLAY_ArenaAlloc(DISPLAY_POOL_FRAME, Stride * Height, DISPLAY_ARENA_ALIGN);
+            if (Pixels[i] == NULL)
+            {
+                DISPLAY_ArenaReset(DISPLAY_POOL_FRAME);
+                return DISPLAY_STATUS_ERROR_NOMEM;
+            }
+
+            memset(Pixels[i], 0, Stride * Height);
+        }
+
+        Render.Back.Pixels = Pixels[DISPLAY_MAX_LAYERS];
+        Render.Back.Width  = Width;
+        Render.Back.Height = Height;
+        Render.Back.Stride = Stride;
+        Render.Back.Format = FbInfo->Format;
+
+        if (DISPLAY_CrcConfigure(&Render.Back) != CFE_SUCCESS || DISPLAY_ShotConfigure(&Render.Back) != CFE_SUCCESS)
+        {
+            DISPLAY_ArenaReset(DISPLAY_POOL_FRAME);
+            Render.Back.Pixels = NULL;
+            return DISPLAY_STATUS_ERROR_NOMEM;
+        }
+
+        for (i = 0; i < DISPLAY_MAX_LAYERS; i++)
+        {
+            L                 = &Render.Layers[i];
+            L->Surface        = Render.Back;
+            L->Surface.Pixels = Pixels[i];
+            L->Key            = DISPLAY_DrawPackRaw(&L->Surface.Format, L->KeyColor);
+        }
+    }
+
+    Render.Rotation     = TblPtr->Rotation;
+    Render.FbGeneration = FbInfo->Generation;
+    Render.RefreshNs    = 0; /* A new device refreshes in its own phase */
+    DISPLAY_RenderSetTarget(Render.Layer, NULL);
+
+    if (Render.ConfiguredMs == 0)
+    {
+        Render.ConfiguredMs = DISPLAY_RenderNowMs();
+    }
+
+    /* The device was cleared by the (re)map; repaint all of it */
+    DISPLAY_RenderWake(DISPLAY_RenderNowMs());
+    DISPLAY_RenderDamageAll();
+    DISPLAY_RenderFlush(false);
+    DISPLAY_RenderCalibrate();
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_RenderClose(void)
+{
+    DISPLAY_ArenaReset(DISPLAY_POOL_FRAME);
+    DISPLAY_CrcClose();
+    DISPLAY_ShotClose();
+    DISPLAY_RenderInit();
+}
+
+bool DISPLAY_RenderIsReady(void)
+{
+    return (Render.Back.Pixels != NULL);
+}
+
+const DISPLAY_Surface_t *DISPLAY_RenderGetSurface(void)
+{
+    return &Render.Back;
+}
+
+/*
+** Change where a layer sits in the stack and how it blends. With the key
+** enabled, pixels equal to KeyColor let the layers below show through;
+** otherwise the layer hides everything below it. The key is packed
+** without color correction, so a gamma or brightness change leaves it
+** matching the pixels already cleared to it.
+*/
+CFE_Status_t DISPLAY_RenderSetLayer(uint8 Layer, uint8 Z, bool Visible, bool KeyEnabled, DISPLAY_Color_t KeyColor)
+{
+    DISPLAY_Layer_t *L;
+
+    if (Layer >= DISPLAY_MAX_LAYERS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    L             = &Render.Layers[Layer];
+    L->Z          = Z;
+    L->Visible    = Visible;
+    L->KeyEnabled = KeyEnabled;
+    L->KeyColor   = KeyColor;
+    L->Key        = DISPLAY_DrawPackRaw(&L->Surface.Format, KeyColor);
+
+    DISPLAY_RenderSortLayers();
+    DISPLAY_RenderDamageAll();
+
+    return CFE_SUCCESS;
+}
+
+uint8 DISPLAY_RenderGetLayer(void)
+{
+    return Render.Layer;
+}
+
+/*
+** Send following draws to Layer, inside Viewport when not NULL. Viewport
+** is given in frame coordinates and draw coordinates are then taken
+** relative to its top left corner. Viewport corners are never negative,
+** so clipping it to the frame does not move its origin.
+*/
+void DISPLAY_RenderSetTarget(uint8 Layer, const DISPLAY_Rect_t *Viewport)
+{
+    DISPLAY_Surface_t *Surface;
+    DISPLAY_Rect_t     Clip;
+
+    if (Layer < DISPLAY_MAX_LAYERS)
+    {
+        Render.Layer = Layer;
+    }
+
+    Surface        = &Render.Layers[Render.Layer].Surface;
+    Render.Target  = *Surface;
+    Render.TargetX = 0;
+    Render.TargetY = 0;
+
+    if (Viewport == NULL || Surface->Pixels == NULL)
+    {
+        return;
+    }
+
+    Clip = *Viewport;
+    if (Clip.X < 0 || Clip.Y < 0 || !DISPLAY_RectClipToSurface(&Clip, Surface))
+    {
+        Render.Target.Pixels = NULL;
+        Render.Target.Width  = 0;
+        Render.Target.Height = 0;
+        return;
+    }
+
+    Render.Target.Pixels += (Clip.Y * Surface->Stride) + (Clip.X * Surface->Format.BytesPerPixel);
+    Render.Target.Width  = (uint32)Clip.W;
+    Render.Target.Height = (uint32)Clip.H;
+    Render.TargetX       = Clip.X;
+    Render.TargetY       = Clip.Y;
+}
+
+/*
+** Running total of pixels written through the render API, used to charge
+** clients for their draws
+*/
+uint32 DISPLAY_RenderGetPixelCount(void)
+{
+    return Render.PixelCount;
+}
+
+/*
+** Flushes that presented something, which identifies the frame on the
+** panel
+*/
+uint32 DISPLAY_RenderGetFlushes(void)
+{
+    return Render.Perf.Flushes;
+}
+
+/*
+** Queued draws dropped whole because later draws covered them
+*/
+uint32 DISPLAY_RenderGetCulled(void)
+{
+    return Render.Perf.DrawsCulled;
+}
+
+/*
+** Mark Rect, in the current target's coordinates, for the next flush
+*/
+void DISPLAY_RenderDamage(const DISPLAY_Rect_t *Rect)
+{
+    DISPLAY_Rect_t Clip = *Rect;
+
+    if (Render.Target.Pixels != NULL && DISPLAY_RectClipToSurface(&Clip, &Render.Target))
+    {
+        Render.PixelCount += (uint32)(Clip.W * Clip.H);
+
+        Clip.X += Render.TargetX;
+        Clip.Y += Render.TargetY;
+        DISPLAY_DamageAdd(&Render.Damage, &Clip, &Render.Model, Render.Back.Format.BytesPerPixel);
+    }
+}
+
+static void DISPLAY_RenderFillBand(int32 Y, int32 Rows, const void *Arg)
+{
+    const DISPLAY_RenderDraw_t *Draw = Arg;
+    DISPLAY_Surface_t           Target = Draw->Target;
+    DISPLAY_Rect_t              Clip   = {Draw->Part.X, Y, Draw->Part.W, Rows};
+
+    DISPLAY_DrawFillRect(&Target, &Clip, Draw->Pixel);
+}
+
+static void DISPLAY_RenderGradientBand(int32 Y, int32 Rows, const void *Arg)
+{
+    const DISPLAY_RenderDraw_t *Draw = Arg;
+    DISPLAY_Surface_t           Target = Draw->Target;
+    DISPLAY_Rect_t              Clip   = {Draw->Part.X, Y, Draw->Part.W, Rows};
+
+    DISPLAY_DitherGradient(&Target, &Draw->Rect, &Clip, Draw->From, Draw->To, Draw->Vertical);
+}
+
+/*
+** The image is blitted whole into a view of the target that only holds
+** the band's piece, and clipped to it there
+*/
+static void DISPLAY_RenderBlitBand(int32 Y, int32 Rows, const void *Arg)
+{
+    const DISPLAY_RenderDraw_t *Draw = Arg;
+    DISPLAY_Surface_t           View = Draw->Target;
+
+    View.Pixels += (Y * View.Stride) + (Draw->Part.X * View.Format.BytesPerPixel);
+    View.Width  = (uint32)Draw->Part.W;
+    View.Height = (uint32)Rows;
+
+    DISPLAY_DrawBlit565(&View, Draw->Rect.X - Draw->Part.X, Draw->Rect.Y - Y, Draw->Src, (uint32)Draw->Rect.W,
+                        (uint32)Draw->Rect.H);
+}
+
+static void DISPLAY_RenderGlyphBand(int32 Y, int32 Rows, const void *Arg)
+{
+    const DISPLAY_RenderDraw_t *Draw = Arg;
+    DISPLAY_Surface_t           View = Draw->Target;
+
+    View.Pixels += (Y * View.Stride) + (Draw->Part.X * View.Format.BytesPerPixel);
+    View.Width  = (uint32)Draw->Part.W;
+    View.Height = (uint32)Rows;
+
+    DISPLAY_DrawBlendA8(&View, Draw->Rect.X - Draw->Part.X, Draw->Rect.Y - Y, Draw->Src, (uint32)Draw->Rect.W,
+                        (uint32)Draw->Rect.H, Draw->Pixel);
+}
+
+/*
+** Parts of Draw's area that no later queued draw on its layer covers.
+** Covering draws that would cut it into more than Out holds are passed
+** over, which only costs drawing pixels that are drawn again later.
+*/
+static uint32 DISPLAY_RenderVisible(DISPLAY_Rect_t Out[DISPLAY_RENDER_MAX_PARTS], uint32 Index)
+{
+    const DISPLAY_RenderDraw_t *Draw = &RenderQueue[Index];
+    const DISPLAY_RenderDraw_t *Later;
+    DISPLAY_Rect_t              Next[DISPLAY_RENDER_MAX_PARTS];
+    DISPLAY_Rect_t              Cut[4];
+    uint32                      Count = 1;
+    uint32                      NextCount, CutCount;
+    uint32                      i, j;
+
+    Out[0] = Draw->Area;
+
+    for (i = Index + 1; i < RenderQueued && Count > 0; i++)
+    {
+        Later = &RenderQueue[i];
+        if (Later->Layer != Draw->Layer || Later->Blends)
+        {
+            continue;
+        }
+
+        NextCount = 0;
+        for (j = 0; j < Count && NextCount <= DISPLAY_RENDER_MAX_PARTS; j++)
+        {
+            CutCount = DISPLAY_RectSubtract(Cut, &Out[j], &Later->Area);
+            if (NextCount + CutCount <= DISPLAY_RENDER_MAX_PARTS)
+            {
+                memcpy(&Next[NextCount], Cut, CutCount * sizeof(Cut[0]));
+            }
+            NextCount += CutCount;
+        }
+
+        if (NextCount <= DISPLAY_RENDER_MAX_PARTS)
+        {
+            memcpy(Out, Next, NextCount * sizeof(Next[0]));
+            Count = NextCount;
+        }
+    }
+
+    return Count;
+}
+
+/*
+** Draw what is queued, each draw only where no later one covers it
+*/
+void DISPLAY_RenderSync(void)
+{
+    DISPLAY_RenderDraw_t *Draw;
+    DISPLAY_Rect_t        Parts[DISPLAY_RENDER_MAX_PARTS];
+    uint32                Count, Drawn, i, n;
+
+    for (i = 0; i < RenderQueued; i++)
+    {
+        Draw  = &RenderQueue[i];
+        Count = DISPLAY_RenderVisible(Parts, i);
+        Drawn = 0;
+
+        for (n = 0; n < Count; n++)
+        {
+            Draw->Part = Parts[n];
+            Draw->Part.X -= Draw->TargetX;
+            Draw->Part.Y -= Draw->TargetY;
+            DISPLAY_BandRun(Draw->Part.Y, Draw->Part.H, Draw->Part.W, Draw->Func, Draw);
+            Drawn += (uint32)(Parts[n].W * Parts[n].H);
+        }
+
+        if (Count == 0)
+        {
+            Render.Perf.DrawsCulled++;
+        }
+        else if (Drawn < (uint32)(Draw->Area.W * Draw->Area.H))
+        {
+            Render.Perf.DrawsClipped++;
+        }
+        Render.Perf.PixelsSkipped += (uint32)(Draw->Area.W * Draw->Area.H) - Drawn;
+    }
+
+    RenderQueued = 0;
+}
+
+/*
+** Queue a draw on the current target and damage the area it covers
+*/
+static void DISPLAY_RenderDraw(DISPLAY_RenderDraw_t *Draw, DISPLAY_BandFunc_t Func)
+{
+    DISPLAY_Rect_t Clip = Draw->Rect;
+
+    if (Render.Target.Pixels != NULL && DISPLAY_RectClipToSurface(&Clip, &Render.Target))
+    {
+        if (RenderQueued == DISPLAY_RENDER_QUEUE_DEPTH)
+        {
+            DISPLAY_RenderSync();
+        }
+
+        Draw->Func    = Func;
+        Draw->Layer   = Render.Layer;
+        Draw->Target  = Render.Target;
+        Draw->TargetX = Render.TargetX;
+        Draw->TargetY = Render.TargetY;
+        Draw->Area    = Clip;
+        Draw->Area.X += Render.TargetX;
+        Draw->Area.Y += Render.TargetY;
+
+        RenderQueue[RenderQueued++] = *Draw;
+    }
+
+    DISPLAY_RenderDamage(&Draw->Rect);
+}
+
+void DISPLAY_RenderFillRect(const DISPLAY_Rect_t *Rect, DISPLAY_Color_t Color)
+{
+    DISPLAY_RenderDraw_t Draw = {.Rect = *Rect};
+
+    Draw.Pixel = DISPLAY_DrawPackColor(&Render.Target.Format, Color);
+    DISPLAY_RenderDraw(&Draw, DISPLAY_RenderFillBand);
+}
+
+/*
+** Fill Rect with the selected layer's key color, so that on an overlay the
+** layers below show through again
+*/
+void DISPLAY_RenderClear(const DISPLAY_Rect_t *Rect)
+{
+    DISPLAY_RenderDraw_t Draw = {.Rect = *Rect};
+
+    Draw.Pixel = Render.Layers[Render.Layer].Key;
+    DISPLAY_RenderDraw(&Draw, DISPLAY_RenderFillBand);
+}
+
+void DISPLAY_RenderGradient(const DISPLAY_Rect_t *Rect, DISPLAY_Color_t From, DISPLAY_Color_t To, bool Vertical)
+{
+    DISPLAY_RenderDraw_t Draw = {.Rect = *Rect, .From = From, .To = To, .Vertical = Vertical};
+
+    DISPLAY_RenderDraw(&Draw, DISPLAY_RenderGradientBand);
+}
+
+void DISPLAY_RenderBlit565(int32 X, int32 Y, const uint8 *Pixels, uint32 Width, uint32 Height)
+{
+    DISPLAY_RenderDraw_t Draw = {.Rect = {X, Y, (int32)Width, (int32)Height}, .Src = Pixels};
+
+    DISPLAY_RenderDraw(&Draw, DISPLAY_RenderBlitBand);
+}
+
+/*
+** Blend Color over Width x Height pixels at (X, Y), weighted by one byte
+** of Coverage each. Coverage must stay put until the queue is drawn.
+*/
+void DISPLAY_RenderGlyph(int32 X, int32 Y, const uint8 *Coverage, uint32 Width, uint32 Height,
+                         DISPLAY_Color_t Color)
+{
+    DISPLAY_RenderDraw_t Draw = {.Rect = {X, Y, (int32)Width, (int32)Height}, .Blends = true, .Src = Coverage};
+
+    Draw.Pixel = DISPLAY_DrawPackColor(&Render.Target.Format, Color);
+    DISPLAY_RenderDraw(&Draw, DISPLAY_RenderGlyphBand);
+}
+
+/*
+** Rebuild Rect of Back from the visible layers. Layers below the topmost
+** opaque one cannot show through, so compositing starts there; each row is
+** finished across all layers before moving on so it stays in cache.
+*/
+static void DISPLAY_RenderComposite(const DISPLAY_Rect_t *Rect)
+{
+    const DISPLAY_Layer_t *L;
+    uint32                 Bpp      = Render.Back.Format.BytesPerPixel;
+    uint32                 RowBytes = Rect->W * Bpp;
+    uint32                 Offset;
+    uint8                 *Dst;
+    int                    Base = -1;
+    int                    n;
+    int32                  y;
+
+    for (n = 0; n < DISPLAY_MAX_LAYERS; n++)
+    {
+        L = &Render.Layers[Render.Order[n]];
+        if (L->Visible && !L->KeyEnabled)
+        {
+            Base = n;
+        }
+    }
+
+    for (y = Rect->Y; y < Rect->Y + Rect->H; y++)
+    {
+        Offset = (y * Render.Back.Stride) + (Rect->X * Bpp);
+        Dst    = Render.Back.Pixels + Offset;
+
+        if (Base < 0)
+        {
+            memset(Dst, 0, RowBytes);
+        }
+        else
+        {
+            memcpy(Dst, Render.Layers[Render.Order[Base]].Surface.Pixels + Offset, RowBytes);
+        }
+
+        for (n = Base + 1; n < DISPLAY_MAX_LAYERS; n++)
+        {
+            L = &Render.Layers[Render.Order[n]];
+            if (L->Visible)
+            {
+                DISPLAY_DrawCopyKeyed(Dst, L->Surface.Pixels + Offset, (uint32)Rect->W, Bpp, L->Key);
+            }
+        }
+    }
+}
+
+/*
+** Composite and copy one band of a damaged area
+*/
+static void DISPLAY_RenderPresentBand(int32 Y, int32 Rows, const void *Arg)
+{
+    const DISPLAY_Rect_t *Rect = Arg;
+    DISPLAY_Rect_t        Band = {Rect->X, Y, Rect->W, Rows};
+
+    DISPLAY_RenderComposite(&Band);
+    DISPLAY_FbPresent(&Render.Back, &Band, Render.Rotation);
+}
+
+/*
+** Composite and copy everything drawn since the last flush to the device,
+** Paced to the start of the next panel refresh or else at once. A paced
+** copy still running when the refresh after that starts is counted late:
+** part of it shows a frame later than the rest.
+*/
+void DISPLAY_RenderFlush(bool Paced)
+{
+    DISPLAY_PerfTlm_Payload_t *Perf = &Render.Perf;
+    DISPLAY_Rect_t            *Rect;
+    uint32                     Bpp = Render.Back.Format.BytesPerPixel;
+    uint64                     Refresh, Start, End, Estimate;
+    uint32                     i;
+
+    DISPLAY_RenderSync();
+
+    if (Render.Back.Pixels == NULL)
+    {
+        DISPLAY_DamageClear(&Render.Damage);
+        return;
+    }
+
+    if (Render.Damage.Count == 0)
+    {
+        DISPLAY_RenderIdle(DISPLAY_RenderNowMs());
+        return;
+    }
+
+    DISPLAY_RenderWake(DISPLAY_RenderNowMs());
+
+    Refresh = Paced ? DISPLAY_RenderPace() : 0;
+
+    CFE_ES_PerfLogEntry(DISPLAY_FLUSH_PERF_ID);
+    Start = DISPLAY_RenderNowNs();
+
+    Perf->DamageRects += Render.Damage.Count;
+    Estimate = DISPLAY_DamagePlan(&Render.Damage, &Render.Model, Bpp);
+
+    for (i = 0; i < Render.Damage.Count; i++)
+    {
+        Rect = &Render.Damage.Rects[i];
+
+        DISPLAY_BandRun(Rect->Y, Rect->H, Rect->W, DISPLAY_RenderPresentBand, Rect);
+        DISPLAY_CrcUpdate(Rect);
+
+        Perf->BytesCopied += (uint32)(Rect->W * Rect->H) * Bpp;
+        Perf->LastPlan[i].X = (uint16)Rect->X;
+        Perf->LastPlan[i].Y = (uint16)Rect->Y;
+        Perf->LastPlan[i].W = (uint16)Rect->W;
+        Perf->LastPlan[i].H = (uint16)Rect->H;
+    }
+
+    Perf->Flushes++;
+    Perf->Copies += Render.Damage.Count;
+    Perf->LastCount      = (uint8)Render.Damage.Count;
+    Perf->LastEstimateNs = (uint32)Estimate;
+
+    End                = DISPLAY_RenderNowNs();
+    Perf->LastActualNs = (uint32)(End - Start);
+    if (Paced && Perf->RefreshUs != 0 && End - Refresh >= (uint64)Perf->RefreshUs * 1000)
+    {
+        Perf->LatePresents++;
+    }
+
+    DISPLAY_DamageClear(&Render.Damage);
+
+    CFE_ES_PerfLogExit(DISPLAY_FLUSH_PERF_ID);
+}
+
+/*
+** Checksum of the displayed frame over Rect, or all of it when Rect is
+** empty
+*/
+CFE_Status_t DISPLAY_RenderCrc(const DISPLAY_Rect_t *Rect, DISPLAY_CrcTlm_Payload_t *Payload)
+{
+    DISPLAY_Rect_t Full = {0, 0, (int32)Render.Back.Width, (int32)Render.Back.Height};
+    DISPLAY_Rect_t Area;
+    CFE_Status_t   status;
+
+    if (Render.Back.Pixels == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    status = DISPLAY_CrcArea(DISPLAY_RectIsEmpty(Rect) ? &Full : Rect, &Area, &Payload->Crc, &Payload->Tiles);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    Payload->Area.X  = (uint16)Area.X;
+    Payload->Area.Y  = (uint16)Area.Y;
+    Payload->Area.W  = (uint16)Area.W;
+    Payload->Area.H  = (uint16)Area.H;
+    Payload->Flushes = Render.Perf.Flushes;
+
+    return CFE_SUCCESS;
+}
+
+void DISPLAY_RenderGetPerf(DISPLAY_PerfTlm_Payload_t *Payload)
+{
+    uint64 NowMs = DISPLAY_RenderNowMs();
+    uint64 IdleMs;
+
+    /* Time set backwards leaves the last values in place */
+    if (Render.ConfiguredMs != 0 && NowMs >= Render.ConfiguredMs && NowMs >= Render.IdleSinceMs)
+    {
+        IdleMs = Render.IdleTotalMs + (Render.Idle ? NowMs - Render.IdleSinceMs : 0);
+        if (IdleMs > NowMs - Render.ConfiguredMs)
+        {
+            IdleMs = NowMs - Render.ConfiguredMs;
+        }
+
+        Render.Perf.IdleMs   = (uint32)IdleMs;
+        Render.Perf.ActiveMs = (uint32)(NowMs - Render.ConfiguredMs - IdleMs);
+    }
+
+    DISPLAY_BandGetStats(&Render.Perf.Workers, &Render.Perf.BandedJobs);
+
+    *Payload = Render.Perf;
+
+    Render.Perf.MaxJitterUs = 0;
+}
@@ -0,0 +1,38 @@
+#ifndef DISPLAY_RENDER__H_
+#define DISPLAY_RENDER__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_draw.h"
+#include "display_table.h"
+
+#define DISPLAY_MAX_REFRESH_US 100000 /* Longest refresh period flushes are timed to, 10 Hz */
+
+void         DISPLAY_RenderInit(void);
+CFE_Status_t DISPLAY_RenderConfigure(const DISPLAY_Table_t *TblPtr);
+void         DISPLAY_RenderClose(void);
+bool         DISPLAY_RenderIsReady(void);
+
+CFE_Status_t DISPLAY_RenderSetLayer(uint8 Layer, uint8 Z, bool Visible, bool KeyEnabled, DISPLAY_Color_t KeyColor);
+uint8        DISPLAY_RenderGetLayer(void);
+void         DISPLAY_RenderSetTarget(uint8 Layer, const DISPLAY_Rect_t *Viewport);
+uint32       DISPLAY_RenderGetPixelCount(void);
+uint32       DISPLAY_RenderGetFlushes(void);
+uint32       DISPLAY_RenderGetCulled(void);
+
+void DISPLAY_RenderFillRect(const DISPLAY_Rect_t *Rect, DISPLAY_Color_t Color);
+void DISPLAY_RenderClear(const DISPLAY_Rect_t *Rect);
+void DISPLAY_RenderGradient(const DISPLAY_Rect_t *Rect, DISPLAY_Color_t From, DISPLAY_Color_t To, bool Vertical);
+void DISPLAY_RenderBlit565(int32 X, int32 Y, const uint8 *Pixels, uint32 Width, uint32 Height);
+void DISPLAY_RenderGlyph(int32 X, int32 Y, const uint8 *Coverage, uint32 Width, uint32 Height,
+                         DISPLAY_Color_t Color);
+void DISPLAY_RenderDamage(const DISPLAY_Rect_t *Rect);
+void DISPLAY_RenderSync(void);
+void DISPLAY_RenderFlush(bool Paced);
+void DISPLAY_RenderGetPerf(DISPLAY_PerfTlm_Payload_t *Payload);
+
+CFE_Status_t DISPLAY_RenderCrc(const DISPLAY_Rect_t *Rect, DISPLAY_CrcTlm_Payload_t *Payload);
+
+const DISPLAY_Surface_t *DISPLAY_RenderGetSurface(void);
+
+#endif // DISPLAY_RENDER__H_
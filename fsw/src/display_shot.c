@@ -0,0 +1,343 @@
+#include "display_shot.h"
+#include "display_arena.h"
+#include "display_crc.h"
+#include "display_msg.h"
+#include "cfe_time.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/*
+** Screenshot streaming. A capture marks the tiles to send and the frame
+** tick sends as many packets as the byte rate allows, encoding each tile
+** straight from the composited frame as it goes. A delta capture marks
+** only tiles whose CRC differs from the one recorded when the tile was
+** last sent, so an unchanged panel costs a single empty packet. Tiles that
+** change after they were sent are picked up by the next delta capture.
+*/
+#define DISPLAY_SHOT_SENT    0x01 /* Sent holds the tile's CRC when last sent */
+#define DISPLAY_SHOT_PENDING 0x02 /* Still to send in the current capture */
+
+#define DISPLAY_SHOT_TILE_BYTES (DISPLAY_CRC_TILE * DISPLAY_CRC_TILE * 4)
+
+typedef struct
+{
+    const DISPLAY_Surface_t *Frame;
+    uint16                  *Sent;  /* Tile CRC when last sent */
+    uint8                   *State; /* DISPLAY_SHOT_* flags per tile */
+    uint32                   TileCount;
+
+    bool   Active;
+    uint8  Flags;
+    uint16 CaptureId;
+    uint16 Sequence;
+    uint16 Tiles;     /* Marked by the capture */
+    uint32 NextTile;  /* Scan position */
+    int64  Credit;    /* Bytes that may be sent, in thousandths */
+    uint64 LastMs;
+
+    /* The last tile encoded, kept when it did not fit the packet */
+    int32  HeldTile;
+    uint16 HeldCrc; /* Tile CRC when encoded */
+    uint8  HeldEncoding;
+    uint16 HeldLength;
+    uint8  Held[2 * DISPLAY_SHOT_TILE_BYTES];
+    uint8  Raw[DISPLAY_SHOT_TILE_BYTES];
+} DISPLAY_Shot_t;
+
+static DISPLAY_Shot_t Shot = {.HeldTile = -1};
+
+static uint64 DISPLAY_ShotNowMs(void)
+{
+    CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+
+    return ((uint64)Now.Seconds * 1000) + (((uint64)Now.Subseconds * 1000) >> 32);
+}
+
+/*
+** Size the per-tile state for Frame, from the frame pool, on the same
+** grid as the CRC tiles. Must follow DISPLAY_CrcConfigure.
+*/
+CFE_Status_t DISPLAY_ShotConfigure(const DISPLAY_Surface_t *Frame)
+{
+    uint32 TilesX, TilesY;
+
+    DISPLAY_ShotClose();
+
+    if (DISPLAY_CrcTiles(&TilesX, &TilesY) == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Shot.TileCount = TilesX * TilesY;
+    Shot.Sent      = DISPLAY_ArenaAlloc(DISPLAY_POOL_FRAME, Shot.TileCount * sizeof(uint16), sizeof(uint16));
+    Shot.State     = DISPLAY_ArenaAlloc(DISPLAY_POOL_FRAME, Shot.TileCount, 1);
+    if (Shot.Sent == NULL || Shot.State == NULL)
+    {
+        DISPLAY_ShotClose();
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    memset(Shot.State, 0, Shot.TileCount);
+    Shot.Frame = Frame;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Drop the tile state, abandoning any capture in progress. Capture numbers
+** keep counting so the ground can tell the captures apart.
+*/
+void DISPLAY_ShotClose(void)
+{
+    uint16 CaptureId = Shot.CaptureId;
+
+    memset(&Shot, 0, offsetof(DISPLAY_Shot_t, Held));
+    Shot.CaptureId = CaptureId;
+    Shot.HeldTile  = -1;
+}
+
+bool DISPLAY_ShotIsActive(void)
+{
+    return Shot.Active;
+}
+
+/*
+** Mark the tiles of a new capture. CaptureId and Tiles report its number
+** and size.
+*/
+CFE_Status_t DISPLAY_ShotStart(uint8 Mode, uint16 *CaptureId, uint16 *Tiles)
+{
+    const uint16 *Crcs;
+    uint32        TilesX, TilesY;
+    uint32        i;
+
+    if (Mode != DISPLAY_SHOT_MODE_FULL && Mode != DISPLAY_SHOT_MODE_DELTA)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+    if (Shot.Active)
+    {
+        return DISPLAY_STATUS_ERROR_BUSY;
+    }
+
+    Crcs = DISPLAY_CrcTiles(&TilesX, &TilesY);
+    if (Shot.Frame == NULL || Crcs == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_OPEN;
+    }
+
+    Shot.Tiles = 0;
+    for (i = 0; i < Shot.TileCount; i++)
+    {
+        if (Mode == DISPLAY_SHOT_MODE_FULL || !(Shot.State[i] & DISPLAY_SHOT_SENT) || Shot.Sent[i] != Crcs[i])
+        {
+            Shot.State[i] |= DISPLAY_SHOT_PENDING;
+            Shot.Tiles++;
+        }
+    }
+
+    Shot.Active   = true;
+    Shot.Flags    = (Mode == DISPLAY_SHOT_MODE_DELTA) ? DISPLAY_SHOT_FLAG_DELTA : 0;
+    Shot.Sequence = 0;
+    Shot.NextTile = 0;
+    Shot.Credit   = 0;
+    Shot.LastMs   = DISPLAY_ShotNowMs();
+    Shot.HeldTile = -1;
+    Shot.CaptureId++;
+
+    *CaptureId = Shot.CaptureId;
+    *Tiles     = Shot.Tiles;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** PackBits over Count pixels of Bpp bytes: a control byte C < 128 is
+** followed by C + 1 literal pixels, C >= 128 by one pixel sent C - 126
+** times. Returns the encoded length, which may exceed the input.
+*/
+static uint32 DISPLAY_ShotRle(uint8 *Dst, const uint8 *Src, uint32 Count, uint32 Bpp)
+{
+    uint32 Out = 0;
+    uint32 i   = 0;
+    uint32 Run;
+
+    while (i < Count)
+    {
+        Run = 1;
+        while (i + Run < Count && Run < 129 && memcmp(Src + (i * Bpp), Src + ((i + Run) * Bpp), Bpp) == 0)
+        {
+            Run++;
+        }
+
+        if (Run >= 2)
+        {
+            Dst[Out++] = (uint8)(Run + 126);
+            memcpy(Dst + Out, Src + (i * Bpp), Bpp);
+            Out += Bpp;
+            i += Run;
+            continue;
+        }
+
+        /* Literals run up to the next pair of equal pixels */
+        Run = 1;
+        while (i + Run < Count && Run < 128 &&
+               !(i + Run + 1 < Count && memcmp(Src + ((i + Run) * Bpp), Src + ((i + Run + 1) * Bpp), Bpp) == 0))
+        {
+            Run++;
+        }
+
+        Dst[Out++] = (uint8)(Run - 1);
+        memcpy(Dst + Out, Src + (i * Bpp), Run * Bpp);
+        Out += Run * Bpp;
+        i += Run;
+    }
+
+    return Out;
+}
+
+/*
+** Encode tile Tile into the held buffer, run length encoded unless that
+** comes out no smaller than the raw pixels
+*/
+static void DISPLAY_ShotEncode(uint32 Tile, const uint16 *Crcs)
+{
+    const DISPLAY_Surface_t *Frame = Shot.Frame;
+    uint32                   TilesX = (Frame->Width + DISPLAY_CRC_TILE - 1) / DISPLAY_CRC_TILE;
+    uint32                   Bpp    = Frame->Format.BytesPerPixel;
+    uint32                   x0     = (Tile % TilesX) * DISPLAY_CRC_TILE;
+    uint32                   y0     = (Tile / TilesX) * DISPLAY_CRC_TILE;
+    uint32                   w      = (x0 + DISPLAY_CRC_TILE < Frame->Width) ? DISPLAY_CRC_TILE : Frame->Width - x0;
+    uint32                   h      = (y0 + DISPLAY_CRC_TILE < Frame->Height) ? DISPLAY_CRC_TILE : Frame->Height - y0;
+    uint32                   RawLength = w * h * Bpp;
+    uint32                   Length;
+    uint32                   y;
+
+    for (y = 0; y < h; y++)
+    {
+        memcpy(Shot.Raw + (y * w * Bpp), Frame->Pixels + ((y0 + y) * Frame->Stride) + (x0 * Bpp), w * Bpp);
+    }
+
+    Length = DISPLAY_ShotRle(Shot.Held, Shot.Raw, w * h, Bpp);
+    if (Length < RawLength)
+    {
+        Shot.HeldEncoding = DISPLAY_SHOT_ENCODING_RLE;
+        Shot.HeldLength   = (uint16)Length;
+    }
+    else
+    {
+        memcpy(Shot.Held, Shot.Raw, RawLength);
+        Shot.HeldEncoding = DISPLAY_SHOT_ENCODING_RAW;
+        Shot.HeldLength   = (uint16)RawLength;
+    }
+
+    Shot.HeldCrc  = Crcs[Tile];
+    Shot.HeldTile = (int32)Tile;
+}
+
+/*
+** Fill Payload with the next pending tiles. Returns the data length.
+*/
+static uint16 DISPLAY_ShotFill(DISPLAY_ShotTlm_Payload_t *Payload)
+{
+    const DISPLAY_Surface_t *Frame = Shot.Frame;
+    const uint16            *Crcs;
+    DISPLAY_ShotTileHeader_t Header;
+    uint32                   TilesX, TilesY;
+    uint32                   Used = 0;
+
+    Crcs = DISPLAY_CrcTiles(&TilesX, &TilesY);
+
+    Payload->CaptureId     = Shot.CaptureId;
+    Payload->Sequence      = Shot.Sequence++;
+    Payload->Width         = (uint16)Frame->Width;
+    Payload->Height        = (uint16)Frame->Height;
+    Payload->Tiles         = Shot.Tiles;
+    Payload->TileCount     = 0;
+    Payload->Flags         = Shot.Flags;
+    Payload->BytesPerPixel = Frame->Format.BytesPerPixel;
+    Payload->RedOffset     = Frame->Format.RedOffset;
+    Payload->RedLength     = Frame->Format.RedLength;
+    Payload->GreenOffset   = Frame->Format.GreenOffset;
+    Payload->GreenLength   = Frame->Format.GreenLength;
+    Payload->BlueOffset    = Frame->Format.BlueOffset;
+    Payload->BlueLength    = Frame->Format.BlueLength;
+    memset(Payload->Spare, 0, sizeof(Payload->Spare));
+
+    for (; Shot.NextTile < Shot.TileCount; Shot.NextTile++)
+    {
+        if (!(Shot.State[Shot.NextTile] & DISPLAY_SHOT_PENDING))
+        {
+            continue;
+        }
+
+        if (Shot.HeldTile != (int32)Shot.NextTile)
+        {
+            DISPLAY_ShotEncode(Shot.NextTile, Crcs);
+        }
+        if (Used + sizeof(Header) + Shot.HeldLength > sizeof(Payload->Data))
+        {
+            break;
+        }
+
+        Header.Tile     = (uint16)Shot.NextTile;
+        Header.Encoding = Shot.HeldEncoding;
+        Header.Spare    = 0;
+        Header.Length   = Shot.HeldLength;
+
+        /* Records are byte packed */
+        memcpy(Payload->Data + Used, &Header, sizeof(Header));
+        memcpy(Payload->Data + Used + sizeof(Header), Shot.Held, Shot.HeldLength);
+        Used += sizeof(Header) + Shot.HeldLength;
+        Payload->TileCount++;
+
+        Shot.Sent[Shot.NextTile]  = Shot.HeldCrc;
+        Shot.State[Shot.NextTile] = DISPLAY_SHOT_SENT;
+        Shot.HeldTile             = -1;
+    }
+
+    if (Shot.NextTile >= Shot.TileCount)
+    {
+        Payload->Flags |= DISPLAY_SHOT_FLAG_LAST;
+        Shot.Active = false;
+    }
+
+    Payload->DataLength = (uint16)Used;
+
+    return (uint16)Used;
+}
+
+/*
+** Send what the byte rate allows of the capture in progress. Unused credit
+** is kept for up to a second, and a packet may overdraw it, the debt being
+** paid off before the next is sent.
+*/
+void DISPLAY_ShotService(DISPLAY_ShotTlm_Payload_t *Payload, uint32 BytesPerSec, DISPLAY_ShotSend_t Send)
+{
+    uint64 NowMs;
+    size_t Size;
+
+    if (!Shot.Active)
+    {
+        return;
+    }
+
+    NowMs = DISPLAY_ShotNowMs();
+    if (NowMs > Shot.LastMs)
+    {
+        Shot.Credit += (int64)((NowMs - Shot.LastMs) * BytesPerSec);
+        if (Shot.Credit > (int64)BytesPerSec * 1000)
+        {
+            Shot.Credit = (int64)BytesPerSec * 1000;
+        }
+    }
+    Shot.LastMs = NowMs;
+
+    while (Shot.Active && Shot.Credit > 0)
+    {
+        Size = offsetof(DISPLAY_ShotTlm_t, Payload.Data) + DISPLAY_ShotFill(Payload);
+        Send(Size);
+        Shot.Credit -= (int64)Size * 1000;
+    }
+}
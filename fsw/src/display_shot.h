@@ -0,0 +1,17 @@
+#ifndef DISPLAY_SHOT__H_
+#define DISPLAY_SHOT__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_draw.h"
+
+/* Transmit the screenshot packet just filled in, Size bytes long with its header */
+typedef void (*DISPLAY_ShotSend_t)(size_t Size);
+
+CFE_Status_t DISPLAY_ShotConfigure(const DISPLAY_Surface_t *Frame);
+void         DISPLAY_ShotClose(void);
+CFE_Status_t DISPLAY_ShotStart(uint8 Mode, uint16 *CaptureId, uint16 *Tiles);
+void         DISPLAY_ShotService(DISPLAY_ShotTlm_Payload_t *Payload, uint32 BytesPerSec, DISPLAY_ShotSend_t Send);
+bool         DISPLAY_ShotIsActive(void);
+
+#endif // DISPLAY_SHOT__H_
@@ -0,0 +1,187 @@
+#include "display_stream.h"
+#include "display_msg.h"
+
+#include <string.h>
+
+/*
+** Copies into device memory.
+**
+** The mapped framebuffer is only ever written, and on most drivers it is
+** mapped write-combining, where a store that does not fill a whole cache
+** line goes out to the device as a partial burst. Where the CPU has them,
+** rows are therefore written with non-temporal stores in whole, aligned
+** cache lines: they bypass the cache, so presenting a frame does not evict
+** the layers it was composited from, and every burst is full. The ragged
+** ends of a row, and rows too short to hold a full line, use ordinary
+** stores.
+**
+** Which routine is used is decided at run time. DISPLAY_StreamDetect
+** reports the best one the CPU supports; the render layer times it against
+** ordinary stores on the device it has and selects the faster, as
+** streaming into memory that is cached after all can be the slower choice.
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DISPLAY_STREAM_X86
+#include <immintrin.h>
+#endif
+
+typedef void (*DISPLAY_StreamCopyFunc_t)(uint8 *Dst, const uint8 *Src, uint32 Length);
+
+static void DISPLAY_StreamCopyScalar(uint8 *Dst, const uint8 *Src, uint32 Length)
+{
+    memcpy(Dst, Src, Length);
+}
+
+static uint8                    StreamPath = DISPLAY_PRESENT_PATH_SCALAR;
+static DISPLAY_StreamCopyFunc_t StreamCopy = DISPLAY_StreamCopyScalar;
+
+#ifdef DISPLAY_STREAM_X86
+
+/*
+** Ordinary stores up to the first line boundary of Dst; returns the bytes
+** left for the streaming loop, or 0 if the row is too short to bother
+*/
+static uint32 DISPLAY_StreamHead(uint8 **Dst, const uint8 **Src, uint32 Length)
+{
+    uint32 Head = (uint32)(-(uintptr_t)*Dst & (DISPLAY_STREAM_LINE - 1));
+
+    if (Length < Head + DISPLAY_STREAM_LINE)
+    {
+        memcpy(*Dst, *Src, Length);
+        return 0;
+    }
+
+    memcpy(*Dst, *Src, Head);
+    *Dst += Head;
+    *Src += Head;
+
+    return Length - Head;
+}
+
+__attribute__((target("sse2"))) static void DISPLAY_StreamCopySse2(uint8 *Dst, const uint8 *Src, uint32 Length)
+{
+    __m128i a, b, c, d;
+
+    Length = DISPLAY_StreamHead(&Dst, &Src, Length);
+
+    for (; Length >= DISPLAY_STREAM_LINE; Length -= DISPLAY_STREAM_LINE)
+    {
+        a = _mm_loadu_si128((const __m128i *)(const void *)Src);
+        b = _mm_loadu_si128((const __m128i *)(const void *)(Src + 16));
+        c = _mm_loadu_si128((const __m128i *)(const void *)(Src + 32));
+        d = _mm_loadu_si128((const __m128i *)(const void *)(Src + 48));
+        _mm_stream_si128((__m128i *)(void *)Dst, a);
+        _mm_stream_si128((__m128i *)(void *)(Dst + 16), b);
+        _mm_stream_si128((__m128i *)(void *)(Dst + 32), c);
+        _mm_stream_si128((__m128i *)(void *)(Dst + 48), d);
+        Src += DISPLAY_STREAM_LINE;
+        Dst += DISPLAY_STREAM_LINE;
+    }
+
+    memcpy(Dst, Src, Length);
+}
+
+__attribute__((target("avx"))) static void DISPLAY_StreamCopyAvx(uint8 *Dst, const uint8 *Src, uint32 Length)
+{
+    __m256i a, b;
+
+    Length = DISPLAY_StreamHead(&Dst, &Src, Length);
+
+    for (; Length >= DISPLAY_STREAM_LINE; Length -= DISPLAY_STREAM_LINE)
+    {
+        a = _mm256_loadu_si256((const __m256i *)(const void *)Src);
+        b = _mm256_loadu_si256((const __m256i *)(const void *)(Src + 32));
+        _mm256_stream_si256((__m256i *)(void *)Dst, a);
+        _mm256_stream_si256((__m256i *)(void *)(Dst + 32), b);
+        Src += DISPLAY_STREAM_LINE;
+        Dst += DISPLAY_STREAM_LINE;
+    }
+
+    memcpy(Dst, Src, Length);
+}
+
+__attribute__((target("sse"))) static void DISPLAY_StreamSfence(void)
+{
+    _mm_sfence();
+}
+
+#endif /* DISPLAY_STREAM_X86 */
+
+/*
+** Best routine this CPU supports
+*/
+uint8 DISPLAY_StreamDetect(void)
+{
+#ifdef DISPLAY_STREAM_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx"))
+    {
+        return DISPLAY_PRESENT_PATH_AVX;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return DISPLAY_PRESENT_PATH_SSE2;
+    }
+#endif
+
+    return DISPLAY_PRESENT_PATH_SCALAR;
+}
+
+/*
+** Use Path for DISPLAY_StreamCopy, or the scalar copy if the CPU cannot
+** run it. Returns the path now in use.
+*/
+uint8 DISPLAY_StreamSelect(uint8 Path)
+{
+    uint8 Best = DISPLAY_StreamDetect();
+
+    StreamPath = DISPLAY_PRESENT_PATH_SCALAR;
+    StreamCopy = DISPLAY_StreamCopyScalar;
+
+#ifdef DISPLAY_STREAM_X86
+    if (Path == DISPLAY_PRESENT_PATH_AVX && Best == DISPLAY_PRESENT_PATH_AVX)
+    {
+        StreamPath = DISPLAY_PRESENT_PATH_AVX;
+        StreamCopy = DISPLAY_StreamCopyAvx;
+    }
+    else if (Path == DISPLAY_PRESENT_PATH_SSE2 && Best != DISPLAY_PRESENT_PATH_SCALAR)
+    {
+        StreamPath = DISPLAY_PRESENT_PATH_SSE2;
+        StreamCopy = DISPLAY_StreamCopySse2;
+    }
+#else
+    (void)Best;
+#endif
+
+    return StreamPath;
+}
+
+uint8 DISPLAY_StreamGetPath(void)
+{
+    return StreamPath;
+}
+
+/*
+** Copy one row of Length bytes to device memory at Dst
+*/
+void DISPLAY_StreamCopy(uint8 *Dst, const uint8 *Src, uint32 Length)
+{
+    StreamCopy(Dst, Src, Length);
+}
+
+/*
+** Order the streaming stores of a present before anything that follows;
+** they are weakly ordered and may otherwise still sit in the CPU's
+** write-combining buffers
+*/
+void DISPLAY_StreamFence(void)
+{
+#ifdef DISPLAY_STREAM_X86
+    if (StreamPath != DISPLAY_PRESENT_PATH_SCALAR)
+    {
+        DISPLAY_StreamSfence();
+    }
+#endif
+}
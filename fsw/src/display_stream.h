@@ -0,0 +1,15 @@
+#ifndef DISPLAY_STREAM__H_
+#define DISPLAY_STREAM__H_
+
+#include "common_types.h"
+
+/* Cache line, and the unit the streaming routines write */
+#define DISPLAY_STREAM_LINE 64
+
+uint8 DISPLAY_StreamDetect(void);
+uint8 DISPLAY_StreamSelect(uint8 Path);
+uint8 DISPLAY_StreamGetPath(void);
+void  DISPLAY_StreamCopy(uint8 *Dst, const uint8 *Src, uint32 Length);
+void  DISPLAY_StreamFence(void);
+
+#endif // DISPLAY_STREAM__H_
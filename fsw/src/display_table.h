@@ -32,6 +32,15 @@
 
 #include "common_types.h"
 #include "trans_rs422.h"
+#include "display_msg.h"
+
+/*
+** Clockwise rotation from logical (drawing) coordinates to the panel
+*/
+#define DISPLAY_ROTATE_0   0
+#define DISPLAY_ROTATE_90  1
+#define DISPLAY_ROTATE_180 2
+#define DISPLAY_ROTATE_270 3
 
 /*
 ** Table structure
@@ -39,6 +48,20 @@
 typedef struct
 {
     const char DevicePath[PORT_NAME_SIZE];
+    uint8      Rotation; /* Panel mounting, one of DISPLAY_ROTATE_* */
+    uint8      Spare[3];
+    uint32     PoolSize[DISPLAY_POOL_COUNT]; /* Bytes per DISPLAY_POOL_*, read at startup */
+    uint16     ClientMsgBudget;   /* Draw messages per client per tick */
+    uint16     JobBudgetUs;       /* Time per main loop pass for long work such as image conversion; 0 finishes it at once */
+    uint32     ClientPixelBudget; /* Pixels per client per tick; overruns carry into the next tick */
+    uint32     FlushOverheadNs;   /* Cost of one device copy; 0 uses the startup calibration */
+    uint32     FlushPerBytePs;    /* Cost per byte copied, picoseconds; 0 uses the startup calibration */
+    uint32     IdleBlankMs;       /* Blank the panel after this long with nothing new to show; 0 never blanks */
+    uint32     ShotBytesPerSec;   /* Screenshot stream rate, packet headers included */
+    uint16     PanelGamma;        /* Panel response exponent, hundredths; 220 matches sRGB and leaves colors as sent */
+    uint8      Brightness;        /* Percent of full luminance, 1 to 100 */
+    uint8      Workers;           /* Child tasks sharing large draws, read at startup; 0 draws on the app task alone */
+    uint32     RefreshUs;         /* Panel refresh period when the driver gives none; 0 copies without waiting */
 } DISPLAY_Table_t;
 
 #endif /* _display_table_h_ */
@@ -31,6 +31,39 @@
 DISPLAY_Table_t displayTable =
 {
     .DevicePath = "/dev/fb1",
+    .Rotation   = DISPLAY_ROTATE_0,
+
+    .PoolSize =
+    {
+        [DISPLAY_POOL_FRAME] = 256 * 1024,
+        [DISPLAY_POOL_GLYPH] = 16 * 1024,
+        [DISPLAY_POOL_IMAGE] = 64 * 1024,
+        [DISPLAY_POOL_RING]  = 16 * 1024,
+    },
+
+    .ClientMsgBudget   = 4,
+    .ClientPixelBudget = 160 * 128 / 2,
+
+    .JobBudgetUs = 500,
+
+    .FlushOverheadNs = 0,
+    .FlushPerBytePs  = 0,
+
+    .IdleBlankMs = 0,
+
+    .ShotBytesPerSec = 8 * 1024,
+
+    .PanelGamma = 220,
+    .Brightness = 100,
+
+    /* A 160x128 frame is too small to be worth splitting */
+    .Workers = 0,
+
+    /*
+    ** Pace to the driver's vertical blank only. The ST7735 frame rate
+    ** control comes up at about 60 Hz (16667) where timer pacing is wanted.
+    */
+    .RefreshUs = 0,
 };
 
 /*
@@ -0,0 +1,200 @@
+#include "display_xfer.h"
+#include "display_image.h"
+#include "cfe_es.h"
+
+#include <string.h>
+
+/*
+** Segmented upload into an image slot. Chunks are copied straight from the
+** command into the slot's final place in the image arena, and a bitmap of
+** received sequences lets the sender query what is missing and resend only
+** that before committing.
+*/
+typedef struct
+{
+    DISPLAY_XferStatusTlm_Payload_t Status;
+    uint16                          ChunkSize;
+    uint8                           Format;
+} DISPLAY_Xfer_t;
+
+static DISPLAY_Xfer_t Xfer;
+
+#define DISPLAY_XFER_HAVE(seq) ((Xfer.Status.Received[(seq) >> 3] & (1u << ((seq)&7))) != 0)
+
+static void DISPLAY_XferReset(void)
+{
+    memset(&Xfer, 0, sizeof(Xfer));
+}
+
+/*
+** Lowest sequence not yet received, or NumChunks when complete
+*/
+static uint16 DISPLAY_XferFirstMissing(void)
+{
+    uint16 seq;
+
+    for (seq = 0; seq < Xfer.Status.NumChunks; seq++)
+    {
+        if (!DISPLAY_XFER_HAVE(seq))
+        {
+            break;
+        }
+    }
+
+    return seq;
+}
+
+CFE_Status_t DISPLAY_XferBegin(const DISPLAY_XferBeginCmd_t *Cmd)
+{
+    CFE_Status_t status;
+    uint8       *Pixels;
+    uint32       NumChunks;
+    char         Name[DISPLAY_IMAGE_NAME_LEN];
+
+    if (Cmd->ChunkSize == 0 || Cmd->ChunkSize > DISPLAY_XFER_CHUNK_MAX_BYTES || Cmd->TotalSize == 0 ||
+        Cmd->TotalSize != DISPLAY_ImageFormatSize(Cmd->Format, Cmd->Width, Cmd->Height))
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    NumChunks = (Cmd->TotalSize + Cmd->ChunkSize - 1) / Cmd->ChunkSize;
+    if (NumChunks > DISPLAY_XFER_MAX_CHUNKS)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    /* Only one transfer at a time; a new begin abandons the old one */
+    DISPLAY_XferAbort(Xfer.Status.TransferId);
+    DISPLAY_XferReset();
+
+    strncpy(Name, Cmd->Name, sizeof(Name) - 1);
+    Name[sizeof(Name) - 1] = 0;
+
+    status = DISPLAY_ImageReserve(Cmd->Slot, Name, Cmd->Width, Cmd->Height, Cmd->Format, Cmd->TotalSize, &Pixels);
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+
+    Xfer.Status.TransferId = Cmd->TransferId;
+    Xfer.Status.State      = DISPLAY_XFER_STATE_ACTIVE;
+    Xfer.Status.Slot       = Cmd->Slot;
+    Xfer.Status.NumChunks  = (uint16)NumChunks;
+    Xfer.Status.TotalSize  = Cmd->TotalSize;
+    Xfer.ChunkSize         = Cmd->ChunkSize;
+    Xfer.Format            = Cmd->Format;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t DISPLAY_XferChunk(const DISPLAY_XferChunkCmd_t *Cmd)
+{
+    uint8 *Pixels;
+    uint32 Expected;
+
+    if (Xfer.Status.State != DISPLAY_XFER_STATE_ACTIVE || Cmd->TransferId != Xfer.Status.TransferId ||
+        Cmd->Sequence >= Xfer.Status.NumChunks || Cmd->Offset != (uint32)Cmd->Sequence * Xfer.ChunkSize)
+    {
+        Xfer.Status.RejectedChunks++;
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Expected = Xfer.Status.TotalSize - Cmd->Offset;
+    if (Expected > Xfer.ChunkSize)
+    {
+        Expected = Xfer.ChunkSize;
+    }
+    if (Cmd->Length != Expected)
+    {
+        Xfer.Status.RejectedChunks++;
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    if (DISPLAY_XFER_HAVE(Cmd->Sequence))
+    {
+        Xfer.Status.DuplicateChunks++;
+        return CFE_SUCCESS;
+    }
+
+    /* The slot was taken over by another upload */
+    Pixels = DISPLAY_ImageGetLoadingPixels(Xfer.Status.Slot);
+    if (Pixels == NULL)
+    {
+        DISPLAY_XferReset();
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    memcpy(Pixels + Cmd->Offset, Cmd->Data, Cmd->Length);
+
+    Xfer.Status.Received[Cmd->Sequence >> 3] |= (uint8)(1u << (Cmd->Sequence & 7));
+    Xfer.Status.ChunksReceived++;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Complete the transfer if every chunk is in and the CRC matches. With
+** chunks missing the transfer stays open so they can be resent; a CRC
+** mismatch abandons it.
+*/
+CFE_Status_t DISPLAY_XferCommit(const DISPLAY_XferCommitCmd_t *Cmd)
+{
+    const uint8 *Pixels;
+    uint32       Crc;
+
+    Xfer.Status.FirstMissing = DISPLAY_XferFirstMissing();
+
+    if (Xfer.Status.State != DISPLAY_XFER_STATE_ACTIVE || Cmd->TransferId != Xfer.Status.TransferId)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    if (Xfer.Status.FirstMissing != Xfer.Status.NumChunks)
+    {
+        return DISPLAY_STATUS_ERROR_READ;
+    }
+
+    Pixels = DISPLAY_ImageGetLoadingPixels(Xfer.Status.Slot);
+    if (Pixels == NULL)
+    {
+        DISPLAY_XferReset();
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    Crc = CFE_ES_CalculateCRC(Pixels, Xfer.Status.TotalSize, 0, CFE_MISSION_ES_DEFAULT_CRC);
+    if (Crc != Cmd->Crc)
+    {
+        DISPLAY_XferAbort(Xfer.Status.TransferId);
+        return DISPLAY_STATUS_ERROR_CRC;
+    }
+
+    DISPLAY_ImageCommit(Xfer.Status.Slot, Xfer.Format);
+    Xfer.Status.State = DISPLAY_XFER_STATE_IDLE;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t DISPLAY_XferAbort(uint16 TransferId)
+{
+    if (Xfer.Status.State != DISPLAY_XFER_STATE_ACTIVE || TransferId != Xfer.Status.TransferId)
+    {
+        return DISPLAY_STATUS_ERROR_RANGE;
+    }
+
+    /* Only drop the slot if it still holds this transfer's partial image */
+    if (DISPLAY_ImageGetLoadingPixels(Xfer.Status.Slot) != NULL)
+    {
+        DISPLAY_ImageFree(Xfer.Status.Slot);
+    }
+
+    DISPLAY_XferReset();
+
+    return CFE_SUCCESS;
+}
+
+const DISPLAY_XferStatusTlm_Payload_t *DISPLAY_XferGetStatus(void)
+{
+    Xfer.Status.FirstMissing = DISPLAY_XferFirstMissing();
+
+    return &Xfer.Status;
+}
@@ -0,0 +1,15 @@
+#ifndef DISPLAY_XFER__H_
+#define DISPLAY_XFER__H_
+
+#include "common_types.h"
+#include "cfe_error.h"
+#include "display_msg.h"
+
+CFE_Status_t DISPLAY_XferBegin(const DISPLAY_XferBeginCmd_t *Cmd);
+CFE_Status_t DISPLAY_XferChunk(const DISPLAY_XferChunkCmd_t *Cmd);
+CFE_Status_t DISPLAY_XferCommit(const DISPLAY_XferCommitCmd_t *Cmd);
+CFE_Status_t DISPLAY_XferAbort(uint16 TransferId);
+
+const DISPLAY_XferStatusTlm_Payload_t *DISPLAY_XferGetStatus(void);
+
+#endif // DISPLAY_XFER__H_
@@ -0,0 +1,371 @@
+/*
+** display_replay: play a command log written by the display app's
+** recorder back through the flight dispatch code, on the host, into a
+** memory framebuffer.
+**
+**   display_replay [-r] [-v] [-s WxH] [-w N] [-o out.ppm] [-t tlm.bin] log.bin
+**
+**   -r       Real time: hold each message until its logged time comes
+**            round again. The default runs as fast as possible.
+**   -v       Print the app's events and system log messages.
+**   -s WxH   Panel size in device pixels (default 160x128).
+**   -w N     Band workers, in place of the table's count. The final
+**            panel must come out the same for any N.
+**   -o FILE  Write the final panel contents as a binary PPM.
+**   -t FILE  Write every packet the app sends, back to back, as a ground
+**            system would capture them.
+**
+** Prints per message type counts and host handling time, the flush
+** statistics and a checksum of the final panel that regression runs can
+** compare. Exits non-zero when the log cannot be read or when the app
+** raised error events.
+*/
+#include "replay.h"
+#include "display_app.h"
+#include "display_band.h"
+#include "display_fb.h"
+#include "display_job.h"
+#include "display_render.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REPLAY_MAX_STATS 64
+
+extern DISPLAY_Data_t  DISPLAY_Data;
+extern DISPLAY_Table_t displayTable;
+
+typedef struct
+{
+    uint8  Source;
+    uint32 MsgId;
+    uint8  CommandCode;
+    uint32 Count;
+    uint64 TotalNs;
+    uint64 MaxNs;
+} REPLAY_Stat_t;
+
+static REPLAY_Stat_t Stats[REPLAY_MAX_STATS];
+static uint32        StatCount;
+
+/* Client draw being timed, and client time spent inside the current command */
+static REPLAY_Stat_t *ClientStat;
+static uint64         ClientStart;
+static uint64         ClientNs;
+
+static uint64 REPLAY_Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000ull + (uint64)ts.tv_nsec;
+}
+
+static uint64 REPLAY_LogNs(const DISPLAY_RecordEntry_t *Entry)
+{
+    return (uint64)Entry->Seconds * 1000000000ull + (((uint64)Entry->Subseconds * 1000000000ull) >> 32);
+}
+
+static REPLAY_Stat_t *REPLAY_FindStat(const REPLAY_Record_t *Rec)
+{
+    CFE_SB_MsgId_t    MsgId;
+    CFE_MSG_FcnCode_t CommandCode;
+    uint32            i;
+
+    CFE_MSG_GetMsgId(&Rec->Msg->Msg, &MsgId);
+    CFE_MSG_GetFcnCode(&Rec->Msg->Msg, &CommandCode);
+
+    for (i = 0; i < StatCount; i++)
+    {
+        if (Stats[i].Source == Rec->Entry.Source && Stats[i].MsgId == MsgId && Stats[i].CommandCode == CommandCode)
+        {
+            return &Stats[i];
+        }
+    }
+
+    if (StatCount == REPLAY_MAX_STATS)
+    {
+        return NULL;
+    }
+
+    Stats[StatCount].Source      = Rec->Entry.Source;
+    Stats[StatCount].MsgId       = MsgId;
+    Stats[StatCount].CommandCode = CommandCode;
+
+    return &Stats[StatCount++];
+}
+
+static void REPLAY_AddTime(REPLAY_Stat_t *Stat, uint64 Ns)
+{
+    if (Stat != NULL)
+    {
+        Stat->Count++;
+        Stat->TotalNs += Ns;
+        if (Ns > Stat->MaxNs)
+        {
+            Stat->MaxNs = Ns;
+        }
+    }
+}
+
+/*
+** Client draws are timed from delivery to the next poll of any pipe, or to
+** the end of the command that serviced them
+*/
+static void REPLAY_ClientDone(uint64 Now)
+{
+    if (ClientStat != NULL)
+    {
+        REPLAY_AddTime(ClientStat, Now - ClientStart);
+        ClientNs += Now - ClientStart;
+        ClientStat = NULL;
+    }
+}
+
+void REPLAY_ClientPolled(const REPLAY_Record_t *Rec)
+{
+    REPLAY_ClientDone(REPLAY_Now());
+
+    if (Rec != NULL)
+    {
+        ClientStat  = REPLAY_FindStat(Rec);
+        ClientStart = REPLAY_Now();
+    }
+}
+
+static int REPLAY_Load(const char *Path)
+{
+    DISPLAY_RecordFileHeader_t Header;
+    DISPLAY_RecordEntry_t      Entry;
+    REPLAY_Record_t           *Rec;
+    FILE                      *f;
+    uint32                     Capacity = 0;
+    size_t                     Size;
+
+    if ((f = fopen(Path, "rb")) == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    if (fread(&Header, sizeof(Header), 1, f) != 1 || Header.Magic != DISPLAY_RECORD_MAGIC ||
+        Header.Version != DISPLAY_RECORD_VERSION || Header.EntrySize != sizeof(DISPLAY_RecordEntry_t))
+    {
+        fprintf(stderr, "%s: not a version %u command log\n", Path, DISPLAY_RECORD_VERSION);
+        fclose(f);
+        return -1;
+    }
+
+    while (fread(&Entry, sizeof(Entry), 1, f) == 1)
+    {
+        if (REPLAY_Log.Count == Capacity)
+        {
+            Capacity           = Capacity ? Capacity * 2 : 1024;
+            REPLAY_Log.Records = realloc(REPLAY_Log.Records, Capacity * sizeof(REPLAY_Record_t));
+            if (REPLAY_Log.Records == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                fclose(f);
+                return -1;
+            }
+        }
+
+        Rec        = &REPLAY_Log.Records[REPLAY_Log.Count];
+        Rec->Entry = Entry;
+        Size       = (Entry.Length > sizeof(CFE_SB_Buffer_t)) ? Entry.Length : sizeof(CFE_SB_Buffer_t);
+        Rec->Msg   = calloc(1, Size);
+
+        if (Rec->Msg == NULL || fread(Rec->Msg, 1, Entry.Length, f) != Entry.Length)
+        {
+            fprintf(stderr, "%s: truncated at entry %u\n", Path, (unsigned int)REPLAY_Log.Count);
+            free(Rec->Msg);
+            break;
+        }
+
+        REPLAY_Log.Count++;
+    }
+
+    fclose(f);
+    return 0;
+}
+
+static void REPLAY_Report(uint32 Unmatched, double Seconds)
+{
+    DISPLAY_PerfTlm_Payload_t Perf;
+    const DISPLAY_FbInfo_t   *Fb   = DISPLAY_FbGetInfo();
+    uint32                    Hash = 2166136261u;
+    uint32                    i;
+
+    printf("%-6s %-6s %3s %8s %12s %10s %10s\n", "source", "mid", "cc", "count", "total_us", "mean_us", "max_us");
+    for (i = 0; i < StatCount; i++)
+    {
+        printf("%-6s 0x%04x %3u %8u %12.1f %10.2f %10.2f\n",
+               (Stats[i].Source == DISPLAY_RECORD_SOURCE_CLIENT) ? "client" : "cmd", (unsigned int)Stats[i].MsgId,
+               (unsigned int)Stats[i].CommandCode, (unsigned int)Stats[i].Count, Stats[i].TotalNs / 1e3,
+               Stats[i].TotalNs / 1e3 / Stats[i].Count, Stats[i].MaxNs / 1e3);
+    }
+
+    DISPLAY_RenderGetPerf(&Perf);
+    printf("\nflushes %u, damage rects %u, copies %u, bytes %u\n", (unsigned int)Perf.Flushes,
+           (unsigned int)Perf.DamageRects, (unsigned int)Perf.Copies, (unsigned int)Perf.BytesCopied);
+    printf("draws culled %u, clipped %u, pixels skipped %u\n", (unsigned int)Perf.DrawsCulled,
+           (unsigned int)Perf.DrawsClipped, (unsigned int)Perf.PixelsSkipped);
+
+    if (Fb->Ptr != NULL)
+    {
+        for (i = 0; i < Fb->Size; i++)
+        {
+            Hash = (Hash ^ Fb->Ptr[i]) * 16777619u;
+        }
+    }
+
+    printf("messages %u in %.3f s, unmatched client draws %u, commands ok %u, rejected %u, error events %u\n",
+           (unsigned int)REPLAY_Log.Count, Seconds, (unsigned int)Unmatched, (unsigned int)DISPLAY_Data.CmdCounter,
+           (unsigned int)DISPLAY_Data.ErrCounter, (unsigned int)REPLAY_Log.Events);
+    printf("panel checksum %08x\n", (unsigned int)Hash);
+}
+
+static void REPLAY_Usage(const char *Prog)
+{
+    fprintf(stderr, "usage: %s [-r] [-v] [-s WxH] [-w N] [-o out.ppm] [-t tlm.bin] log.bin\n", Prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const REPLAY_Record_t *Rec;
+    REPLAY_Stat_t         *Stat;
+    const char            *OutPath  = NULL;
+    bool                   RealTime = false;
+    unsigned int           Width, Height, Workers;
+    uint32                 Unmatched = 0;
+    uint64                 WallStart, LogStart = 0, Start, End, Due;
+    struct timespec        Delay;
+    int                    opt;
+
+    while ((opt = getopt(argc, argv, "rvs:w:o:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r':
+                RealTime = true;
+                break;
+            case 'v':
+                REPLAY_Log.Verbose = true;
+                break;
+            case 's':
+                if (sscanf(optarg, "%ux%u", &Width, &Height) != 2 || Width == 0 || Height == 0)
+                {
+                    REPLAY_Usage(argv[0]);
+                    return 2;
+                }
+                REPLAY_FbSetGeometry(Width, Height);
+                break;
+            case 'w':
+                if (sscanf(optarg, "%u", &Workers) != 1 || Workers > DISPLAY_BAND_MAX_WORKERS)
+                {
+                    REPLAY_Usage(argv[0]);
+                    return 2;
+                }
+                displayTable.Workers = (uint8)Workers;
+                break;
+            case 'o':
+                OutPath = optarg;
+                break;
+            case 't':
+                REPLAY_Log.Telemetry = fopen(optarg, "wb");
+                if (REPLAY_Log.Telemetry == NULL)
+                {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            default:
+                REPLAY_Usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        REPLAY_Usage(argv[0]);
+        return 2;
+    }
+
+    if (REPLAY_Load(argv[optind]) != 0)
+    {
+        return 1;
+    }
+
+    if (DISPLAY_Init() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "display app failed to initialize\n");
+        return 1;
+    }
+
+    /* Startup events are not part of the recorded traffic */
+    REPLAY_Log.Events = 0;
+
+    if (REPLAY_Log.Count > 0)
+    {
+        LogStart = REPLAY_LogNs(&REPLAY_Log.Records[0].Entry);
+    }
+
+    WallStart = REPLAY_Now();
+
+    while (REPLAY_Log.Next < REPLAY_Log.Count)
+    {
+        Rec = &REPLAY_Log.Records[REPLAY_Log.Next++];
+
+        /* Client draws are only delivered when the app polls their pipe */
+        if (Rec->Entry.Source != DISPLAY_RECORD_SOURCE_CMD)
+        {
+            Unmatched++;
+            continue;
+        }
+
+        if (RealTime)
+        {
+            Due = WallStart + (REPLAY_LogNs(&Rec->Entry) - LogStart);
+            Start = REPLAY_Now();
+            if (Due > Start)
+            {
+                Delay.tv_sec  = (time_t)((Due - Start) / 1000000000ull);
+                Delay.tv_nsec = (long)((Due - Start) % 1000000000ull);
+                nanosleep(&Delay, NULL);
+            }
+        }
+
+        Stat     = REPLAY_FindStat(Rec);
+        ClientNs = 0;
+        Start    = REPLAY_Now();
+
+        DISPLAY_ProcessCommandPacket(Rec->Msg);
+
+        /* The app's main loop runs a slice of any job after each message */
+        DISPLAY_JobRun();
+
+        End = REPLAY_Now();
+        REPLAY_ClientDone(End);
+        REPLAY_AddTime(Stat, (End - Start) - ClientNs);
+    }
+
+    DISPLAY_JobFinish();
+
+    REPLAY_Report(Unmatched, (REPLAY_Now() - WallStart) / 1e9);
+
+    if (OutPath != NULL && REPLAY_FbWritePpm(OutPath) != 0)
+    {
+        perror(OutPath);
+        return 1;
+    }
+
+    if (REPLAY_Log.Telemetry != NULL)
+    {
+        fclose(REPLAY_Log.Telemetry);
+    }
+
+    return (REPLAY_Log.Events == 0) ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+/*
+** Shared state of the command log replay tool
+*/
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdio.h>
+
+#include "common_types.h"
+#include "cfe_sb.h"
+#include "display_record.h"
+
+/*
+** One log entry, with its message copied to a buffer aligned the way the
+** software bus would deliver it
+*/
+typedef struct
+{
+    DISPLAY_RecordEntry_t Entry;
+    CFE_SB_Buffer_t      *Msg;
+} REPLAY_Record_t;
+
+typedef struct
+{
+    REPLAY_Record_t *Records;
+    uint32           Count;
+    uint32           Next;    /* First record not yet delivered */
+    bool             Verbose; /* Print events and syslog output */
+    uint32           Events;  /* Error events raised by the app */
+    FILE            *Telemetry; /* Packets the app sends, when set */
+} REPLAY_Log_t;
+
+extern REPLAY_Log_t REPLAY_Log;
+
+/* Called by the bus shim on every pipe poll, with the client draw delivered if any */
+void REPLAY_ClientPolled(const REPLAY_Record_t *Rec);
+
+void REPLAY_FbSetGeometry(uint32 Width, uint32 Height);
+int  REPLAY_FbWritePpm(const char *Path);
+
+#endif /* REPLAY_H */
@@ -0,0 +1,160 @@
+/*
+** Framebuffer stand-in for the replay tool: the display_fb.h interface
+** over an RGB565 panel in ordinary memory, which can be written out as a
+** PPM image once the log has played.
+*/
+#include "replay.h"
+#include "display_fb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32           PanelWidth  = 160;
+static uint32           PanelHeight = 128;
+static DISPLAY_FbInfo_t FBInfo;
+
+void REPLAY_FbSetGeometry(uint32 Width, uint32 Height)
+{
+    PanelWidth  = Width;
+    PanelHeight = Height;
+}
+
+CFE_Status_t DISPLAY_FbInit(const DISPLAY_Table_t *TblPtr)
+{
+    DISPLAY_FbClose();
+
+    FBInfo.BytesPerPixel = 2;
+    FBInfo.Width         = PanelWidth;
+    FBInfo.Height        = PanelHeight;
+    FBInfo.LineLength    = PanelWidth * FBInfo.BytesPerPixel;
+    FBInfo.Size          = FBInfo.LineLength * PanelHeight;
+    FBInfo.Ptr           = calloc(1, FBInfo.Size);
+    if (FBInfo.Ptr == NULL)
+    {
+        return DISPLAY_STATUS_ERROR_NOMEM;
+    }
+
+    FBInfo.Format.RedOffset     = 11;
+    FBInfo.Format.RedLength     = 5;
+    FBInfo.Format.GreenOffset   = 5;
+    FBInfo.Format.GreenLength   = 6;
+    FBInfo.Format.BlueOffset    = 0;
+    FBInfo.Format.BlueLength    = 5;
+    FBInfo.Format.BytesPerPixel = 2;
+    FBInfo.Vsync                = true;
+    FBInfo.Generation++;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t DISPLAY_FbCheck(const DISPLAY_Table_t *TblPtr)
+{
+    return (FBInfo.Ptr != NULL) ? CFE_SUCCESS : DISPLAY_FbInit(TblPtr);
+}
+
+void DISPLAY_FbClose(void)
+{
+    free(FBInfo.Ptr);
+    FBInfo.Ptr    = NULL;
+    FBInfo.Width  = 0;
+    FBInfo.Height = 0;
+    FBInfo.Size   = 0;
+}
+
+CFE_Status_t DISPLAY_FbBlank(bool Blank)
+{
+    return (FBInfo.Ptr != NULL) ? CFE_SUCCESS : DISPLAY_STATUS_ERROR_OPEN;
+}
+
+/*
+** The replayed panel is always between refreshes, so flushes never wait
+*/
+CFE_Status_t DISPLAY_FbWaitVsync(void)
+{
+    return (FBInfo.Ptr != NULL) ? CFE_SUCCESS : DISPLAY_STATUS_ERROR_OPEN;
+}
+
+bool DISPLAY_FbIsMapped(void)
+{
+    return (FBInfo.Ptr != NULL);
+}
+
+const DISPLAY_FbInfo_t *DISPLAY_FbGetInfo(void)
+{
+    return &FBInfo;
+}
+
+/*
+** Same contract as the device version, one pixel at a time: speed here
+** is not representative of the panel and is not reported.
+*/
+void DISPLAY_FbPresent(const DISPLAY_Surface_t *Src, const DISPLAY_Rect_t *Rect, uint8 Rotation)
+{
+    DISPLAY_Rect_t Clip = *Rect;
+    uint32         dx, dy;
+    int32          x, y;
+
+    if (FBInfo.Ptr == NULL || Src->Pixels == NULL || Src->Format.BytesPerPixel != 2 ||
+        !DISPLAY_RectClipToSurface(&Clip, Src))
+    {
+        return;
+    }
+
+    for (y = Clip.Y; y < Clip.Y + Clip.H; y++)
+    {
+        for (x = Clip.X; x < Clip.X + Clip.W; x++)
+        {
+            switch (Rotation)
+            {
+                case DISPLAY_ROTATE_90:
+                    dx = FBInfo.Width - 1 - y;
+                    dy = x;
+                    break;
+                case DISPLAY_ROTATE_180:
+                    dx = FBInfo.Width - 1 - x;
+                    dy = FBInfo.Height - 1 - y;
+                    break;
+                case DISPLAY_ROTATE_270:
+                    dx = y;
+                    dy = FBInfo.Height - 1 - x;
+                    break;
+                default:
+                    dx = x;
+                    dy = y;
+                    break;
+            }
+
+            if (dx < FBInfo.Width && dy < FBInfo.Height)
+            {
+                memcpy(FBInfo.Ptr + dy * FBInfo.LineLength + dx * 2, Src->Pixels + y * Src->Stride + x * 2, 2);
+            }
+        }
+    }
+}
+
+int REPLAY_FbWritePpm(const char *Path)
+{
+    FILE  *f;
+    uint16 p;
+    uint8  rgb[3];
+    uint32 i;
+
+    if (FBInfo.Ptr == NULL || (f = fopen(Path, "wb")) == NULL)
+    {
+        return -1;
+    }
+
+    fprintf(f, "P6\n%u %u\n255\n", (unsigned int)FBInfo.Width, (unsigned int)FBInfo.Height);
+
+    for (i = 0; i < FBInfo.Width * FBInfo.Height; i++)
+    {
+        memcpy(&p, FBInfo.Ptr + i * 2, 2);
+        rgb[0] = (uint8)(((p >> 11) & 0x1F) << 3);
+        rgb[1] = (uint8)(((p >> 5) & 0x3F) << 2);
+        rgb[2] = (uint8)((p & 0x1F) << 3);
+        fwrite(rgb, 1, 3, f);
+    }
+
+    return (fclose(f) == 0) ? 0 : -1;
+}
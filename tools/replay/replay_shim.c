@@ -0,0 +1,543 @@
+/*
+** Host implementations of the cFE and OSAL calls declared in
+** shim/replay_cfe.h. The software bus serves client draw pipes from the
+** log: a poll of a client pipe returns the next log record only when it is
+** a client message subscribed to that pipe, which reproduces the order in
+** which the flight app serviced its clients.
+*/
+#include "replay.h"
+#include "display_table.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+REPLAY_Log_t REPLAY_Log;
+
+extern DISPLAY_Table_t displayTable;
+
+#define REPLAY_MAX_PIPES 16
+#define REPLAY_MAX_SUBS  64
+#define REPLAY_MAX_TASKS 8
+#define REPLAY_MAX_SEMS  4
+
+typedef struct
+{
+    CFE_SB_MsgId_t  MsgId;
+    CFE_SB_PipeId_t PipeId;
+} REPLAY_Sub_t;
+
+static bool         PipeUsed[REPLAY_MAX_PIPES];
+static REPLAY_Sub_t Subs[REPLAY_MAX_SUBS];
+static uint32       SubCount;
+
+typedef struct
+{
+    bool                      Used;
+    pthread_t                 Thread;
+    CFE_ES_TaskEntryFuncPtr_t Entry;
+} REPLAY_Task_t;
+
+static REPLAY_Task_t Tasks[REPLAY_MAX_TASKS];
+static bool          SemUsed[REPLAY_MAX_SEMS];
+static sem_t         Sems[REPLAY_MAX_SEMS];
+
+/*
+** Messages
+*/
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+    memset(MsgPtr, 0, Size);
+    MsgPtr->Byte[0] = (uint8)(MsgId >> 8);
+    MsgPtr->Byte[1] = (uint8)MsgId;
+    MsgPtr->Byte[2] = 0xC0; /* Unsegmented */
+    MsgPtr->Byte[4] = (uint8)((Size - 7) >> 8);
+    MsgPtr->Byte[5] = (uint8)(Size - 7);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+    *MsgId = ((uint32)MsgPtr->Byte[0] << 8 | MsgPtr->Byte[1]) & 0x1FFF;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+    *FcnCode = ((const CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode & 0x7F;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+    *Size = ((size_t)MsgPtr->Byte[4] << 8 | MsgPtr->Byte[5]) + 7;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size)
+{
+    MsgPtr->Byte[4] = (uint8)((Size - 7) >> 8);
+    MsgPtr->Byte[5] = (uint8)(Size - 7);
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode)
+{
+    ((CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode = FcnCode & 0x7F;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Software bus
+*/
+bool CFE_SB_IsValidMsgId(CFE_SB_MsgId_t MsgId)
+{
+    return (MsgId != CFE_SB_INVALID_MSG_ID && MsgId <= 0x1FFF);
+}
+
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+    uint32 i;
+
+    for (i = 0; i < REPLAY_MAX_PIPES; i++)
+    {
+        if (!PipeUsed[i])
+        {
+            PipeUsed[i] = true;
+            *PipeIdPtr  = i;
+            return CFE_SUCCESS;
+        }
+    }
+
+    return CFE_SB_MAX_PIPES_MET;
+}
+
+CFE_Status_t CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId)
+{
+    uint32 i = 0;
+
+    if (PipeId >= REPLAY_MAX_PIPES || !PipeUsed[PipeId])
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    PipeUsed[PipeId] = false;
+
+    while (i < SubCount)
+    {
+        if (Subs[i].PipeId == PipeId)
+        {
+            Subs[i] = Subs[--SubCount];
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+    if (PipeId >= REPLAY_MAX_PIPES || !PipeUsed[PipeId] || SubCount >= REPLAY_MAX_SUBS)
+    {
+        return CFE_SB_BAD_ARGUMENT;
+    }
+
+    Subs[SubCount].MsgId  = MsgId;
+    Subs[SubCount].PipeId = PipeId;
+    SubCount++;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+    const REPLAY_Record_t *Rec;
+    CFE_SB_MsgId_t         MsgId;
+    uint32                 i;
+
+    REPLAY_ClientPolled(NULL);
+
+    if (REPLAY_Log.Next >= REPLAY_Log.Count)
+    {
+        return CFE_SB_NO_MESSAGE;
+    }
+
+    Rec = &REPLAY_Log.Records[REPLAY_Log.Next];
+    if (Rec->Entry.Source != DISPLAY_RECORD_SOURCE_CLIENT)
+    {
+        return CFE_SB_NO_MESSAGE;
+    }
+
+    CFE_MSG_GetMsgId(&Rec->Msg->Msg, &MsgId);
+
+    for (i = 0; i < SubCount; i++)
+    {
+        if (Subs[i].PipeId == PipeId && Subs[i].MsgId == MsgId)
+        {
+            REPLAY_Log.Next++;
+            REPLAY_ClientPolled(Rec);
+            *BufPtr = Rec->Msg;
+            return CFE_SUCCESS;
+        }
+    }
+
+    return CFE_SB_NO_MESSAGE;
+}
+
+/*
+** Sent packets are appended to the telemetry file, when there is one
+*/
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+    CFE_MSG_Size_t Size;
+
+    if (REPLAY_Log.Telemetry != NULL)
+    {
+        CFE_MSG_GetSize(MsgPtr, &Size);
+        fwrite(MsgPtr, 1, Size, REPLAY_Log.Telemetry);
+    }
+
+    return CFE_SUCCESS;
+}
+
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr) {}
+
+/*
+** Nothing in a replay draws through display_lib, which alone asks for
+** buffers
+*/
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize)
+{
+    return NULL;
+}
+
+CFE_Status_t CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount)
+{
+    return CFE_SB_TransmitMsg(&BufPtr->Msg, IncrementSequenceCount);
+}
+
+/*
+** Time: the log time of the message being replayed
+*/
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+    CFE_TIME_SysTime_t Now = {0, 0};
+    uint32             Last;
+
+    if (REPLAY_Log.Next > 0)
+    {
+        Last           = REPLAY_Log.Next - 1;
+        Now.Seconds    = REPLAY_Log.Records[Last].Entry.Seconds;
+        Now.Subseconds = REPLAY_Log.Records[Last].Entry.Subseconds;
+    }
+
+    return Now;
+}
+
+/*
+** Only telemetry headers carry a time in this layout, and only commands
+** are asked for one
+*/
+CFE_Status_t CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time)
+{
+    return CFE_MSG_WRONG_MSG_TYPE;
+}
+
+/*
+** Events and system log
+*/
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    va_list ap;
+
+    if (EventType >= CFE_EVS_EventType_ERROR)
+    {
+        REPLAY_Log.Events++;
+    }
+
+    if (REPLAY_Log.Verbose)
+    {
+        fprintf(stderr, "EVS %u/%u: ", (unsigned int)EventID, (unsigned int)EventType);
+        va_start(ap, Spec);
+        vfprintf(stderr, Spec, ap);
+        va_end(ap);
+        fputc('\n', stderr);
+    }
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+    va_list ap;
+
+    if (REPLAY_Log.Verbose)
+    {
+        fputs("SYSLOG: ", stderr);
+        va_start(ap, SpecStringPtr);
+        vfprintf(stderr, SpecStringPtr, ap);
+        va_end(ap);
+        fputc('\n', stderr);
+    }
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Executive services
+*/
+bool CFE_ES_RunLoop(uint32 *RunStatus)
+{
+    return false;
+}
+
+void CFE_ES_ExitApp(uint32 ExitStatus) {}
+
+void CFE_ES_PerfLogEntry(uint32 Marker) {}
+
+void CFE_ES_PerfLogExit(uint32 Marker) {}
+
+/*
+** Child tasks. Ids are the slot number plus one so that 0 stays undefined.
+** Priority and stack size are left to the host.
+*/
+static void *REPLAY_TaskEntry(void *Arg)
+{
+    ((REPLAY_Task_t *)Arg)->Entry();
+
+    return NULL;
+}
+
+CFE_Status_t CFE_ES_CreateChildTask(CFE_ES_TaskId_t *TaskIdPtr, const char *TaskName,
+                                    CFE_ES_TaskEntryFuncPtr_t FunctionPtr, CFE_ES_StackPointer_t StackPtr,
+                                    size_t StackSize, uint16 Priority, uint32 Flags)
+{
+    uint32 i;
+
+    for (i = 0; i < REPLAY_MAX_TASKS; i++)
+    {
+        if (!Tasks[i].Used)
+        {
+            Tasks[i].Entry = FunctionPtr;
+            if (pthread_create(&Tasks[i].Thread, NULL, REPLAY_TaskEntry, &Tasks[i]) != 0)
+            {
+                break;
+            }
+
+            Tasks[i].Used = true;
+            *TaskIdPtr    = i + 1;
+            return CFE_SUCCESS;
+        }
+    }
+
+    return (CFE_Status_t)(CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE);
+}
+
+CFE_Status_t CFE_ES_DeleteChildTask(CFE_ES_TaskId_t TaskId)
+{
+    REPLAY_Task_t *Task;
+
+    if (TaskId == 0 || TaskId > REPLAY_MAX_TASKS || !Tasks[TaskId - 1].Used)
+    {
+        return (CFE_Status_t)(CFE_SEVERITY_ERROR | CFE_GENERIC_SERVICE);
+    }
+
+    Task = &Tasks[TaskId - 1];
+    pthread_cancel(Task->Thread);
+    pthread_join(Task->Thread, NULL);
+    Task->Used = false;
+
+    return CFE_SUCCESS;
+}
+
+void CFE_ES_ExitChildTask(void)
+{
+    pthread_exit(NULL);
+}
+
+/*
+** CRC-16 as computed by CFE_ES_CalculateCRC (reflected 0x8005)
+*/
+uint32 CFE_ES_CalculateCRC(const void *DataPtr, size_t DataLength, uint32 InputCRC, uint32 TypeCRC)
+{
+    const uint8 *p   = DataPtr;
+    uint16       Crc = (uint16)InputCRC;
+    int          b;
+
+    while (DataLength-- > 0)
+    {
+        Crc ^= *p++;
+        for (b = 0; b < 8; b++)
+        {
+            Crc = (Crc & 1) ? (uint16)((Crc >> 1) ^ 0xA001) : (uint16)(Crc >> 1);
+        }
+    }
+
+    return Crc;
+}
+
+/*
+** Tables. Loads are not validated: the device the table names does not
+** exist on the host.
+*/
+CFE_Status_t CFE_TBL_Register(CFE_TBL_Handle_t *TblHandlePtr, const char *Name, size_t Size, uint16 TblOptionFlags,
+                              CFE_TBL_CallbackFuncPtr_t TblValidationFuncPtr)
+{
+    *TblHandlePtr = 0;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_Load(CFE_TBL_Handle_t TblHandle, int SrcType, const void *SrcDataPtr)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle)
+{
+    *TblPtr = &displayTable;
+
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_Manage(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_TBL_GetInfo(CFE_TBL_Info_t *TblInfoPtr, const char *TblName)
+{
+    memset(TblInfoPtr, 0, sizeof(*TblInfoPtr));
+    TblInfoPtr->Size = sizeof(displayTable);
+
+    return CFE_SUCCESS;
+}
+
+/*
+** Files. OSAL ids are the POSIX descriptor plus one so that 0 stays
+** undefined.
+*/
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access)
+{
+    int Mode = (access == OS_WRITE_ONLY) ? O_WRONLY : (access == OS_READ_WRITE) ? O_RDWR : O_RDONLY;
+    int fd;
+
+    if (flags & OS_FILE_FLAG_CREATE)
+    {
+        Mode |= O_CREAT;
+    }
+    if (flags & OS_FILE_FLAG_TRUNCATE)
+    {
+        Mode |= O_TRUNC;
+    }
+
+    fd = open(path, Mode, 0644);
+    if (fd < 0)
+    {
+        return OS_ERROR;
+    }
+
+    *filedes = (osal_id_t)fd + 1;
+
+    return OS_SUCCESS;
+}
+
+int32 OS_close(osal_id_t filedes)
+{
+    return (close((int)filedes - 1) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes)
+{
+    ssize_t n = write((int)filedes - 1, buffer, nbytes);
+
+    return (n < 0) ? OS_ERROR : (int32)n;
+}
+
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes)
+{
+    ssize_t n = read((int)filedes - 1, buffer, nbytes);
+
+    return (n < 0) ? OS_ERROR : (int32)n;
+}
+
+/*
+** Counting semaphores, ids as for child tasks
+*/
+int32 OS_CountSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options)
+{
+    uint32 i;
+
+    for (i = 0; i < REPLAY_MAX_SEMS; i++)
+    {
+        if (!SemUsed[i] && sem_init(&Sems[i], 0, sem_initial_value) == 0)
+        {
+            SemUsed[i] = true;
+            *sem_id    = i + 1;
+            return OS_SUCCESS;
+        }
+    }
+
+    return OS_ERROR;
+}
+
+int32 OS_CountSemDelete(osal_id_t sem_id)
+{
+    if (sem_id == 0 || sem_id > REPLAY_MAX_SEMS || !SemUsed[sem_id - 1])
+    {
+        return OS_ERROR;
+    }
+
+    sem_destroy(&Sems[sem_id - 1]);
+    SemUsed[sem_id - 1] = false;
+
+    return OS_SUCCESS;
+}
+
+int32 OS_CountSemGive(osal_id_t sem_id)
+{
+    return (sem_id != 0 && sem_id <= REPLAY_MAX_SEMS && sem_post(&Sems[sem_id - 1]) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_CountSemTake(osal_id_t sem_id)
+{
+    if (sem_id == 0 || sem_id > REPLAY_MAX_SEMS)
+    {
+        return OS_ERROR;
+    }
+
+    while (sem_wait(&Sems[sem_id - 1]) != 0)
+    {
+        /* interrupted by a signal; wait again */
+    }
+
+    return OS_SUCCESS;
+}
@@ -0,0 +1 @@
+#include "replay_cfe.h"
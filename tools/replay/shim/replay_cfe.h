@@ -0,0 +1,234 @@
+/*
+** Host stand-ins for the cFE and OSAL interfaces used by the display app,
+** just enough to run the flight sources in the replay tool. Message
+** headers follow the CCSDS version 1 layout of the default cFE build so
+** logs recorded on the target parse unchanged.
+*/
+#ifndef REPLAY_CFE_H
+#define REPLAY_CFE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+typedef int8_t   int8;
+typedef int16_t  int16;
+typedef int32_t  int32;
+typedef int64_t  int64;
+
+typedef int32  CFE_Status_t;
+typedef uint32 osal_id_t;
+
+#define CFE_SUCCESS         ((CFE_Status_t)0)
+#define CFE_SEVERITY_ERROR  0xc0000000
+#define CFE_GENERIC_SERVICE 0x0e000000
+#define CFE_SB_NO_MESSAGE   ((CFE_Status_t)0xca00000e)
+#define CFE_SB_BAD_ARGUMENT ((CFE_Status_t)0xca000002)
+#define CFE_SB_MAX_PIPES_MET ((CFE_Status_t)0xca000004)
+#define CFE_MSG_WRONG_MSG_TYPE ((CFE_Status_t)0xcb000003)
+
+#define CFE_MISSION_MAX_API_LEN    20
+#define CFE_MISSION_ES_DEFAULT_CRC 2
+#define PORT_NAME_SIZE             32
+
+/*
+** Software bus messages
+*/
+typedef struct
+{
+    uint8 Byte[6]; /* CCSDS primary header, big endian */
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8             FunctionCode; /* Bit 7 reserved */
+    uint8             Checksum;
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8             Time[6];
+    uint8             Spare[4];
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+    CFE_MSG_Message_t Msg;
+    long long int     LongInt;
+    long double       LongDouble;
+} CFE_SB_Buffer_t;
+
+typedef uint32 CFE_SB_MsgId_t;
+typedef uint32 CFE_SB_PipeId_t;
+typedef uint8  CFE_MSG_FcnCode_t;
+typedef size_t CFE_MSG_Size_t;
+
+#define CFE_SB_INVALID_MSG_ID ((CFE_SB_MsgId_t)0)
+#define CFE_SB_PEND_FOREVER   (-1)
+#define CFE_SB_POLL           0
+
+static inline CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 Value)
+{
+    return Value;
+}
+
+static inline uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId)
+{
+    return MsgId;
+}
+
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+CFE_Status_t CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode);
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+CFE_Status_t CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+CFE_Status_t CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode);
+
+bool         CFE_SB_IsValidMsgId(CFE_SB_MsgId_t MsgId);
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+CFE_Status_t CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId);
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+void         CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize);
+CFE_Status_t     CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr);
+CFE_Status_t     CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount);
+
+/*
+** Time
+*/
+typedef struct
+{
+    uint32 Seconds;
+    uint32 Subseconds;
+} CFE_TIME_SysTime_t;
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+CFE_Status_t       CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time);
+
+/*
+** Events
+*/
+typedef struct
+{
+    uint16 EventID;
+    uint16 Mask;
+} CFE_EVS_BinFilter_t;
+
+enum
+{
+    CFE_EVS_EventType_DEBUG       = 1,
+    CFE_EVS_EventType_INFORMATION = 2,
+    CFE_EVS_EventType_ERROR       = 3,
+    CFE_EVS_EventType_CRITICAL    = 4
+};
+
+#define CFE_EVS_EventFilter_BINARY 0
+
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme);
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/*
+** Executive services
+*/
+enum
+{
+    CFE_ES_RunStatus_UNDEFINED = 0,
+    CFE_ES_RunStatus_APP_RUN   = 1,
+    CFE_ES_RunStatus_APP_EXIT  = 2,
+    CFE_ES_RunStatus_APP_ERROR = 3
+};
+
+bool         CFE_ES_RunLoop(uint32 *RunStatus);
+void         CFE_ES_ExitApp(uint32 ExitStatus);
+void         CFE_ES_PerfLogEntry(uint32 Marker);
+void         CFE_ES_PerfLogExit(uint32 Marker);
+CFE_Status_t CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...) __attribute__((format(printf, 1, 2)));
+uint32       CFE_ES_CalculateCRC(const void *DataPtr, size_t DataLength, uint32 InputCRC, uint32 TypeCRC);
+
+/*
+** Child tasks run as host threads
+*/
+typedef uint32 CFE_ES_TaskId_t;
+typedef void (*CFE_ES_TaskEntryFuncPtr_t)(void);
+typedef void *CFE_ES_StackPointer_t;
+
+#define CFE_ES_TASK_STACK_ALLOCATE NULL
+
+CFE_Status_t CFE_ES_CreateChildTask(CFE_ES_TaskId_t *TaskIdPtr, const char *TaskName,
+                                    CFE_ES_TaskEntryFuncPtr_t FunctionPtr, CFE_ES_StackPointer_t StackPtr,
+                                    size_t StackSize, uint16 Priority, uint32 Flags);
+CFE_Status_t CFE_ES_DeleteChildTask(CFE_ES_TaskId_t TaskId);
+void         CFE_ES_ExitChildTask(void);
+
+/*
+** Tables. There is a single table, the default image linked in from
+** display_tbl.c.
+*/
+typedef int16 CFE_TBL_Handle_t;
+
+#define CFE_TBL_OPT_DEFAULT 0
+#define CFE_TBL_SRC_FILE    0
+
+typedef struct
+{
+    size_t Size;
+    uint32 NumUsers;
+    uint32 FileCreateTimeSecs;
+    uint32 Crc;
+} CFE_TBL_Info_t;
+
+typedef int32 (*CFE_TBL_CallbackFuncPtr_t)(void *TblPtr);
+
+CFE_Status_t CFE_TBL_Register(CFE_TBL_Handle_t *TblHandlePtr, const char *Name, size_t Size, uint16 TblOptionFlags,
+                              CFE_TBL_CallbackFuncPtr_t TblValidationFuncPtr);
+CFE_Status_t CFE_TBL_Load(CFE_TBL_Handle_t TblHandle, int SrcType, const void *SrcDataPtr);
+CFE_Status_t CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle);
+CFE_Status_t CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle);
+CFE_Status_t CFE_TBL_Manage(CFE_TBL_Handle_t TblHandle);
+CFE_Status_t CFE_TBL_GetInfo(CFE_TBL_Info_t *TblInfoPtr, const char *TblName);
+
+#define CFE_TBL_FILEDEF(ObjName, TblName, Desc, Filename)
+
+/*
+** OSAL files, mapped straight onto POSIX descriptors
+*/
+#define OS_SUCCESS            0
+#define OS_ERROR              (-1)
+#define OS_READ_ONLY          0
+#define OS_WRITE_ONLY         1
+#define OS_READ_WRITE         2
+#define OS_FILE_FLAG_CREATE   1
+#define OS_FILE_FLAG_TRUNCATE 2
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access);
+int32 OS_close(osal_id_t filedes);
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes);
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes);
+
+/*
+** OSAL counting semaphores, on POSIX semaphores
+*/
+#define OS_MAX_API_NAME        20
+#define OS_OBJECT_ID_UNDEFINED ((osal_id_t)0)
+
+static inline bool OS_ObjectIdDefined(osal_id_t object_id)
+{
+    return object_id != OS_OBJECT_ID_UNDEFINED;
+}
+
+int32 OS_CountSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options);
+int32 OS_CountSemDelete(osal_id_t sem_id);
+int32 OS_CountSemGive(osal_id_t sem_id);
+int32 OS_CountSemTake(osal_id_t sem_id);
+
+#endif /* REPLAY_CFE_H */
@@ -0,0 +1,365 @@
+/*
+** display_shot: rebuild the display app's screenshots from its telemetry.
+**
+**   display_shot [-H bytes] [-o prefix] tlm.bin
+**
+**   -H N       Telemetry header length ahead of the payload (default: that
+**              of the build's cFE message headers).
+**   -o PREFIX  Output name prefix (default "shot"). Each completed capture
+**              is written as PREFIX-NNNNN.ppm, NNNNN being its number.
+**
+** Input is raw CCSDS packets back to back, as a ground system captures
+** them; packets other than the screenshot stream are skipped. Delta
+** captures are applied over the frame rebuilt so far, so a stream must
+** start with a full capture. Lost packets and incomplete captures are
+** reported, and the exit status is non-zero if there were any.
+*/
+#include "common_types.h"
+#include "display_msg.h"
+#include "display_msgids.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SHOT_MAX_PACKET 0x10007 /* Largest CCSDS packet */
+
+typedef struct
+{
+    uint8  *Pixels; /* Frame rebuilt so far */
+    uint16  Width;
+    uint16  Height;
+    uint8   Bpp;
+    bool    HaveBase; /* A full capture has been applied */
+
+    bool   InCapture;
+    uint16 CaptureId;
+    uint16 NextSequence;
+    uint32 TilesSeen;
+    uint16 Tiles;
+
+    uint32 Problems;
+} SHOT_State_t;
+
+static SHOT_State_t Shot;
+
+/*
+** Expand one PackBits tile record into Out, Count pixels of Bpp bytes.
+** Returns false if the record is malformed.
+*/
+static bool SHOT_Unpack(uint8 *Out, uint32 Count, uint32 Bpp, const uint8 *In, uint32 Length)
+{
+    uint32 i = 0;
+    uint32 n, c;
+
+    while (Length > 0 && i < Count)
+    {
+        c = *In++;
+        Length--;
+
+        if (c < 128)
+        {
+            n = c + 1;
+            if (i + n > Count || n * Bpp > Length)
+            {
+                return false;
+            }
+            memcpy(Out + (i * Bpp), In, n * Bpp);
+            In += n * Bpp;
+            Length -= n * Bpp;
+        }
+        else
+        {
+            n = c - 126;
+            if (i + n > Count || Bpp > Length)
+            {
+                return false;
+            }
+            for (c = 0; c < n; c++)
+            {
+                memcpy(Out + ((i + c) * Bpp), In, Bpp);
+            }
+            In += Bpp;
+            Length -= Bpp;
+        }
+
+        i += n;
+    }
+
+    return (i == Count && Length == 0);
+}
+
+static uint8 SHOT_Channel(uint32 Pixel, uint8 Offset, uint8 Length)
+{
+    if (Length == 0 || Length > 8)
+    {
+        return 0;
+    }
+
+    return (uint8)(((Pixel >> Offset) & ((1u << Length) - 1)) << (8 - Length));
+}
+
+static int SHOT_WritePpm(const char *Prefix, const DISPLAY_ShotTlm_Payload_t *P)
+{
+    char   Path[256];
+    FILE  *f;
+    uint32 Pixel;
+    uint8  rgb[3];
+    uint32 i;
+
+    snprintf(Path, sizeof(Path), "%s-%05u.ppm", Prefix, (unsigned int)P->CaptureId);
+
+    if ((f = fopen(Path, "wb")) == NULL)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    fprintf(f, "P6\n%u %u\n255\n", (unsigned int)Shot.Width, (unsigned int)Shot.Height);
+
+    for (i = 0; i < (uint32)Shot.Width * Shot.Height; i++)
+    {
+        Pixel = 0;
+        memcpy(&Pixel, Shot.Pixels + (i * Shot.Bpp), Shot.Bpp);
+        rgb[0] = SHOT_Channel(Pixel, P->RedOffset, P->RedLength);
+        rgb[1] = SHOT_Channel(Pixel, P->GreenOffset, P->GreenLength);
+        rgb[2] = SHOT_Channel(Pixel, P->BlueOffset, P->BlueLength);
+        fwrite(rgb, 1, 3, f);
+    }
+
+    if (fclose(f) != 0)
+    {
+        perror(Path);
+        return -1;
+    }
+
+    printf("%s: capture %u, %u tiles%s\n", Path, (unsigned int)P->CaptureId, (unsigned int)P->Tiles,
+           (P->Flags & DISPLAY_SHOT_FLAG_DELTA) ? " changed" : "");
+
+    return 0;
+}
+
+static void SHOT_EndCapture(void)
+{
+    if (Shot.InCapture && Shot.TilesSeen != Shot.Tiles)
+    {
+        fprintf(stderr, "capture %u incomplete: %u of %u tiles\n", (unsigned int)Shot.CaptureId,
+                (unsigned int)Shot.TilesSeen, (unsigned int)Shot.Tiles);
+        Shot.Problems++;
+    }
+
+    Shot.InCapture = false;
+}
+
+/*
+** Apply one screenshot packet
+*/
+static void SHOT_Packet(const DISPLAY_ShotTlm_Payload_t *P, uint32 Length, const char *Prefix)
+{
+    DISPLAY_ShotTileHeader_t Header;
+    uint8                    Tile[DISPLAY_CRC_TILE * DISPLAY_CRC_TILE * 4];
+    uint32                   TilesX, Used = 0;
+    uint32                   x0, y0, w, h, y, i;
+
+    if (Length < offsetof(DISPLAY_ShotTlm_Payload_t, Data) ||
+        Length < offsetof(DISPLAY_ShotTlm_Payload_t, Data) + P->DataLength || P->BytesPerPixel == 0 ||
+        P->BytesPerPixel > 4 || P->Width == 0 || P->Height == 0)
+    {
+        fprintf(stderr, "malformed screenshot packet\n");
+        Shot.Problems++;
+        return;
+    }
+
+    if (!Shot.InCapture || P->CaptureId != Shot.CaptureId)
+    {
+        SHOT_EndCapture();
+
+        if (P->Sequence != 0)
+        {
+            fprintf(stderr, "capture %u: first %u packets lost\n", (unsigned int)P->CaptureId,
+                    (unsigned int)P->Sequence);
+            Shot.Problems++;
+        }
+
+        Shot.InCapture    = true;
+        Shot.CaptureId    = P->CaptureId;
+        Shot.NextSequence = P->Sequence;
+        Shot.TilesSeen    = 0;
+        Shot.Tiles        = P->Tiles;
+    }
+
+    if (P->Sequence != Shot.NextSequence)
+    {
+        fprintf(stderr, "capture %u: packets %u to %u lost\n", (unsigned int)P->CaptureId,
+                (unsigned int)Shot.NextSequence, (unsigned int)P->Sequence - 1);
+        Shot.Problems++;
+    }
+    Shot.NextSequence = P->Sequence + 1;
+
+    /* A new geometry starts from a blank frame */
+    if (Shot.Pixels == NULL || Shot.Width != P->Width || Shot.Height != P->Height || Shot.Bpp != P->BytesPerPixel)
+    {
+        free(Shot.Pixels);
+        Shot.Width    = P->Width;
+        Shot.Height   = P->Height;
+        Shot.Bpp      = P->BytesPerPixel;
+        Shot.HaveBase = false;
+        Shot.Pixels   = calloc((size_t)Shot.Width * Shot.Height, Shot.Bpp);
+        if (Shot.Pixels == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+
+    TilesX = (Shot.Width + DISPLAY_CRC_TILE - 1) / DISPLAY_CRC_TILE;
+
+    for (i = 0; i < P->TileCount; i++)
+    {
+        if (Used + sizeof(Header) > P->DataLength)
+        {
+            break;
+        }
+        memcpy(&Header, P->Data + Used, sizeof(Header));
+        Used += sizeof(Header);
+
+        x0 = (Header.Tile % TilesX) * DISPLAY_CRC_TILE;
+        y0 = (Header.Tile / TilesX) * DISPLAY_CRC_TILE;
+        if (y0 >= Shot.Height || Used + Header.Length > P->DataLength)
+        {
+            break;
+        }
+        w = (x0 + DISPLAY_CRC_TILE < Shot.Width) ? DISPLAY_CRC_TILE : Shot.Width - x0;
+        h = (y0 + DISPLAY_CRC_TILE < Shot.Height) ? DISPLAY_CRC_TILE : Shot.Height - y0;
+
+        if (Header.Encoding == DISPLAY_SHOT_ENCODING_RAW && Header.Length == w * h * Shot.Bpp)
+        {
+            memcpy(Tile, P->Data + Used, Header.Length);
+        }
+        else if (Header.Encoding != DISPLAY_SHOT_ENCODING_RLE ||
+                 !SHOT_Unpack(Tile, w * h, Shot.Bpp, P->Data + Used, Header.Length))
+        {
+            break;
+        }
+        Used += Header.Length;
+
+        for (y = 0; y < h; y++)
+        {
+            memcpy(Shot.Pixels + (((y0 + y) * Shot.Width + x0) * Shot.Bpp), Tile + (y * w * Shot.Bpp), w * Shot.Bpp);
+        }
+        Shot.TilesSeen++;
+    }
+
+    if (i != P->TileCount)
+    {
+        fprintf(stderr, "capture %u packet %u: bad tile record %u\n", (unsigned int)P->CaptureId,
+                (unsigned int)P->Sequence, (unsigned int)i);
+        Shot.Problems++;
+    }
+
+    if (P->Flags & DISPLAY_SHOT_FLAG_LAST)
+    {
+        if (!(P->Flags & DISPLAY_SHOT_FLAG_DELTA))
+        {
+            Shot.HaveBase = (Shot.TilesSeen == Shot.Tiles);
+        }
+        else if (!Shot.HaveBase)
+        {
+            fprintf(stderr, "capture %u: changes without a full capture to apply them to\n",
+                    (unsigned int)P->CaptureId);
+            Shot.Problems++;
+        }
+
+        if (SHOT_WritePpm(Prefix, P) != 0)
+        {
+            Shot.Problems++;
+        }
+
+        SHOT_EndCapture();
+    }
+}
+
+static void SHOT_Usage(const char *Prog)
+{
+    fprintf(stderr, "usage: %s [-H bytes] [-o prefix] tlm.bin\n", Prog);
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8              Packet[SHOT_MAX_PACKET];
+    DISPLAY_ShotTlm_Payload_t Payload;
+    const char               *Prefix     = "shot";
+    unsigned int              HeaderSize = offsetof(DISPLAY_ShotTlm_t, Payload);
+    uint32                    Size;
+    uint32                    Packets = 0;
+    FILE                     *f;
+    int                       opt;
+
+    while ((opt = getopt(argc, argv, "H:o:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'H':
+                if (sscanf(optarg, "%u", &HeaderSize) != 1 || HeaderSize < 6)
+                {
+                    SHOT_Usage(argv[0]);
+                    return 2;
+                }
+                break;
+            case 'o':
+                Prefix = optarg;
+                break;
+            default:
+                SHOT_Usage(argv[0]);
+                return 2;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        SHOT_Usage(argv[0]);
+        return 2;
+    }
+
+    if ((f = fopen(argv[optind], "rb")) == NULL)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    while (fread(Packet, 1, 6, f) == 6)
+    {
+        Size = (((uint32)Packet[4] << 8) | Packet[5]) + 7;
+        if (fread(Packet + 6, 1, Size - 6, f) != Size - 6)
+        {
+            fprintf(stderr, "%s: truncated packet\n", argv[optind]);
+            Shot.Problems++;
+            break;
+        }
+
+        if (((((uint32)Packet[0] << 8) | Packet[1]) & 0x1FFF) != DISPLAY_SHOT_TLM_MID || Size <= HeaderSize)
+        {
+            continue;
+        }
+
+        /* Short packets leave the tail of the payload unused */
+        Size -= HeaderSize;
+        if (Size > sizeof(Payload))
+        {
+            Size = sizeof(Payload);
+        }
+        memcpy(&Payload, Packet + HeaderSize, Size);
+
+        SHOT_Packet(&Payload, Size, Prefix);
+        Packets++;
+    }
+
+    fclose(f);
+    SHOT_EndCapture();
+
+    printf("%u screenshot packets, %u problems\n", (unsigned int)Packets, (unsigned int)Shot.Problems);
+
+    return (Shot.Problems == 0) ? 0 : 1;
+}
@@ -0,0 +1,2552 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_display_app.c
+**
+** Purpose:
+** Coverage Unit Test cases for the Display Application
+**
+** Notes:
+** Only the cFE and OSAL services are stubbed. The app's own modules run
+** for real, drawing into the fake framebuffer from ut_display_fakefb.c,
+** so most tests send a command through DISPLAY_ProcessCommandPacket and
+** then read back what reached the panel.
+*/
+
+/*
+ * Includes
+ */
+
+#include "display_7735s_coveragetest_common.h"
+#include "display_arena.h"
+#include "display_band.h"
+#include "display_fb.h"
+#include "display_flow.h"
+#include "display_font.h"
+#include "display_image.h"
+#include "display_job.h"
+#include "display_lib.h"
+#include "display_render.h"
+#include "display_stream.h"
+
+#include <time.h>
+
+/*
+ * A buffer large enough for any command message
+ */
+typedef union
+{
+    CFE_SB_Buffer_t               SBBuf;
+    DISPLAY_NoArgsCmd_t           NoArgs;
+    DISPLAY_FillRectCmd_t         FillRect;
+    DISPLAY_GradientCmd_t         Gradient;
+    DISPLAY_ImageUploadCmd_t      ImageUpload;
+    DISPLAY_ImageFreeCmd_t        ImageFree;
+    DISPLAY_DrawImageCmd_t        DrawImage;
+    DISPLAY_XferBeginCmd_t        XferBegin;
+    DISPLAY_XferChunkCmd_t        XferChunk;
+    DISPLAY_XferCommitCmd_t       XferCommit;
+    DISPLAY_XferAbortCmd_t        XferAbort;
+    DISPLAY_ClientRegisterCmd_t   ClientRegister;
+    DISPLAY_ClientUnregisterCmd_t ClientUnregister;
+    DISPLAY_LayerSetCmd_t         LayerSet;
+    DISPLAY_LayerSelectCmd_t      LayerSelect;
+    DISPLAY_RecordStartCmd_t      RecordStart;
+    DISPLAY_AnimSetCmd_t          AnimSet;
+    DISPLAY_AnimStopCmd_t         AnimStop;
+    DISPLAY_CrcCmd_t              Crc;
+    DISPLAY_ScreenshotCmd_t       Screenshot;
+    DISPLAY_TextCmd_t             Text;
+} UT_DisplayCmd_t;
+
+static UT_DisplayCmd_t UT_Cmd;
+
+#define UT_RGB565_WHITE 0xFFFF
+#define UT_RGB565_RED   0xF800
+#define UT_RGB565_GREEN 0x07E0
+#define UT_RGB565_BLUE  0x001F
+
+static const DISPLAY_Color_t UT_White = {255, 255, 255, 255};
+static const DISPLAY_Color_t UT_Black = {0, 0, 0, 255};
+static const DISPLAY_Color_t UT_Red   = {255, 0, 0, 255};
+static const DISPLAY_Color_t UT_Green = {0, 255, 0, 255};
+static const DISPLAY_Color_t UT_Blue  = {0, 0, 255, 255};
+
+/*
+ * Send a fill of the current layer through the command pipe
+ */
+static void UT_Display_Fill(uint32 X, uint32 Y, uint32 W, uint32 H, DISPLAY_Color_t Color)
+{
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.FillRect.startX = X;
+    UT_Cmd.FillRect.startY = Y;
+    UT_Cmd.FillRect.sizeX  = W;
+    UT_Cmd.FillRect.sizeY  = H;
+    UT_Cmd.FillRect.color  = Color;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_FILLRECT_CC, &UT_Cmd, sizeof(UT_Cmd.FillRect));
+}
+
+/*
+ * Store a Width x Height RGB565 image of one color in Slot
+ */
+static void UT_Display_Upload(uint16 Slot, uint16 Width, uint16 Height, uint16 Pixel)
+{
+    uint16 *Data = (uint16 *)UT_Cmd.ImageUpload.Data;
+    uint32  i;
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageUpload.Slot   = Slot;
+    UT_Cmd.ImageUpload.Width  = Width;
+    UT_Cmd.ImageUpload.Height = Height;
+    UT_Cmd.ImageUpload.Format = DISPLAY_IMAGE_FORMAT_RGB565;
+    strncpy(UT_Cmd.ImageUpload.Name, "ut", sizeof(UT_Cmd.ImageUpload.Name));
+    for (i = 0; i < (uint32)Width * Height; i++)
+    {
+        Data[i] = Pixel;
+    }
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd,
+                    offsetof(DISPLAY_ImageUploadCmd_t, Data) + ((size_t)Width * Height * 2));
+}
+
+static void UT_Display_CheckPixel(uint32 X, uint32 Y, uint32 Expected)
+{
+    uint32 Actual = UT_FakeFb_GetPixel(X, Y);
+
+    UtAssert_True(Actual == Expected, "Panel pixel %lu,%lu (0x%04lx) == 0x%04lx", (unsigned long)X,
+                  (unsigned long)Y, (unsigned long)Actual, (unsigned long)Expected);
+}
+
+static uint32 UT_Display_JobSteps;
+
+/*
+ * Job step that takes Arg steps, each spinning for at least 300us
+ */
+static bool UT_Display_SlowStep(uint32 Arg)
+{
+    struct timespec Start, Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    do
+    {
+        clock_gettime(CLOCK_MONOTONIC, &Now);
+    } while ((Now.tv_sec - Start.tv_sec) * 1000000 + (Now.tv_nsec - Start.tv_nsec) / 1000 < 300);
+
+    return ++UT_Display_JobSteps >= Arg;
+}
+
+/*
+ * Keeps the main loop running while the deferred return value says so,
+ * with a job started on each pass
+ */
+static void UT_Display_RunLoopJobHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    int32 status = 0;
+
+    UT_Stub_GetInt32StatusCode(Context, &status);
+    if (status != 0)
+    {
+        DISPLAY_JobStart(UT_Display_SlowStep, 1);
+    }
+    UT_Stub_SetReturnValue(FuncKey, (bool)(status != 0));
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_DISPLAY_Main(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_Main( void )
+     */
+    UT_CheckEvent_t EventTest;
+
+    /*
+     * Nominal: initialize, leave the loop at once, and release the device
+     */
+    DISPLAY_Main();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_ExitApp)) == 1, "CFE_ES_ExitApp() called");
+    UtAssert_True(!UT_FakeFb.Mapped && !UT_FakeFb.Open, "Framebuffer unmapped and closed on exit");
+
+    /*
+     * Initialization failure
+     */
+    UT_SetDeferredRetcode(UT_KEY(CFE_EVS_Register), 1, CFE_EVS_INVALID_PARAMETER);
+    DISPLAY_Main();
+    UtAssert_True(DISPLAY_Data.RunStatus == CFE_ES_RunStatus_APP_ERROR,
+                  "DISPLAY_Data.RunStatus (%lu) == CFE_ES_RunStatus_APP_ERROR",
+                  (unsigned long)DISPLAY_Data.RunStatus);
+
+    /*
+     * One pass through the loop with a housekeeping request
+     */
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RunLoop), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_ReceiveBuffer), 1, CFE_SUCCESS);
+    UT_Display.MsgId   = CFE_SB_ValueToMsgId(DISPLAY_SEND_HK_MID);
+    UT_Display.RecvBuf = &UT_Cmd.SBBuf;
+    DISPLAY_Main();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_Manage)) == 1, "CFE_TBL_Manage() called");
+
+    /*
+     * An empty pipe is pended on
+     */
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RunLoop), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_ReceiveBuffer), 2, CFE_SUCCESS);
+    DISPLAY_Main();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_ReceiveBuffer)) == 3, "Pipe polled, then pended on");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_Manage)) == 2, "Pended message processed");
+
+    /*
+     * An empty pipe is not pended on while a job is left to run
+     */
+    UT_SetHandlerFunction(UT_KEY(CFE_ES_RunLoop), UT_Display_RunLoopJobHandler, NULL);
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RunLoop), 1, true);
+    DISPLAY_Main();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_ReceiveBuffer)) == 4, "Pipe polled only");
+    UT_SetHandlerFunction(UT_KEY(CFE_ES_RunLoop), NULL, NULL);
+
+    /*
+     * Pipe read error ends the loop
+     */
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_RunLoop), 1, true);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_ReceiveBuffer), 1, CFE_SB_PIPE_RD_ERR);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_PIPE_ERR_EID, "DISPLAY APP: SB Pipe Read Error, App Will Exit");
+    DISPLAY_Main();
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_PIPE_ERR_EID generated (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_Init(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_Init( void )
+     */
+    UT_CheckEvent_t EventTest;
+
+    /* nominal case maps the panel */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_FB_INF_EID, NULL);
+    UT_Display_Start();
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_FB_INF_EID generated (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(UT_FakeFb.Mapped, "Framebuffer mapped");
+    Display_UT_TearDown();
+
+    /* a failure in each of the cFE calls is returned */
+    UT_SetDeferredRetcode(UT_KEY(CFE_EVS_Register), 1, CFE_EVS_INVALID_PARAMETER);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_EVS_INVALID_PARAMETER);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_CreatePipe), 1, CFE_SB_BAD_ARGUMENT);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_SB_BAD_ARGUMENT);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_Subscribe), 1, CFE_SB_BAD_ARGUMENT);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_SB_BAD_ARGUMENT);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_Subscribe), 2, CFE_SB_BAD_ARGUMENT);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_SB_BAD_ARGUMENT);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_Subscribe), 3, CFE_SB_BAD_ARGUMENT);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_SB_BAD_ARGUMENT);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_Register), 1, CFE_TBL_ERR_INVALID_OPTIONS);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_TBL_ERR_INVALID_OPTIONS);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_Load), 1, CFE_TBL_ERR_INVALID_OPTIONS);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_TBL_ERR_INVALID_OPTIONS);
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_GetAddress), 1, CFE_TBL_ERR_UNREGISTERED);
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_TBL_ERR_UNREGISTERED);
+    UtAssert_True(!UT_FakeFb.Mapped, "Framebuffer not mapped after a failed start");
+
+    /* pools too large for the arena */
+    UT_Display.Table.PoolSize[DISPLAY_POOL_FRAME] = 0xFFFFFFFF;
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), DISPLAY_STATUS_ERROR_RANGE);
+
+    /* no room for the recorder's staging buffer */
+    UT_Display.Table.PoolSize[DISPLAY_POOL_FRAME] = 256 * 1024;
+    UT_Display.Table.PoolSize[DISPLAY_POOL_RING]  = 0;
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), DISPLAY_STATUS_ERROR_NOMEM);
+    Display_UT_TearDown();
+
+    /* a missing panel is not fatal */
+    UT_Display.Table.PoolSize[DISPLAY_POOL_RING] = 16 * 1024;
+    UT_FakeFb.Present                            = false;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_STARTUP_ERR_EID, "Framebuffer display failed to initialize");
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_SUCCESS);
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_STARTUP_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+    UtAssert_True(!DISPLAY_RenderIsReady(), "Nothing to draw on without a panel");
+}
+
+void Test_DISPLAY_ProcessCommandPacket(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_ProcessCommandPacket
+     */
+    UT_CheckEvent_t EventTest;
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_INVALID_MSGID_ERR_EID, "DISPLAY: invalid command packet,MID = 0x%x");
+
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_NOOP_CC, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UT_Display_Send(DISPLAY_SEND_HK_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+
+    /* invalid message id */
+    UT_Display_Send(0, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+
+    /*
+     * Confirm that the event was generated only _once_
+     */
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_INVALID_MSGID_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_ProcessGroundCommand(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_ProcessGroundCommand
+     *
+     * Every command code is sent once one byte short, which must be
+     * rejected without running the handler, and once at its length.
+     */
+    static const struct
+    {
+        uint16 FcnCode;
+        size_t Size;
+    } Fixed[] = {
+        {DISPLAY_NOOP_CC, sizeof(DISPLAY_NoopCmd_t)},
+        {DISPLAY_RESET_COUNTERS_CC, sizeof(DISPLAY_ResetCountersCmd_t)},
+        {DISPLAY_PROCESS_CC, sizeof(DISPLAY_ProcessCmd_t)},
+        {DISPLAY_FILLRECT_CC, sizeof(DISPLAY_FillRectCmd_t)},
+        {DISPLAY_GRADIENT_CC, sizeof(DISPLAY_GradientCmd_t)},
+        {DISPLAY_IMAGE_FREE_CC, sizeof(DISPLAY_ImageFreeCmd_t)},
+        {DISPLAY_IMAGE_LIST_CC, sizeof(DISPLAY_ImageListCmd_t)},
+        {DISPLAY_DRAW_IMAGE_CC, sizeof(DISPLAY_DrawImageCmd_t)},
+        {DISPLAY_XFER_BEGIN_CC, sizeof(DISPLAY_XferBeginCmd_t)},
+        {DISPLAY_XFER_COMMIT_CC, sizeof(DISPLAY_XferCommitCmd_t)},
+        {DISPLAY_XFER_ABORT_CC, sizeof(DISPLAY_XferAbortCmd_t)},
+        {DISPLAY_XFER_STATUS_CC, sizeof(DISPLAY_XferStatusCmd_t)},
+        {DISPLAY_CLIENT_REGISTER_CC, sizeof(DISPLAY_ClientRegisterCmd_t)},
+        {DISPLAY_CLIENT_UNREGISTER_CC, sizeof(DISPLAY_ClientUnregisterCmd_t)},
+        {DISPLAY_CLIENT_LIST_CC, sizeof(DISPLAY_ClientListCmd_t)},
+        {DISPLAY_LAYER_SET_CC, sizeof(DISPLAY_LayerSetCmd_t)},
+        {DISPLAY_LAYER_SELECT_CC, sizeof(DISPLAY_LayerSelectCmd_t)},
+        {DISPLAY_RECORD_START_CC, sizeof(DISPLAY_RecordStartCmd_t)},
+        {DISPLAY_RECORD_STOP_CC, sizeof(DISPLAY_RecordStopCmd_t)},
+        {DISPLAY_ANIM_SET_CC, sizeof(DISPLAY_AnimSetCmd_t)},
+        {DISPLAY_ANIM_STOP_CC, sizeof(DISPLAY_AnimStopCmd_t)},
+        {DISPLAY_CRC_CC, sizeof(DISPLAY_CrcCmd_t)},
+        {DISPLAY_SCREENSHOT_CC, sizeof(DISPLAY_ScreenshotCmd_t)},
+        {DISPLAY_TEXT_CC, sizeof(DISPLAY_TextCmd_t)},
+    };
+    UT_CheckEvent_t EventTest;
+    uint32          i;
+
+    UT_Display_Start();
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_LEN_ERR_EID, NULL);
+
+    for (i = 0; i < sizeof(Fixed) / sizeof(Fixed[0]); i++)
+    {
+        UT_Display_Send(DISPLAY_CMD_MID, Fixed[i].FcnCode, &UT_Cmd, Fixed[i].Size - 1);
+        UtAssert_True(EventTest.MatchCount == i + 1, "CC %u short command rejected", (unsigned int)Fixed[i].FcnCode);
+
+        memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+        UT_Display_Send(DISPLAY_CMD_MID, Fixed[i].FcnCode, &UT_Cmd, Fixed[i].Size);
+        UtAssert_True(EventTest.MatchCount == i + 1, "CC %u command accepted", (unsigned int)Fixed[i].FcnCode);
+    }
+
+    /* variable length commands: short of the fixed part, then short of the data */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_LEN_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd, offsetof(DISPLAY_ImageUploadCmd_t, Data) - 1);
+    UT_Cmd.ImageUpload.Width  = 2;
+    UT_Cmd.ImageUpload.Height = 2;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd, offsetof(DISPLAY_ImageUploadCmd_t, Data) + 7);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_CHUNK_CC, &UT_Cmd, offsetof(DISPLAY_XferChunkCmd_t, Data) - 1);
+    UT_Cmd.XferChunk.Length = 4;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_CHUNK_CC, &UT_Cmd, offsetof(DISPLAY_XferChunkCmd_t, Data) + 3);
+    UtAssert_True(EventTest.MatchCount == 4, "DISPLAY_LEN_ERR_EID generated (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* invalid CC */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, "Invalid ground command code: CC = %d");
+    UT_Display_Send(DISPLAY_CMD_MID, 100, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMAND_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_ReportHousekeeping(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_ReportHousekeeping( const CFE_MSG_CommandHeader_t *Msg )
+     */
+    CFE_MSG_Message_t *MsgSend[2];
+
+    UT_Display_Start();
+    DISPLAY_Data.CmdCounter = 3;
+    DISPLAY_Data.ErrCounter = 4;
+
+    UT_SetDataBuffer(UT_KEY(CFE_SB_TransmitMsg), MsgSend, sizeof(MsgSend), false);
+    UT_TEST_FUNCTION_RC(DISPLAY_ReportHousekeeping(NULL), CFE_SUCCESS);
+
+    /* Housekeeping, then the flush performance packet */
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 2, "CFE_SB_TransmitMsg() called twice");
+    UtAssert_True(MsgSend[0] == &DISPLAY_Data.HkTlm.TlmHeader.Msg, "Housekeeping packet sent");
+    UtAssert_True(MsgSend[1] == &DISPLAY_Data.PerfTlm.TlmHeader.Msg, "Performance packet sent");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.CommandCounter == 3, "CommandCounter reported");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.CommandErrorCounter == 4, "CommandErrorCounter reported");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.FbMapped == 1, "FbMapped reported");
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.Flushes >= 1, "Start-up repaint counted as a flush");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_Manage)) == DISPLAY_NUMBER_OF_TABLES, "CFE_TBL_Manage() called");
+}
+
+void Test_DISPLAY_NoopCmd(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_Noop( const DISPLAY_NoopCmd_t *Msg )
+     */
+    DISPLAY_NoopCmd_t TestMsg;
+    UT_CheckEvent_t   EventTest;
+
+    memset(&TestMsg, 0, sizeof(TestMsg));
+
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMANDNOP_INF_EID, NULL);
+    UT_TEST_FUNCTION_RC(DISPLAY_Noop(&TestMsg), CFE_SUCCESS);
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMANDNOP_INF_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.CmdCounter == 1, "CmdCounter incremented");
+}
+
+void Test_DISPLAY_ResetCounters(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_ResetCounters( const DISPLAY_ResetCountersCmd_t *Msg )
+     */
+    DISPLAY_ResetCountersCmd_t TestMsg;
+    UT_CheckEvent_t            EventTest;
+
+    memset(&TestMsg, 0, sizeof(TestMsg));
+    DISPLAY_Data.CmdCounter = 5;
+    DISPLAY_Data.ErrCounter = 6;
+
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMANDRST_INF_EID, "DISPLAY: RESET command");
+    UT_TEST_FUNCTION_RC(DISPLAY_ResetCounters(&TestMsg), CFE_SUCCESS);
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMANDRST_INF_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.CmdCounter == 0 && DISPLAY_Data.ErrCounter == 0, "Counters cleared");
+}
+
+void Test_DISPLAY_ProcessTbl(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_ProcessTbl( const DISPLAY_ProcessCmd_t *Msg )
+     */
+    DISPLAY_ProcessCmd_t TestMsg;
+
+    memset(&TestMsg, 0, sizeof(TestMsg));
+
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessTbl(&TestMsg), CFE_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_GetInfo)) == 1, "CFE_TBL_GetInfo() called");
+
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_ReleaseAddress), 1, CFE_TBL_ERR_UNREGISTERED);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessTbl(&TestMsg), CFE_TBL_ERR_UNREGISTERED);
+
+    UT_SetDefaultReturnValue(UT_KEY(CFE_TBL_GetAddress), CFE_TBL_ERR_UNREGISTERED);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessTbl(&TestMsg), CFE_TBL_ERR_UNREGISTERED);
+}
+
+void Test_DISPLAY_FillRect(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_FillRect( const DISPLAY_FillRectCmd_t *Msg )
+     */
+    UT_CheckEvent_t EventTest;
+
+    /* no panel: the draw is dropped and counted as an error */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, "DISPLAY: no display, draw dropped");
+    UT_Display_Fill(0, 0, 10, 10, UT_White);
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMAND_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.ErrCounter == 1, "ErrCounter incremented");
+
+    UT_Display_Start();
+
+    UT_Display_Fill(10, 20, 30, 40, UT_Red);
+    UtAssert_True(DISPLAY_Data.CmdCounter == 1, "CmdCounter incremented");
+    UT_Display_CheckPixel(10, 20, UT_RGB565_RED);
+    UT_Display_CheckPixel(39, 59, UT_RGB565_RED);
+    UT_Display_CheckPixel(9, 20, 0);
+    UT_Display_CheckPixel(40, 59, 0);
+    UT_Display_CheckPixel(39, 60, 0);
+
+    /* clipped at the panel edge */
+    UT_Display_Fill(150, 120, 100, 100, UT_Green);
+    UT_Display_CheckPixel(UT_DISPLAY_WIDTH - 1, UT_DISPLAY_HEIGHT - 1, UT_RGB565_GREEN);
+    UT_Display_CheckPixel(149, 120, 0);
+
+    /* and off its far side, as far as a position can go */
+    UT_Display_Fill(-10, 0, DISPLAY_DRAW_MAX_SIZE, 2, UT_Blue);
+    UT_Display_Fill(DISPLAY_DRAW_MAX_COORD, DISPLAY_DRAW_MIN_COORD, DISPLAY_DRAW_MAX_SIZE, DISPLAY_DRAW_MAX_SIZE,
+                    UT_Red);
+    UtAssert_True(DISPLAY_Data.CmdCounter == 4 && DISPLAY_Data.ErrCounter == 0, "Edge of the range drawn");
+    UT_Display_CheckPixel(UT_DISPLAY_WIDTH - 1, 1, UT_RGB565_BLUE);
+
+    /* positions and sizes whose edges would not fit an int32 are refused */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, NULL);
+    UT_Display_Fill(0x7FFFFFF0, 0, 0x100, 10, UT_White);
+    UT_Display_Fill(0, 0x80000000, 10, 10, UT_White);
+    UT_Display_Fill(0, 0, 0x7FFFFFFF, 10, UT_White);
+    UT_Display_Fill(0, 0, 10, DISPLAY_DRAW_MAX_SIZE + 1, UT_White);
+    UtAssert_True(EventTest.MatchCount == 4, "Out of range draws refused (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.CmdCounter == 4 && DISPLAY_Data.ErrCounter == 4, "Refusals counted as errors");
+    UT_Display_CheckPixel(0, 0, UT_RGB565_BLUE);
+}
+
+void Test_DISPLAY_Gradient(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_Gradient( const DISPLAY_GradientCmd_t *Msg )
+     */
+    UT_CheckEvent_t EventTest;
+    uint32          Left, Mid, Right;
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.Gradient.colorFrom = UT_Black;
+    UT_Cmd.Gradient.colorTo   = UT_Blue;
+    UT_Cmd.Gradient.sizeX     = UT_DISPLAY_WIDTH;
+    UT_Cmd.Gradient.sizeY     = 8;
+
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, "DISPLAY: no display, draw dropped");
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_GRADIENT_CC, &UT_Cmd, sizeof(UT_Cmd.Gradient));
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMAND_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    UT_Display_Start();
+
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_GRADIENT_CC, &UT_Cmd, sizeof(UT_Cmd.Gradient));
+    UtAssert_True(DISPLAY_Data.CmdCounter == 1, "CmdCounter incremented");
+
+    /* blue rises left to right; dithering may move a pixel by one step */
+    Left  = UT_FakeFb_GetPixel(0, 4);
+    Mid   = UT_FakeFb_GetPixel(UT_DISPLAY_WIDTH / 2, 4);
+    Right = UT_FakeFb_GetPixel(UT_DISPLAY_WIDTH - 1, 4);
+    UtAssert_True(Left == 0, "Gradient starts black (0x%04lx)", (unsigned long)Left);
+    UtAssert_True(Right == UT_RGB565_BLUE, "Gradient ends blue (0x%04lx)", (unsigned long)Right);
+    UtAssert_True(Mid >= 14 && Mid <= 17, "Gradient midpoint half blue (0x%04lx)", (unsigned long)Mid);
+    UT_Display_CheckPixel(0, 8, 0);
+
+    /* an edge that would not fit an int32 is refused */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, NULL);
+    UT_Cmd.Gradient.startY = 0x7FFFFFFF;
+    UT_Cmd.Gradient.sizeY  = 0x100;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_GRADIENT_CC, &UT_Cmd, sizeof(UT_Cmd.Gradient));
+    UtAssert_True(EventTest.MatchCount == 1 && DISPLAY_Data.CmdCounter == 1, "Out of range gradient refused");
+}
+
+void Test_DISPLAY_Images(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_ImageUpload( const DISPLAY_ImageUploadCmd_t *Msg )
+     * int32 DISPLAY_ImageListSlots( const DISPLAY_ImageListCmd_t *Msg )
+     * int32 DISPLAY_DrawImage( const DISPLAY_DrawImageCmd_t *Msg )
+     * int32 DISPLAY_ImageFreeSlot( const DISPLAY_ImageFreeCmd_t *Msg )
+     * CFE_Status_t DISPLAY_ImageReserve( uint16 Slot, ..., uint32 LoadSize, uint8 **Pixels )
+     */
+    UT_CheckEvent_t EventTest;
+    uint8          *Pixels;
+    uint32          Free;
+
+    UT_Display_Start();
+
+    UT_Display_Upload(3, 4, 2, UT_RGB565_GREEN);
+    UtAssert_True(DISPLAY_Data.CmdCounter == 1, "Upload accepted");
+
+    /* slot out of range */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_IMAGE_ERR_EID, NULL);
+    UT_Display_Upload(DISPLAY_MAX_IMAGE_SLOTS, 4, 2, UT_RGB565_GREEN);
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_IMAGE_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_LIST_CC, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(DISPLAY_Data.ImageListTlm.Payload.Slots[3].State == DISPLAY_IMAGE_SLOT_READY, "Slot 3 listed ready");
+    UtAssert_True(DISPLAY_Data.ImageListTlm.Payload.Slots[3].Width == 4, "Slot 3 width listed");
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 3;
+    UT_Cmd.DrawImage.X    = 100;
+    UT_Cmd.DrawImage.Y    = 50;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UT_Display_CheckPixel(100, 50, UT_RGB565_GREEN);
+    UT_Display_CheckPixel(103, 51, UT_RGB565_GREEN);
+    UT_Display_CheckPixel(104, 51, 0);
+    UT_Display_CheckPixel(103, 52, 0);
+
+    /* a replacement that cannot fit leaves the image in the slot be; one that just fits takes its place */
+    Free = DISPLAY_ArenaAvailable(DISPLAY_POOL_IMAGE) + 4 * 2 * sizeof(uint16);
+    UT_TEST_FUNCTION_RC(DISPLAY_ImageReserve(3, "big", 1, 1, DISPLAY_IMAGE_FORMAT_RGB565, Free + 4, &Pixels),
+                        DISPLAY_STATUS_ERROR_NOMEM);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 3;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UT_Display_CheckPixel(3, 1, UT_RGB565_GREEN);
+    UT_TEST_FUNCTION_RC(DISPLAY_ImageReserve(3, "big", 1, 1, DISPLAY_IMAGE_FORMAT_RGB565, Free, &Pixels),
+                        CFE_SUCCESS);
+    DISPLAY_ImageCommit(3, DISPLAY_IMAGE_FORMAT_RGB565);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageFree.Slot = 3;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_FREE_CC, &UT_Cmd, sizeof(UT_Cmd.ImageFree));
+
+    /* freeing a slot that does not exist, and drawing the freed one, both fail */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_IMAGE_ERR_EID, NULL);
+    UT_Cmd.ImageFree.Slot = DISPLAY_MAX_IMAGE_SLOTS;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_FREE_CC, &UT_Cmd, sizeof(UT_Cmd.ImageFree));
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 3;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UtAssert_True(EventTest.MatchCount == 2, "DISPLAY_IMAGE_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    /* an image loaded while the panel is gone cannot be drawn */
+    UT_Display_Upload(4, 1, 1, UT_RGB565_RED);
+    DISPLAY_RenderClose();
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, "DISPLAY: no display, draw dropped");
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 4;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMAND_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_Xfer(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_XferBeginCmd( const DISPLAY_XferBeginCmd_t *Msg )
+     * int32 DISPLAY_XferChunkCmd( const DISPLAY_XferChunkCmd_t *Msg )
+     * int32 DISPLAY_XferCommitCmd( const DISPLAY_XferCommitCmd_t *Msg )
+     * int32 DISPLAY_XferAbortCmd( const DISPLAY_XferAbortCmd_t *Msg )
+     * int32 DISPLAY_XferStatusCmd( const DISPLAY_XferStatusCmd_t *Msg )
+     */
+    uint16          Image[4 * 4];
+    UT_CheckEvent_t EventTest;
+    uint32          i;
+
+    UT_Display_Start();
+
+    for (i = 0; i < 16; i++)
+    {
+        Image[i] = UT_RGB565_BLUE;
+    }
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferBegin.TransferId = 7;
+    UT_Cmd.XferBegin.Slot       = 1;
+    UT_Cmd.XferBegin.Width      = 4;
+    UT_Cmd.XferBegin.Height     = 4;
+    UT_Cmd.XferBegin.TotalSize  = sizeof(Image);
+    UT_Cmd.XferBegin.ChunkSize  = 16;
+    UT_Cmd.XferBegin.Format     = DISPLAY_IMAGE_FORMAT_RGB565;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_INF_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_BEGIN_CC, &UT_Cmd, sizeof(UT_Cmd.XferBegin));
+    UtAssert_True(EventTest.MatchCount == 1, "Transfer started (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* a size that does not match the image is rejected */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_ERR_EID, NULL);
+    UT_Cmd.XferBegin.TotalSize = 10;
+    DISPLAY_XferBeginCmd(&UT_Cmd.XferBegin);
+    UtAssert_True(EventTest.MatchCount == 1, "Bad transfer rejected (%u)", (unsigned int)EventTest.MatchCount);
+    UT_Cmd.XferBegin.TotalSize = sizeof(Image);
+    DISPLAY_XferBeginCmd(&UT_Cmd.XferBegin);
+
+    /* first chunk, then commit with the second missing */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferChunk.TransferId = 7;
+    UT_Cmd.XferChunk.Sequence   = 0;
+    UT_Cmd.XferChunk.Offset     = 0;
+    UT_Cmd.XferChunk.Length     = 16;
+    memcpy(UT_Cmd.XferChunk.Data, Image, 16);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_CHUNK_CC, &UT_Cmd, offsetof(DISPLAY_XferChunkCmd_t, Data) + 16);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferCommit.TransferId = 7;
+    UT_Cmd.XferCommit.Crc        = UT_Display_Crc16(Image, sizeof(Image), 0);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_COMMIT_CC, &UT_Cmd, sizeof(UT_Cmd.XferCommit));
+    UtAssert_True(EventTest.MatchCount == 1, "Incomplete commit refused (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.XferStatusTlm.Payload.FirstMissing == 1, "Chunk 1 reported missing");
+
+    /* a chunk at the wrong offset is rejected */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferChunk.TransferId = 7;
+    UT_Cmd.XferChunk.Sequence   = 1;
+    UT_Cmd.XferChunk.Offset     = 8;
+    UT_Cmd.XferChunk.Length     = 16;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_CHUNK_CC, &UT_Cmd, offsetof(DISPLAY_XferChunkCmd_t, Data) + 16);
+    UtAssert_True(EventTest.MatchCount == 1, "Bad chunk rejected (%u)", (unsigned int)EventTest.MatchCount);
+
+    UT_Cmd.XferChunk.Offset = 16;
+    memcpy(UT_Cmd.XferChunk.Data, &Image[8], 16);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_CHUNK_CC, &UT_Cmd, offsetof(DISPLAY_XferChunkCmd_t, Data) + 16);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferCommit.TransferId = 7;
+    UT_Cmd.XferCommit.Crc        = UT_Display_Crc16(Image, sizeof(Image), 0);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_INF_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_COMMIT_CC, &UT_Cmd, sizeof(UT_Cmd.XferCommit));
+    UtAssert_True(EventTest.MatchCount == 1, "Transfer complete (%u)", (unsigned int)EventTest.MatchCount);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 1;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UT_Display_CheckPixel(3, 3, UT_RGB565_BLUE);
+
+    /* nothing open to abort */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferAbort.TransferId = 7;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_ERR_EID, "DISPLAY: no open transfer %u");
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_XFER_ABORT_CC, &UT_Cmd, sizeof(UT_Cmd.XferAbort));
+    UtAssert_True(EventTest.MatchCount == 1, "Abort refused (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* abort an open one */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.XferBegin.TransferId = 8;
+    UT_Cmd.XferBegin.Slot       = 2;
+    UT_Cmd.XferBegin.Width      = 4;
+    UT_Cmd.XferBegin.Height     = 4;
+    UT_Cmd.XferBegin.TotalSize  = sizeof(Image);
+    UT_Cmd.XferBegin.ChunkSize  = 32;
+    DISPLAY_XferBeginCmd(&UT_Cmd.XferBegin);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_XFER_INF_EID, "DISPLAY: transfer %u aborted");
+    DISPLAY_XferAbortCmd(&UT_Cmd.XferAbort);
+    UtAssert_True(EventTest.MatchCount == 1, "Transfer aborted (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+/*
+ * A two glyph font at 4 bits per pixel: 'A' is a solid 2x2 block, 'B' a
+ * 2x1 row of half coverage then none, set one pixel right of the pen
+ */
+static const struct
+{
+    DISPLAY_FontHeader_t Header;
+    DISPLAY_FontGlyph_t  Glyphs[2];
+    uint8                Runs[3];
+} UT_Font = {
+    {DISPLAY_FONT_MAGIC, 4, 8, 6, 'A', 2, 0},
+    {{36, 1, 2, 2, 0, 6, 3, 0}, {37, 2, 2, 1, 1, 6, 3, 0}},
+    {0x3F, 0x08, 0x00},
+};
+
+/*
+ * Store Size bytes of Font in Slot as a font
+ */
+static void UT_Display_UploadFont(uint16 Slot, const void *Font, uint16 Size)
+{
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageUpload.Slot   = Slot;
+    UT_Cmd.ImageUpload.Width  = Size;
+    UT_Cmd.ImageUpload.Height = 1;
+    UT_Cmd.ImageUpload.Format = DISPLAY_IMAGE_FORMAT_FONT;
+    strncpy(UT_Cmd.ImageUpload.Name, "font", sizeof(UT_Cmd.ImageUpload.Name));
+    memcpy(UT_Cmd.ImageUpload.Data, Font, Size);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd,
+                    offsetof(DISPLAY_ImageUploadCmd_t, Data) + Size);
+}
+
+static void UT_Display_Text(uint16 Font, int16 X, int16 Y, DISPLAY_Color_t Color, const char *Text)
+{
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.Text.Font  = Font;
+    UT_Cmd.Text.X     = X;
+    UT_Cmd.Text.Y     = Y;
+    UT_Cmd.Text.Color = Color;
+    strncpy(UT_Cmd.Text.Text, Text, sizeof(UT_Cmd.Text.Text));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_TEXT_CC, &UT_Cmd, sizeof(UT_Cmd.Text));
+}
+
+void Test_DISPLAY_Text(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_TextCmd( const DISPLAY_TextCmd_t *Msg )
+     * CFE_Status_t DISPLAY_FontDrawText( uint16 Font, int32 X, int32 Y, ... )
+     */
+    DISPLAY_Rect_t  Box = {30, 40, 4, 4};
+    UT_CheckEvent_t EventTest;
+    uint8           Bad[sizeof(UT_Font)];
+    uint32          Hits, Misses, i;
+    uint16          Cached;
+
+    UT_Display_Start();
+
+    UT_Display_UploadFont(5, &UT_Font, sizeof(UT_Font));
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_LIST_CC, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(DISPLAY_Data.ImageListTlm.Payload.Slots[5].Format == DISPLAY_IMAGE_FORMAT_FONT, "Slot 5 holds a font");
+
+    /* a font is not an image */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_IMAGE_ERR_EID, NULL);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 5;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_IMAGE_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    /* 'C' has no glyph and is left out; the pen still moves for 'A' and 'B' */
+    UT_Display_Text(5, 10, 20, UT_White, "ACB");
+    UT_Display_CheckPixel(10, 20, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(11, 21, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(12, 20, 0);
+    UT_Display_CheckPixel(13, 20, 0);
+    UT_Display_CheckPixel(14, 20, (17 << 11) | (34 << 5) | 17);
+    UT_Display_CheckPixel(15, 20, 0);
+    UT_Display_CheckPixel(14, 21, 0);
+
+    DISPLAY_FontGetStats(&Hits, &Misses, &Cached);
+    UtAssert_True(Hits == 0 && Misses == 2 && Cached == 2, "Both glyphs expanded once");
+
+    UT_Display_Text(5, 10, 30, UT_White, "ABAB");
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.GlyphHits == 4, "GlyphHits reported");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.GlyphMisses == 2, "GlyphMisses reported");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.GlyphCached == 2, "GlyphCached reported");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.GlyphHitPct == 66, "GlyphHitPct reported (%u)",
+                  (unsigned int)DISPLAY_Data.HkTlm.Payload.GlyphHitPct);
+    UT_Display_Text(5, 10, 30, UT_White, "A");
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.GlyphHitPct == 100, "GlyphHitPct covers only the last period");
+
+    /* a glyph is blended over an earlier draw and does not hide it */
+    DISPLAY_RenderSetTarget(0, NULL);
+    DISPLAY_RenderFillRect(&Box, UT_Blue);
+    DISPLAY_FontDrawText(5, 30, 40, UT_Green, "A", 1);
+    DISPLAY_RenderFlush(false);
+    UT_Display_CheckPixel(31, 41, UT_RGB565_GREEN);
+    UT_Display_CheckPixel(33, 43, UT_RGB565_BLUE);
+
+    /* every reload is a new font; the cache fills and then recycles the oldest glyph */
+    for (i = 0; i < 40; i++)
+    {
+        UT_Display_UploadFont(5, &UT_Font, sizeof(UT_Font));
+        UT_Display_Text(5, 60, 60, (i & 1) ? UT_Red : UT_Green, "A");
+    }
+    DISPLAY_FontGetStats(&Hits, &Misses, &Cached);
+    UtAssert_True(Misses == 42 && Cached == 32, "Cache full after reloads (%lu misses, %u cached)",
+                  (unsigned long)Misses, (unsigned int)Cached);
+    UT_Display_CheckPixel(61, 61, UT_RGB565_RED);
+
+    /* a glyph too large for a cell is skipped, the rest of the line is drawn */
+    memcpy(Bad, &UT_Font, sizeof(Bad));
+    ((DISPLAY_FontGlyph_t *)(Bad + sizeof(DISPLAY_FontHeader_t)))[1].Width  = 40;
+    ((DISPLAY_FontGlyph_t *)(Bad + sizeof(DISPLAY_FontHeader_t)))[1].Height = 40;
+    UT_Display_UploadFont(6, Bad, sizeof(Bad));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_TEXT_ERR_EID, NULL);
+    UT_Display_Text(6, 80, 80, UT_White, "BA");
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_TEXT_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+    UT_Display_CheckPixel(83, 80, UT_RGB565_WHITE);
+
+    /* no font: an empty slot, an image, and data that is not a font */
+    UT_Display_Upload(7, 2, 2, UT_RGB565_RED);
+    memset(Bad, 0, sizeof(Bad));
+    UT_Display_UploadFont(8, Bad, sizeof(Bad));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_TEXT_ERR_EID, "DISPLAY: image slot %u does not hold a valid font");
+    UT_Display_Text(9, 0, 0, UT_White, "A");
+    UT_Display_Text(7, 0, 0, UT_White, "A");
+    UT_Display_Text(8, 0, 0, UT_White, "A");
+    UtAssert_True(EventTest.MatchCount == 3, "DISPLAY_TEXT_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    DISPLAY_RenderClose();
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, "DISPLAY: no display, draw dropped");
+    UT_Display_Text(5, 0, 0, UT_White, "A");
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_COMMAND_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_Clients(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_ClientRegisterCmd( const DISPLAY_ClientRegisterCmd_t *Msg )
+     * int32 DISPLAY_ClientUnregisterCmd( const DISPLAY_ClientUnregisterCmd_t *Msg )
+     * int32 DISPLAY_ClientListCmd( const DISPLAY_ClientListCmd_t *Msg )
+     * void  DISPLAY_ServiceClients( void )
+     * int32 DISPLAY_ProcessClientCommand( CFE_SB_Buffer_t *SBBufPtr )
+     */
+    UT_DisplayCmd_t Draw;
+    UT_CheckEvent_t EventTest;
+
+    /* the frame tick does nothing without a panel */
+    DISPLAY_ServiceClients();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_TBL_GetAddress)) == 0, "Tick skipped without a panel");
+
+    UT_Display_Start();
+    UT_SetDefaultReturnValue(UT_KEY(CFE_SB_IsValidMsgId), true);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ClientRegister.DrawMid = 0x1900;
+    UT_Cmd.ClientRegister.X       = 20;
+    UT_Cmd.ClientRegister.Y       = 10;
+    UT_Cmd.ClientRegister.Width   = 40;
+    UT_Cmd.ClientRegister.Height  = 30;
+    UT_Cmd.ClientRegister.Layer   = DISPLAY_LAYER_TELEMETRY;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_CLIENT_INF_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_REGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientRegister));
+    UtAssert_True(EventTest.MatchCount == 1, "Client registered (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* the command MID cannot be a draw MID */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_CLIENT_ERR_EID, NULL);
+    UT_Cmd.ClientRegister.DrawMid = DISPLAY_CMD_MID;
+    DISPLAY_ClientRegisterCmd(&UT_Cmd.ClientRegister);
+    UtAssert_True(EventTest.MatchCount == 1, "Command MID refused (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* one draw queued, in client coordinates and clipped to the viewport */
+    memset(&Draw, 0, sizeof(Draw));
+    Draw.FillRect.startX = 0;
+    Draw.FillRect.startY = 0;
+    Draw.FillRect.sizeX  = 100;
+    Draw.FillRect.sizeY  = 100;
+    Draw.FillRect.color  = UT_White;
+    UT_Display.RecvBuf   = &Draw.SBBuf;
+    UT_Display.MsgId     = CFE_SB_ValueToMsgId(0x1900);
+    UT_Display.FcnCode   = DISPLAY_FILLRECT_CC;
+    UT_Display.Size      = sizeof(Draw.FillRect);
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_ReceiveBuffer), 1, CFE_SUCCESS);
+    DISPLAY_ServiceClients();
+    UT_Display_CheckPixel(20, 10, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(59, 39, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(60, 39, 0);
+    UT_Display_CheckPixel(59, 40, 0);
+
+    /* clients may only draw */
+    UT_Display.FcnCode = DISPLAY_NOOP_CC;
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_ReceiveBuffer), 1, CFE_SUCCESS);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_CLIENT_ERR_EID, NULL);
+    DISPLAY_ServiceClients();
+    UtAssert_True(EventTest.MatchCount == 1, "Non-draw client command refused (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    /* gradients and images come through too */
+    UT_Display.FcnCode = DISPLAY_GRADIENT_CC;
+    UT_Display.Size    = sizeof(Draw.Gradient);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessClientCommand(&Draw.SBBuf), CFE_SUCCESS);
+    UT_Display.FcnCode = DISPLAY_DRAW_IMAGE_CC;
+    UT_Display.Size    = sizeof(Draw.DrawImage);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessClientCommand(&Draw.SBBuf), DISPLAY_STATUS_ERROR_RANGE);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_LIST_CC, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(DISPLAY_Data.ClientListTlm.Payload.Clients[0].DrawMid == 0x1900, "Client listed");
+    UtAssert_True(DISPLAY_Data.ClientListTlm.Payload.Clients[0].Draws == 1, "Client draws counted (%lu)",
+                  (unsigned long)DISPLAY_Data.ClientListTlm.Payload.Clients[0].Draws);
+
+    /* table unavailable: flush only */
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_GetAddress), 1, CFE_TBL_ERR_UNREGISTERED);
+    DISPLAY_ServiceClients();
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_ReleaseAddress), 1, CFE_TBL_ERR_UNREGISTERED);
+    DISPLAY_ServiceClients();
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ClientUnregister.DrawMid = 0x1900;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_CLIENT_INF_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_UNREGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientUnregister));
+    UtAssert_True(EventTest.MatchCount == 1, "Client removed (%u)", (unsigned int)EventTest.MatchCount);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_CLIENT_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_UNREGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientUnregister));
+    UtAssert_True(EventTest.MatchCount == 1, "Unknown client refused (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+/*
+ * Put a DISPLAY_DrawSeq_t after the Length bytes of the draw in Cmd, sent
+ * at SentMs, or without a sent time when SentMs is 0
+ */
+static void UT_Display_SetSeq(UT_DisplayCmd_t *Cmd, size_t Length, uint32 Sequence, uint64 SentMs)
+{
+    DISPLAY_DrawSeq_t Seq = {Sequence, (uint32)(SentMs / 1000), (uint32)(((SentMs % 1000) << 32) / 1000)};
+
+    memcpy((uint8 *)Cmd + Length, &Seq, sizeof(Seq));
+}
+
+void Test_DISPLAY_DrawAck(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_AckDraw( const CFE_SB_Buffer_t *SBBufPtr, size_t CmdLength, int32 Status )
+     * void DISPLAY_AckService( DISPLAY_AckTlm_Payload_t *Payload, uint32 Flushes, DISPLAY_AckSend_t Send )
+     */
+    DISPLAY_AckTlm_Payload_t *Ack = &DISPLAY_Data.AckTlm.Payload;
+    CFE_MSG_Message_t        *MsgSend[2];
+    UT_DisplayCmd_t           Draw;
+    UT_CheckEvent_t           EventTest;
+    uint32                    Sent, i;
+
+    UT_Display_Start();
+    UT_SetDataBuffer(UT_KEY(CFE_SB_TransmitMsg), MsgSend, sizeof(MsgSend), false);
+
+    /* unsequenced draws are not acknowledged */
+    UT_Display_Fill(0, 0, 10, 10, UT_White);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 0, "No ack without a sequence");
+
+    /* a sequenced ground draw is acknowledged after its flush, timed from when it was sent */
+    UT_Display_SetTimeMs(5000);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.FillRect.sizeX = 10;
+    UT_Cmd.FillRect.sizeY = 10;
+    UT_Cmd.FillRect.color = UT_Red;
+    UT_Display_SetSeq(&UT_Cmd, sizeof(UT_Cmd.FillRect), 7, 4750);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_FILLRECT_CC, &UT_Cmd, sizeof(UT_Cmd.FillRect) + sizeof(DISPLAY_DrawSeq_t));
+    UT_Display_CheckPixel(0, 0, UT_RGB565_RED);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 1, "Ack sent");
+    UtAssert_True(MsgSend[0] == &DISPLAY_Data.AckTlm.TlmHeader.Msg, "Ack packet sent");
+    UtAssert_True(Ack->Source == DISPLAY_CMD_MID && Ack->Sequence == 7 && Ack->Draws == 1, "Ground draw acknowledged");
+    UtAssert_True(Ack->LatencyUs >= 249999 && Ack->LatencyUs <= 250001, "Latency from the sent time (%lu)",
+                  (unsigned long)Ack->LatencyUs);
+    UtAssert_True(Ack->Flushes == DISPLAY_RenderGetFlushes(), "Ack names the frame");
+
+    /* without a sent time, from when the display ran it */
+    UT_Display_SetSeq(&UT_Cmd, sizeof(UT_Cmd.FillRect), 8, 0);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_FILLRECT_CC, &UT_Cmd, sizeof(UT_Cmd.FillRect) + sizeof(DISPLAY_DrawSeq_t));
+    UtAssert_True(Ack->Sequence == 8 && Ack->LatencyUs == 0, "Timed from receipt (%lu)", (unsigned long)Ack->LatencyUs);
+
+    /* a draw that was not made is not acknowledged */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 1;
+    UT_Display_SetSeq(&UT_Cmd, sizeof(UT_Cmd.DrawImage), 9, 0);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd,
+                    sizeof(UT_Cmd.DrawImage) + sizeof(DISPLAY_DrawSeq_t));
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 2, "No ack for a failed draw");
+
+    /* anything between the two lengths is refused */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_LEN_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_GRADIENT_CC, &UT_Cmd, sizeof(UT_Cmd.Gradient) + 1);
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_LEN_ERR_EID generated (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* a client's draws in one tick share one ack, the newest counting through wraparound */
+    memset(&Draw, 0, sizeof(Draw));
+    Draw.FillRect.sizeX = 4;
+    Draw.FillRect.sizeY = 4;
+    UT_Display.MsgId    = CFE_SB_ValueToMsgId(0x1900);
+    UT_Display.FcnCode  = DISPLAY_FILLRECT_CC;
+    UT_Display.Size     = sizeof(Draw.FillRect) + sizeof(DISPLAY_DrawSeq_t);
+    UT_Display_SetSeq(&Draw, sizeof(Draw.FillRect), 0xFFFFFFFF, 4000);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessClientCommand(&Draw.SBBuf), CFE_SUCCESS);
+    UT_Display_SetSeq(&Draw, sizeof(Draw.FillRect), 1, 4900);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessClientCommand(&Draw.SBBuf), CFE_SUCCESS);
+    Sent = UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg));
+    DISPLAY_ServiceClients();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == Sent + 1, "One ack for the tick");
+    UtAssert_True(Ack->Source == 0x1900 && Ack->Sequence == 1 && Ack->Draws == 2, "Client draws acknowledged (%lu)",
+                  (unsigned long)Ack->Sequence);
+    UtAssert_True(Ack->LatencyUs >= 99999 && Ack->LatencyUs <= 100001, "Latency of the newest (%lu)",
+                  (unsigned long)Ack->LatencyUs);
+    UtAssert_True(Ack->MaxLatencyUs >= 999999 && Ack->MaxLatencyUs <= 1000001, "Latency of the oldest (%lu)",
+                  (unsigned long)Ack->MaxLatencyUs);
+
+    /* a sender clock running ahead counts as no delay */
+    UT_Display_SetSeq(&Draw, sizeof(Draw.FillRect), 2, 6000);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessClientCommand(&Draw.SBBuf), CFE_SUCCESS);
+    DISPLAY_ServiceClients();
+    UtAssert_True(Ack->Sequence == 2 && Ack->LatencyUs == 0, "Clock ahead clamped");
+
+    /* a draw held back by a congested pipe is acknowledged by the housekeeping flush that shows it */
+    for (i = 0; i < DISPLAY_PIPE_DEPTH / 2; i++)
+    {
+        DISPLAY_FlowReceived(true, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+    }
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.FillRect.startX = 60;
+    UT_Cmd.FillRect.sizeX  = 10;
+    UT_Cmd.FillRect.sizeY  = 10;
+    UT_Cmd.FillRect.color  = UT_Blue;
+    UT_Display_SetSeq(&UT_Cmd, sizeof(UT_Cmd.FillRect), 11, 0);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_FILLRECT_CC, &UT_Cmd, sizeof(UT_Cmd.FillRect) + sizeof(DISPLAY_DrawSeq_t));
+    UT_Display_CheckPixel(60, 0, 0);
+    UtAssert_True(Ack->Sequence != 11, "Held draw not acknowledged");
+    DISPLAY_ReportHousekeeping(NULL);
+    UT_Display_CheckPixel(60, 0, UT_RGB565_BLUE);
+    UtAssert_True(Ack->Source == DISPLAY_CMD_MID && Ack->Sequence == 11 && Ack->Flushes == DISPLAY_RenderGetFlushes(),
+                  "Acknowledged by the housekeeping flush");
+    UtAssert_True(!DISPLAY_FlowHeld(), "Held frame counted shown");
+}
+
+/*
+ * Hand out the buffer in UserObj for CFE_SB_AllocateMessageBuffer, or none
+ */
+void Test_DISPLAY_Flow(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_FlowReceived( bool Queued, ... )
+     * bool DISPLAY_FlowSkipFrame( void )
+     * void DISPLAY_FlowPresented( void )
+     * void DISPLAY_PipeDrained( void )
+     *
+     * Messages are fed as the main loop would, each after noting whether
+     * it was queued behind the one before.
+     */
+    DISPLAY_LibHandle_t Handle;
+    uint32              Flushes, Culled;
+    uint32              i;
+
+    UT_Display_Start();
+    UT_Display_Upload(3, 2, 2, UT_RGB565_GREEN);
+    UT_SetDefaultReturnValue(UT_KEY(CFE_SB_IsValidMsgId), true);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ClientRegister.DrawMid = 0x1900;
+    UT_Cmd.ClientRegister.X       = 100;
+    UT_Cmd.ClientRegister.Y       = 60;
+    UT_Cmd.ClientRegister.Width   = 20;
+    UT_Cmd.ClientRegister.Height  = 20;
+    UT_Cmd.ClientRegister.Layer   = DISPLAY_LAYER_TELEMETRY;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_REGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientRegister));
+    UT_TEST_FUNCTION_RC(DISPLAY_LibOpen(0x1900, &Handle), CFE_SUCCESS);
+    Flushes = DISPLAY_RenderGetFlushes();
+
+    /* a backlog short of half the pipe is drawn one frame per draw */
+    for (i = 0; i < DISPLAY_PIPE_DEPTH / 2; i++)
+    {
+        DISPLAY_FlowReceived(i > 0, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+        UT_Display_Fill(0, 0, 10, 10, (i & 1) ? UT_Red : UT_Green);
+    }
+    UtAssert_True(DISPLAY_RenderGetFlushes() == Flushes + DISPLAY_PIPE_DEPTH / 2, "Every draw presented");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 0, "No flow packet");
+
+    /* the next queued message congests the pipe; a frame goes out after every eighth skipped */
+    Flushes = DISPLAY_RenderGetFlushes();
+    for (i = 0; i < 9; i++)
+    {
+        DISPLAY_FlowReceived(true, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+        UT_Display_Fill(0, 0, 10, 10, (i < 8) ? UT_Red : UT_Blue);
+    }
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 1, "Flow packet sent on congestion");
+    UtAssert_True(DISPLAY_Data.FlowTlm.Payload.Congested == 1 && DISPLAY_Data.FlowTlm.Payload.Congestions == 1,
+                  "Congestion reported");
+    UtAssert_True(DISPLAY_Data.FlowTlm.Payload.Backlog == DISPLAY_PIPE_DEPTH / 2, "Backlog reported (%u)",
+                  (unsigned int)DISPLAY_Data.FlowTlm.Payload.Backlog);
+    UtAssert_True(DISPLAY_RenderGetFlushes() == Flushes + 1, "One frame presented for nine draws");
+    UT_Display_CheckPixel(5, 5, UT_RGB565_BLUE);
+
+    /* a held image draw is drawn before its slot is freed, and frame ticks are skipped */
+    DISPLAY_FlowReceived(true, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 3;
+    UT_Cmd.DrawImage.X    = 20;
+    UT_Cmd.DrawImage.Y    = 20;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UT_Display_CheckPixel(20, 20, 0);
+    DISPLAY_FlowReceived(true, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageFree.Slot = 3;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_FREE_CC, &UT_Cmd, sizeof(UT_Cmd.ImageFree));
+    UT_Display_CheckPixel(21, 21, UT_RGB565_GREEN);
+    DISPLAY_FlowReceived(true, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+    UT_Display_Fill(40, 40, 10, 10, UT_White);
+    DISPLAY_FlowReceived(true, &DISPLAY_Data.FlowTlm.Payload, DISPLAY_SendFlowPacket);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 4, 4, UT_White, NULL), CFE_SUCCESS);
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UT_Display_CheckPixel(45, 45, 0);
+    UT_Display_CheckPixel(100, 60, 0);
+
+    /* draining presents what was held, the clients' draws from the skipped tick too, and clears the congestion */
+    DISPLAY_PipeDrained();
+    UT_Display_CheckPixel(45, 45, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(100, 60, UT_RGB565_WHITE);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 3, "Ack and flow packet sent on draining");
+    UtAssert_True(DISPLAY_Data.FlowTlm.Payload.Congested == 0, "Drained reported");
+    UtAssert_True(DISPLAY_Data.FlowTlm.Payload.Backlog == DISPLAY_PIPE_DEPTH / 2 + 12, "Backlog reported (%u)",
+                  (unsigned int)DISPLAY_Data.FlowTlm.Payload.Backlog);
+    UtAssert_True(DISPLAY_Data.FlowTlm.Payload.FramesDropped == 11, "FramesDropped reported (%lu)",
+                  (unsigned long)DISPLAY_Data.FlowTlm.Payload.FramesDropped);
+    UtAssert_True(DISPLAY_Data.FlowTlm.Payload.DrawsCoalesced == 8, "DrawsCoalesced reported (%lu)",
+                  (unsigned long)DISPLAY_Data.FlowTlm.Payload.DrawsCoalesced);
+
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.PipeCongested == 0 && DISPLAY_Data.HkTlm.Payload.FramesDropped == 11 &&
+                      DISPLAY_Data.HkTlm.Payload.DrawsCoalesced == 8,
+                  "Flow counters in housekeeping");
+
+    /* draining an uncongested pipe sends nothing */
+    DISPLAY_PipeDrained();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == 5, "No flow packet after housekeeping");
+
+    /* draws culled in a frame presented on time were not held back */
+    Culled = DISPLAY_RenderGetCulled();
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 4, 4, UT_Red, NULL), CFE_SUCCESS);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 4, 4, UT_Blue, NULL), CFE_SUCCESS);
+    DISPLAY_ServiceClients();
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_RenderGetCulled() == Culled + 1 && DISPLAY_Data.HkTlm.Payload.DrawsCoalesced == 8,
+                  "Only culls from skipped frames coalesced (%lu)",
+                  (unsigned long)DISPLAY_Data.HkTlm.Payload.DrawsCoalesced);
+}
+
+void Test_DISPLAY_Jobs(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_JobStart( DISPLAY_JobStep_t Step, uint32 Arg )
+     * void DISPLAY_JobRun( void )
+     * void DISPLAY_CheckDevice( void )
+     * CFE_Status_t DISPLAY_ImageCommit( uint16 Slot, uint8 Format )
+     */
+    uint8  *Data = UT_Cmd.ImageUpload.Data;
+    uint32  Steps, i;
+
+    UT_Display_Start();
+
+    /* a pass stops once the 500us budget is spent, after one slice at least */
+    UT_Display_JobSteps = 0;
+    DISPLAY_JobStart(UT_Display_SlowStep, 10);
+    UtAssert_True(DISPLAY_JobPending(), "Job pending");
+    DISPLAY_JobRun();
+    Steps = UT_Display_JobSteps;
+    UtAssert_True(Steps >= 1 && Steps <= 2, "One pass took %lu slices", (unsigned long)Steps);
+    DISPLAY_JobRun();
+    UtAssert_True(UT_Display_JobSteps > Steps && UT_Display_JobSteps <= Steps + 2, "Next pass resumed (%lu)",
+                  (unsigned long)UT_Display_JobSteps);
+
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.JobsPending == 1 && DISPLAY_Data.HkTlm.Payload.JobsDone == 0,
+                  "Pending job in housekeeping");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.JobMaxPassUs >= 300, "Longest pass in housekeeping (%u)",
+                  (unsigned int)DISPLAY_Data.HkTlm.Payload.JobMaxPassUs);
+
+    /* housekeeping with the colors unchanged leaves it be; a color change finishes what is under way */
+    UtAssert_True(DISPLAY_JobPending() && UT_Display_JobSteps < 10, "Job still pending after housekeeping (%lu)",
+                  (unsigned long)UT_Display_JobSteps);
+    UT_Display.Table.Brightness = 50;
+    DISPLAY_CheckDevice();
+    UtAssert_True(!DISPLAY_JobPending() && UT_Display_JobSteps == 10, "Job finished");
+    UT_Display.Table.Brightness = 100;
+    DISPLAY_CheckDevice();
+
+    /*
+     * An RGB888 upload, rows alternating white and black, is READY at once
+     * and converted later; an image uploaded above it moves down when the
+     * converted one shrinks
+     */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageUpload.Slot   = 2;
+    UT_Cmd.ImageUpload.Width  = 8;
+    UT_Cmd.ImageUpload.Height = 10;
+    UT_Cmd.ImageUpload.Format = DISPLAY_IMAGE_FORMAT_RGB888;
+    for (i = 0; i < 8 * 10; i++)
+    {
+        memset(&Data[i * 3], ((i / 8) & 1) ? 0 : 0xFF, 3);
+    }
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd, offsetof(DISPLAY_ImageUploadCmd_t, Data) + 240);
+    UT_Display_Upload(3, 2, 2, UT_RGB565_GREEN);
+    UtAssert_True(DISPLAY_ImageGetSlot(2)->State == DISPLAY_IMAGE_SLOT_READY &&
+                      DISPLAY_ImageGetSlot(2)->Format == DISPLAY_IMAGE_FORMAT_RGB565,
+                  "Slot READY before conversion");
+    UtAssert_True(DISPLAY_ImageGetSlot(2)->Size == 240, "Upload kept until converted");
+    UtAssert_True(DISPLAY_JobPending(), "Conversion pending");
+
+    /* drawing it finishes the conversion first */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 2;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UtAssert_True(DISPLAY_ImageGetSlot(2)->Size == 160, "Slot shrunk once converted");
+    for (i = 0; i < 10; i++)
+    {
+        UT_Display_CheckPixel(7, i, (i & 1) ? 0 : UT_RGB565_WHITE);
+    }
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.Slot = 3;
+    UT_Cmd.DrawImage.X    = 20;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UT_Display_CheckPixel(21, 1, UT_RGB565_GREEN);
+
+    /* the job left behind has nothing to do */
+    DISPLAY_JobRun();
+    UtAssert_True(!DISPLAY_JobPending(), "Finished conversion dropped");
+
+    /* neither has the job of a slot freed before it was converted */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageUpload.Slot   = 4;
+    UT_Cmd.ImageUpload.Width  = 8;
+    UT_Cmd.ImageUpload.Height = 10;
+    UT_Cmd.ImageUpload.Format = DISPLAY_IMAGE_FORMAT_RGB888;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd, offsetof(DISPLAY_ImageUploadCmd_t, Data) + 240);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageFree.Slot = 4;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_FREE_CC, &UT_Cmd, sizeof(UT_Cmd.ImageFree));
+    DISPLAY_JobRun();
+    UtAssert_True(!DISPLAY_JobPending() && DISPLAY_ImageGetSlot(4)->State == DISPLAY_IMAGE_SLOT_FREE,
+                  "Freed slot's conversion dropped");
+
+    /* with no budget, conversion is done by the upload itself */
+    UT_Display.Table.JobBudgetUs = 0;
+    DISPLAY_CheckDevice();
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ImageUpload.Slot   = 4;
+    UT_Cmd.ImageUpload.Width  = 8;
+    UT_Cmd.ImageUpload.Height = 10;
+    UT_Cmd.ImageUpload.Format = DISPLAY_IMAGE_FORMAT_RGB888;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_IMAGE_UPLOAD_CC, &UT_Cmd, offsetof(DISPLAY_ImageUploadCmd_t, Data) + 240);
+    UtAssert_True(!DISPLAY_JobPending() && DISPLAY_ImageGetSlot(4)->Size == 160, "Converted on upload");
+
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.JobsPending == 0 && DISPLAY_Data.HkTlm.Payload.JobsDone == 4,
+                  "Jobs done in housekeeping (%lu)", (unsigned long)DISPLAY_Data.HkTlm.Payload.JobsDone);
+}
+
+static void UT_Display_AllocateHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_SB_Buffer_t *SBBufPtr = UserObj;
+
+    UT_Stub_SetReturnValue(FuncKey, SBBufPtr);
+}
+
+void Test_DISPLAY_Lib(void)
+{
+    /*
+     * Test Case For:
+     * CFE_Status_t DISPLAY_LibOpen( uint32 DrawMid, DISPLAY_LibHandle_t *Handle )
+     * CFE_Status_t DISPLAY_LibFillRect( const DISPLAY_LibHandle_t *Handle, ... )
+     * CFE_Status_t DISPLAY_LibBlit565( const DISPLAY_LibHandle_t *Handle, ... )
+     * uint32       DISPLAY_LibPresented( const DISPLAY_LibHandle_t *Handle )
+     * CFE_SB_Buffer_t *DISPLAY_LibUploadAlloc( uint16 Image, uint16 Width, uint16 Height, uint8 Format, ... )
+     * int32 DISPLAY_ProcessLibDraw( uint32 Source, const DISPLAY_LibOp_t *Op )
+     */
+    static uint16             Pixels[4 * 4];
+    DISPLAY_AckTlm_Payload_t *Ack = &DISPLAY_Data.AckTlm.Payload;
+    DISPLAY_ImageUploadCmd_t *Upload;
+    DISPLAY_LibHandle_t       Handle, Stale;
+    DISPLAY_LibOp_t           Op;
+    UT_DisplayCmd_t           Buf;
+    UT_CheckEvent_t           EventTest;
+    uint8                    *Data;
+    uint32                    First, Seq, i;
+
+    UT_Display_Start();
+    UT_SetDefaultReturnValue(UT_KEY(CFE_SB_IsValidMsgId), true);
+
+    /* only a registered client can be drawn as */
+    UT_TEST_FUNCTION_RC(DISPLAY_LibOpen(0x1900, &Handle), DISPLAY_STATUS_ERROR_RANGE);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibOpen(0x1900, NULL), DISPLAY_STATUS_ERROR_NULL);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ClientRegister.DrawMid = 0x1900;
+    UT_Cmd.ClientRegister.X       = 20;
+    UT_Cmd.ClientRegister.Y       = 10;
+    UT_Cmd.ClientRegister.Width   = 40;
+    UT_Cmd.ClientRegister.Height  = 30;
+    UT_Cmd.ClientRegister.Layer   = DISPLAY_LAYER_TELEMETRY;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_REGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientRegister));
+    UT_TEST_FUNCTION_RC(DISPLAY_LibOpen(0x1900, &Handle), CFE_SUCCESS);
+
+    /* draws run on the tick, in the client's viewport, with no message */
+    for (i = 0; i < 4 * 4; i++)
+    {
+        Pixels[i] = UT_RGB565_RED;
+    }
+    First = DISPLAY_LibPresented(&Handle);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 100, 100, UT_White, NULL), CFE_SUCCESS);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibBlit565(&Handle, 2, 2, (const uint8 *)Pixels, 4, 4, &Seq), CFE_SUCCESS);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibBlit565(&Handle, 2, 2, NULL, 4, 4, &Seq), DISPLAY_STATUS_ERROR_NULL);
+
+    /* positions and sizes are limited to what the draw commands carry */
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 0x80000000, 1, UT_White, NULL), DISPLAY_STATUS_ERROR_RANGE);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 1, DISPLAY_LIB_MAX_SIZE + 1, UT_White, NULL),
+                        DISPLAY_STATUS_ERROR_RANGE);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibGradient(&Handle, 0x7FFFFFFF, 0, 4, 4, UT_Red, UT_Blue, true, NULL),
+                        DISPLAY_STATUS_ERROR_RANGE);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibDrawImage(&Handle, 1, 0, DISPLAY_LIB_MIN_COORD - 1, NULL), DISPLAY_STATUS_ERROR_RANGE);
+    UtAssert_True(Seq == First + 2, "Draws numbered in order (%lu)", (unsigned long)Seq);
+    UtAssert_True(DISPLAY_LibPresented(&Handle) == First, "Nothing presented before the tick");
+    DISPLAY_ServiceClients();
+    UT_Display_CheckPixel(20, 10, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(22, 12, UT_RGB565_RED);
+    UT_Display_CheckPixel(59, 39, UT_RGB565_WHITE);
+    UT_Display_CheckPixel(60, 39, 0);
+    UtAssert_True(DISPLAY_LibPresented(&Handle) == Seq, "Presented after the flush (%lu)",
+                  (unsigned long)DISPLAY_LibPresented(&Handle));
+    UtAssert_True(Ack->Source == (0x1900 | DISPLAY_ACK_SOURCE_LIB) && Ack->Sequence == Seq && Ack->Draws == 2,
+                  "Library draws acknowledged");
+
+    /* the client's pipe numbers its draws apart, and is acknowledged apart */
+    memset(&Buf, 0, sizeof(Buf));
+    Buf.FillRect.sizeX = 4;
+    Buf.FillRect.sizeY = 4;
+    UT_Display.MsgId   = CFE_SB_ValueToMsgId(0x1900);
+    UT_Display.FcnCode = DISPLAY_FILLRECT_CC;
+    UT_Display.Size    = sizeof(Buf.FillRect) + sizeof(DISPLAY_DrawSeq_t);
+    UT_Display_SetSeq(&Buf, sizeof(Buf.FillRect), 1, 0);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessClientCommand(&Buf.SBBuf), CFE_SUCCESS);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 4, 4, UT_White, &Seq), CFE_SUCCESS);
+    i = UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg));
+    DISPLAY_ServiceClients();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitMsg)) == i + 2, "Pipe and library acked apart");
+    UtAssert_True(DISPLAY_LibPresented(&Handle) == Seq, "Library sequence kept");
+
+    /* gradients and images too; an image that is not loaded is dropped, and still finished with */
+    UT_TEST_FUNCTION_RC(DISPLAY_LibGradient(&Handle, 0, 0, 4, 4, UT_Red, UT_Blue, true, NULL), CFE_SUCCESS);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibDrawImage(&Handle, 1, 0, 0, &Seq), CFE_SUCCESS);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_IMAGE_ERR_EID, NULL);
+    DISPLAY_ServiceClients();
+    UtAssert_True(EventTest.MatchCount == 1, "Missing image refused (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_LibPresented(&Handle) == Seq, "Dropped draw finished with");
+
+    UT_Display_Upload(1, 2, 2, UT_RGB565_GREEN);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibDrawImage(&Handle, 1, 0, 0, NULL), CFE_SUCCESS);
+    DISPLAY_ServiceClients();
+    UT_Display_CheckPixel(21, 11, UT_RGB565_GREEN);
+
+    memset(&Op, 0, sizeof(Op));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_CLIENT_ERR_EID, NULL);
+    UT_TEST_FUNCTION_RC(DISPLAY_ProcessLibDraw(0x1900, &Op), DISPLAY_STATUS_ERROR_RANGE);
+    UtAssert_True(EventTest.MatchCount == 1, "Unknown draw refused (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* a full ring is reported, not overwritten */
+    for (i = 0; i < DISPLAY_LIB_RING_DEPTH; i++)
+    {
+        DISPLAY_LibFillRect(&Handle, 0, 0, 1, 1, UT_Black, NULL);
+    }
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Handle, 0, 0, 1, 1, UT_Black, NULL), DISPLAY_STATUS_ERROR_BUSY);
+
+    /* once the client is gone its handle is stale, and what it left queued is never drawn */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ClientUnregister.DrawMid = 0x1900;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_UNREGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientUnregister));
+    Stale = Handle;
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Stale, 0, 0, 1, 1, UT_Black, NULL), DISPLAY_STATUS_ERROR_RANGE);
+    UtAssert_True(DISPLAY_LibPresented(&Stale) == 0, "Stale handle has nothing presented");
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.ClientRegister.DrawMid = 0x1900;
+    UT_Cmd.ClientRegister.Width   = 40;
+    UT_Cmd.ClientRegister.Height  = 30;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_REGISTER_CC, &UT_Cmd, sizeof(UT_Cmd.ClientRegister));
+    UT_TEST_FUNCTION_RC(DISPLAY_LibOpen(0x1900, &Handle), CFE_SUCCESS);
+    UtAssert_True(Handle.Generation != Stale.Generation, "New handle for the new client");
+    UT_TEST_FUNCTION_RC(DISPLAY_LibFillRect(&Stale, 0, 0, 1, 1, UT_Black, NULL), DISPLAY_STATUS_ERROR_RANGE);
+    DISPLAY_ServiceClients();
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CLIENT_LIST_CC, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(DISPLAY_Data.ClientListTlm.Payload.Clients[0].Draws == 0, "Earlier client's draws skipped (%lu)",
+                  (unsigned long)DISPLAY_Data.ClientListTlm.Payload.Clients[0].Draws);
+
+    /* uploads are built in place in a bus buffer */
+    UT_SetHandlerFunction(UT_KEY(CFE_SB_AllocateMessageBuffer), UT_Display_AllocateHandler, &Buf.SBBuf);
+    UtAssert_True(DISPLAY_LibUploadAlloc(2, 2, 2, 0xFF, "lib", &Data) == NULL, "Unknown format refused");
+    UtAssert_True(DISPLAY_LibUploadAlloc(2, 200, 200, DISPLAY_IMAGE_FORMAT_RGB888, "lib", &Data) == NULL,
+                  "Oversized upload refused");
+    UtAssert_True(DISPLAY_LibUploadAlloc(2, 2, 2, DISPLAY_IMAGE_FORMAT_RGB565, "lib", &Data) == &Buf.SBBuf,
+                  "Upload buffer allocated");
+    Upload = &Buf.ImageUpload;
+    UtAssert_True(Upload->Slot == 2 && Upload->Width == 2 && Upload->Height == 2 &&
+                      Upload->Format == DISPLAY_IMAGE_FORMAT_RGB565 && strcmp(Upload->Name, "lib") == 0,
+                  "Upload command laid out");
+    UtAssert_True(Data == Upload->Data, "Pixels go straight into the message");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_MSG_SetFcnCode)) == 1, "Upload command code set");
+
+    UT_TEST_FUNCTION_RC(DISPLAY_LibUploadSend(&Buf.SBBuf), CFE_SUCCESS);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_TransmitBuffer)) == 1, "Buffer sent without a copy");
+    UT_SetDeferredRetcode(UT_KEY(CFE_SB_TransmitBuffer), 1, CFE_SB_BAD_ARGUMENT);
+    UT_TEST_FUNCTION_RC(DISPLAY_LibUploadSend(&Buf.SBBuf), CFE_SB_BAD_ARGUMENT);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_SB_ReleaseMessageBuffer)) == 1, "Unsent buffer released");
+    UT_TEST_FUNCTION_RC(DISPLAY_LibUploadSend(NULL), DISPLAY_STATUS_ERROR_NULL);
+
+    UT_SetHandlerFunction(UT_KEY(CFE_SB_AllocateMessageBuffer), UT_Display_AllocateHandler, NULL);
+    UtAssert_True(DISPLAY_LibUploadAlloc(2, 2, 2, DISPLAY_IMAGE_FORMAT_RGB565, "lib", &Data) == NULL,
+                  "No buffer from the bus");
+}
+
+void Test_DISPLAY_Layers(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_LayerSet( const DISPLAY_LayerSetCmd_t *Msg )
+     * int32 DISPLAY_LayerSelect( const DISPLAY_LayerSelectCmd_t *Msg )
+     */
+    UT_CheckEvent_t EventTest;
+
+    UT_Display_Start();
+
+    UT_Display_Fill(0, 0, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT, UT_Blue);
+
+    /* the alert layer shows over the background where it is not black */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.LayerSelect.layer = DISPLAY_LAYER_ALERT;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_LAYER_SELECT_CC, &UT_Cmd, sizeof(UT_Cmd.LayerSelect));
+    UT_Display_Fill(10, 10, 5, 5, UT_Red);
+    UT_Display_CheckPixel(10, 10, UT_RGB565_RED);
+    UT_Display_CheckPixel(15, 10, UT_RGB565_BLUE);
+
+    /* hidden, the background shows again */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.LayerSet.layer   = DISPLAY_LAYER_ALERT;
+    UT_Cmd.LayerSet.z       = DISPLAY_LAYER_ALERT;
+    UT_Cmd.LayerSet.visible = 0;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_LAYER_SET_CC, &UT_Cmd, sizeof(UT_Cmd.LayerSet));
+    UT_Display_CheckPixel(10, 10, UT_RGB565_BLUE);
+
+    /* visible and opaque, it hides everything below */
+    UT_Cmd.LayerSet.visible    = 1;
+    UT_Cmd.LayerSet.keyEnabled = 0;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_LAYER_SET_CC, &UT_Cmd, sizeof(UT_Cmd.LayerSet));
+    UT_Display_CheckPixel(10, 10, UT_RGB565_RED);
+    UT_Display_CheckPixel(15, 10, 0);
+
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, "DISPLAY: invalid layer %u");
+    UT_Cmd.LayerSet.layer = DISPLAY_MAX_LAYERS;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_LAYER_SET_CC, &UT_Cmd, sizeof(UT_Cmd.LayerSet));
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.LayerSelect.layer = DISPLAY_MAX_LAYERS;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_LAYER_SELECT_CC, &UT_Cmd, sizeof(UT_Cmd.LayerSelect));
+    UtAssert_True(EventTest.MatchCount == 2, "Invalid layers refused (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_Rotation(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_FbPresent( const DISPLAY_Surface_t *Src, const DISPLAY_Rect_t *Rect, uint8 Rotation )
+     *
+     * The logical origin lands in a different panel corner for each
+     * mounting.
+     */
+    static const struct
+    {
+        uint8  Rotation;
+        uint32 X;
+        uint32 Y;
+    } Corner[] = {
+        {DISPLAY_ROTATE_90, UT_DISPLAY_WIDTH - 1, 0},
+        {DISPLAY_ROTATE_180, UT_DISPLAY_WIDTH - 1, UT_DISPLAY_HEIGHT - 1},
+        {DISPLAY_ROTATE_270, 0, UT_DISPLAY_HEIGHT - 1},
+    };
+    const DISPLAY_Surface_t *Surface;
+    uint32                   i;
+
+    for (i = 0; i < sizeof(Corner) / sizeof(Corner[0]); i++)
+    {
+        UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT, 16);
+        UT_Display.Table.Rotation = Corner[i].Rotation;
+        UT_Display_Start();
+
+        Surface = DISPLAY_RenderGetSurface();
+        if (Corner[i].Rotation == DISPLAY_ROTATE_180)
+        {
+            UtAssert_True(Surface->Width == UT_DISPLAY_WIDTH, "Logical width kept");
+        }
+        else
+        {
+            UtAssert_True(Surface->Width == UT_DISPLAY_HEIGHT, "Logical width is the panel height");
+        }
+
+        UT_Display_Fill(0, 0, 1, 1, UT_Red);
+        UT_Display_CheckPixel(Corner[i].X, Corner[i].Y, UT_RGB565_RED);
+        UT_Display_CheckPixel(0, 0, (Corner[i].X == 0 && Corner[i].Y == 0) ? UT_RGB565_RED : 0);
+
+        Display_UT_TearDown();
+    }
+}
+
+void Test_DISPLAY_Record(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_RecordStartCmd( const DISPLAY_RecordStartCmd_t *Msg )
+     * int32 DISPLAY_RecordStopCmd( const DISPLAY_RecordStopCmd_t *Msg )
+     * void  DISPLAY_RecordPacket( uint8 Source, const CFE_SB_Buffer_t *SBBufPtr )
+     */
+    UT_CheckEvent_t EventTest;
+
+    UT_Display_Start();
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    strncpy(UT_Cmd.RecordStart.Filename, "/ram/ut.log", sizeof(UT_Cmd.RecordStart.Filename));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_RECORD_INF_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_RECORD_START_CC, &UT_Cmd, sizeof(UT_Cmd.RecordStart));
+    UtAssert_True(EventTest.MatchCount == 1, "Recording started (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* logged and written out at housekeeping */
+    UT_Display_Fill(0, 0, 1, 1, UT_White);
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.Recording == 1, "Recording reported");
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.RecordMessages == 1, "Draw logged (%lu)",
+                  (unsigned long)DISPLAY_Data.HkTlm.Payload.RecordMessages);
+
+    /* a failed write stops the recorder */
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, OS_ERROR);
+    UT_Display_Fill(0, 0, 1, 1, UT_White);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_RECORD_ERR_EID, NULL);
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(EventTest.MatchCount == 1, "Write failure reported (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.HkTlm.Payload.Recording == 0, "Recording stopped");
+
+    /* cannot open the log */
+    UT_SetDeferredRetcode(UT_KEY(OS_OpenCreate), 1, OS_ERROR);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_RECORD_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_RECORD_START_CC, &UT_Cmd, sizeof(UT_Cmd.RecordStart));
+    UtAssert_True(EventTest.MatchCount == 1, "Open failure reported (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* started again and stopped cleanly */
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_RECORD_START_CC, &UT_Cmd, sizeof(UT_Cmd.RecordStart));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_RECORD_INF_EID, "DISPLAY: command log closed, %lu messages, %lu bytes");
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_RECORD_STOP_CC, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(EventTest.MatchCount == 1, "Recording closed (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* a failed final write is reported by the stop command */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    strncpy(UT_Cmd.RecordStart.Filename, "/ram/ut.log", sizeof(UT_Cmd.RecordStart.Filename));
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_RECORD_START_CC, &UT_Cmd, sizeof(UT_Cmd.RecordStart));
+    UT_Display_Fill(0, 0, 1, 1, UT_White);
+    UT_SetDeferredRetcode(UT_KEY(OS_write), 1, OS_ERROR);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_RECORD_ERR_EID, NULL);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_TEST_FUNCTION_RC(DISPLAY_RecordStopCmd(&UT_Cmd.NoArgs), DISPLAY_STATUS_ERROR_WRITE);
+    UtAssert_True(EventTest.MatchCount == 1, "Final write failure reported (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_Anim(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_AnimSetCmd( const DISPLAY_AnimSetCmd_t *Msg )
+     * int32 DISPLAY_AnimStopCmd( const DISPLAY_AnimStopCmd_t *Msg )
+     */
+    UT_CheckEvent_t EventTest;
+
+    UT_Display_Start();
+
+    /* a 4x4 red square stepping 10 pixels right after half a second */
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.AnimSet.Id            = 2;
+    UT_Cmd.AnimSet.Target        = DISPLAY_ANIM_TARGET_RECT;
+    UT_Cmd.AnimSet.Property      = DISPLAY_ANIM_PROP_X;
+    UT_Cmd.AnimSet.Easing        = DISPLAY_ANIM_EASE_STEP;
+    UT_Cmd.AnimSet.Layer         = DISPLAY_LAYER_ALERT;
+    UT_Cmd.AnimSet.Mode          = DISPLAY_ANIM_MODE_ONCE;
+    UT_Cmd.AnimSet.KeyCount      = 2;
+    UT_Cmd.AnimSet.PeriodMs      = 1000;
+    UT_Cmd.AnimSet.Width         = 4;
+    UT_Cmd.AnimSet.Height        = 4;
+    UT_Cmd.AnimSet.Color         = UT_Red;
+    UT_Cmd.AnimSet.Keys[0].Time  = 0;
+    UT_Cmd.AnimSet.Keys[0].Value = 0;
+    UT_Cmd.AnimSet.Keys[1].Time  = 500;
+    UT_Cmd.AnimSet.Keys[1].Value = 10;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_ANIM_SET_CC, &UT_Cmd, sizeof(UT_Cmd.AnimSet));
+    UtAssert_True(DISPLAY_Data.CmdCounter == 1, "Animation accepted");
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UT_Display_CheckPixel(0, 0, UT_RGB565_RED);
+
+    UT_Display_SetTimeMs(1000 + 600);
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UT_Display_CheckPixel(0, 0, 0);
+    UT_Display_CheckPixel(10, 0, UT_RGB565_RED);
+
+    /* stopped and erased */
+    UT_Cmd.AnimStop.Id    = 2;
+    UT_Cmd.AnimStop.Clear = 1;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_ANIM_STOP_CC, &UT_Cmd, sizeof(UT_Cmd.AnimStop));
+    UT_Display_CheckPixel(10, 0, 0);
+
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_ANIM_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_ANIM_STOP_CC, &UT_Cmd, sizeof(UT_Cmd.AnimStop));
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.AnimSet.Id = DISPLAY_MAX_ANIMS;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_ANIM_SET_CC, &UT_Cmd, sizeof(UT_Cmd.AnimSet));
+    UtAssert_True(EventTest.MatchCount == 2, "Invalid animations refused (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_CrcCmd(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_CrcCmd( const DISPLAY_CrcCmd_t *Msg )
+     */
+    UT_CheckEvent_t EventTest;
+    uint16          Blank;
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CRC_CC, &UT_Cmd, sizeof(UT_Cmd.Crc));
+    UtAssert_True(EventTest.MatchCount == 1, "Checksum refused without a panel (%u)",
+                  (unsigned int)EventTest.MatchCount);
+
+    UT_Display_Start();
+
+    /* an empty rectangle covers the whole frame */
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CRC_CC, &UT_Cmd, sizeof(UT_Cmd.Crc));
+    UtAssert_True(DISPLAY_Data.CrcTlm.Payload.Area.W == UT_DISPLAY_WIDTH, "Whole frame checksummed");
+    UtAssert_True(DISPLAY_Data.CrcTlm.Payload.Tiles == (UT_DISPLAY_WIDTH / DISPLAY_CRC_TILE) *
+                                                           (UT_DISPLAY_HEIGHT / DISPLAY_CRC_TILE),
+                  "Every tile counted (%u)", (unsigned int)DISPLAY_Data.CrcTlm.Payload.Tiles);
+    Blank = DISPLAY_Data.CrcTlm.Payload.Crc;
+
+    /* changes with the content */
+    UT_Display_Fill(5, 5, 1, 1, UT_White);
+    UT_Cmd.Crc.X = 0;
+    UT_Cmd.Crc.Y = 0;
+    UT_Cmd.Crc.W = 8;
+    UT_Cmd.Crc.H = 8;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CRC_CC, &UT_Cmd, sizeof(UT_Cmd.Crc));
+    UtAssert_True(DISPLAY_Data.CrcTlm.Payload.Area.W == DISPLAY_CRC_TILE, "Widened to a whole tile");
+    UtAssert_True(DISPLAY_Data.CrcTlm.Payload.Crc != Blank, "Checksum follows the content");
+
+    /* outside the frame */
+    UT_Cmd.Crc.X = UT_DISPLAY_WIDTH;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_COMMAND_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_CRC_CC, &UT_Cmd, sizeof(UT_Cmd.Crc));
+    UtAssert_True(EventTest.MatchCount == 1, "Area off the frame refused (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_Screenshot(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_ScreenshotCmd( const DISPLAY_ScreenshotCmd_t *Msg )
+     * void  DISPLAY_SendShotPacket( size_t Size )
+     */
+    UT_CheckEvent_t EventTest;
+    uint32          Ticks;
+
+    UT_Display_Start();
+    UT_Display_Fill(0, 0, 16, 16, UT_Green);
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.Screenshot.Mode = DISPLAY_SHOT_MODE_FULL;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_SHOT_INF_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_SCREENSHOT_CC, &UT_Cmd, sizeof(UT_Cmd.Screenshot));
+    UtAssert_True(EventTest.MatchCount == 1, "Screenshot started (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* one capture at a time */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_SHOT_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_SCREENSHOT_CC, &UT_Cmd, sizeof(UT_Cmd.Screenshot));
+    UtAssert_True(EventTest.MatchCount == 1, "Second capture refused (%u)", (unsigned int)EventTest.MatchCount);
+
+    /* stream on the frame tick until the last packet */
+    for (Ticks = 0; Ticks < 100 && !(DISPLAY_Data.ShotTlm.Payload.Flags & DISPLAY_SHOT_FLAG_LAST); Ticks++)
+    {
+        UT_Display_SetTimeMs(1000 + (Ticks + 1) * 100);
+        UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    }
+    UtAssert_True(DISPLAY_Data.ShotTlm.Payload.Flags & DISPLAY_SHOT_FLAG_LAST, "Capture finished in %lu ticks",
+                  (unsigned long)Ticks);
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_MSG_SetSize)) > 0, "Packets cut to size");
+    UtAssert_True(DISPLAY_Data.ShotTlm.Payload.Width == UT_DISPLAY_WIDTH, "Frame width reported");
+
+    /* bad mode */
+    UT_Cmd.Screenshot.Mode = 9;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_SHOT_ERR_EID, NULL);
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_SCREENSHOT_CC, &UT_Cmd, sizeof(UT_Cmd.Screenshot));
+    UtAssert_True(EventTest.MatchCount == 1, "Bad mode refused (%u)", (unsigned int)EventTest.MatchCount);
+}
+
+void Test_DISPLAY_IdleBlank(void)
+{
+    /*
+     * Test Case For:
+     * Blanking the panel after the table's idle timeout, and waking it
+     */
+    UT_Display.Table.IdleBlankMs = 2000;
+    UT_Display_Start();
+
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(!UT_FakeFb.Blanked, "Panel on while within the timeout");
+
+    UT_Display_SetTimeMs(1000 + 2500);
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(UT_FakeFb.Blanked, "Panel blanked after the timeout");
+
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.Blanked == 1, "Blank reported");
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.IdleMs >= 2000, "Idle time reported (%lu)",
+                  (unsigned long)DISPLAY_Data.PerfTlm.Payload.IdleMs);
+
+    UT_Display_Fill(0, 0, 1, 1, UT_White);
+    UtAssert_True(!UT_FakeFb.Blanked, "Panel woken by a draw");
+
+    /* a panel that refuses to blank is only tried once per idle spell */
+    UT_FakeFb.FailMask = UT_FAKEFB_FAIL_BLANK;
+    UT_FakeFb.BlankCalls = 0;
+    UT_Display_SetTimeMs(1000 + 6000);
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UT_Display_SetTimeMs(1000 + 9000);
+    UT_Display_Send(DISPLAY_WAKEUP_MID, 0, &UT_Cmd, sizeof(UT_Cmd.NoArgs));
+    UtAssert_True(UT_FakeFb.BlankCalls == 1, "Blank tried once (%lu)", (unsigned long)UT_FakeFb.BlankCalls);
+}
+
+void Test_DISPLAY_CheckDevice(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_CheckDevice( void )
+     * CFE_Status_t DISPLAY_FbCheck( const DISPLAY_Table_t *TblPtr )
+     */
+    UT_CheckEvent_t EventTest;
+
+    UT_Display_Start();
+    UT_Display_Fill(0, 0, 1, 1, UT_White);
+
+    /* nothing changed */
+    DISPLAY_CheckDevice();
+    UtAssert_True(UT_FakeFb.MapCalls == 1, "Mapping kept");
+
+    /* device node removed */
+    UT_FakeFb.Present = false;
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_FB_ERR_EID, NULL);
+    DISPLAY_CheckDevice();
+    UtAssert_True(EventTest.MatchCount == 1, "Loss reported (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(!DISPLAY_FbIsMapped(), "Unmapped");
+
+    /* still gone: probed quietly */
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_FB_ERR_EID, NULL);
+    DISPLAY_CheckDevice();
+    UtAssert_True(EventTest.MatchCount == 0, "Absence not reported again");
+
+    /* back: remapped and repainted from the last frame */
+    UT_FakeFb.Present = true;
+    memset(UT_FakeFb.Pixels, 0, UT_FakeFb.Size);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_FB_INF_EID, NULL);
+    DISPLAY_CheckDevice();
+    UtAssert_True(EventTest.MatchCount == 1, "Remap reported (%u)", (unsigned int)EventTest.MatchCount);
+    UT_Display_CheckPixel(0, 0, UT_RGB565_WHITE);
+
+    /* driver reloaded under the same name */
+    UT_FakeFb.Rdev++;
+    DISPLAY_CheckDevice();
+    UtAssert_True(UT_FakeFb.MapCalls == 3, "Remapped after a reload (%lu)", (unsigned long)UT_FakeFb.MapCalls);
+
+    /* geometry changed by the driver: new buffers, nothing from before */
+    UT_FakeFb.Width      = 128;
+    UT_FakeFb.Height     = 160;
+    UT_FakeFb.LineLength = 128 * 2;
+    DISPLAY_CheckDevice();
+    UtAssert_True(DISPLAY_RenderGetSurface()->Width == 128, "Back buffer follows the geometry");
+
+    /* geometry probe fails */
+    UT_FakeFb.FailMask = UT_FAKEFB_FAIL_VARINFO;
+    DISPLAY_CheckDevice();
+    UtAssert_True(!DISPLAY_FbIsMapped(), "Unmapped after a failed probe");
+    UT_FakeFb.FailMask = 0;
+
+    /* table names another device */
+    UT_FakeFb_Reset("/dev/fb-ut2", UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT, 16);
+    DISPLAY_CheckDevice();
+    UtAssert_True(!DISPLAY_FbIsMapped(), "Old path not found");
+    strncpy((char *)UT_Display.Table.DevicePath, "/dev/fb-ut2", sizeof(UT_Display.Table.DevicePath));
+    DISPLAY_CheckDevice();
+    UtAssert_True(DISPLAY_FbIsMapped(), "New path mapped");
+    UT_Display_Fill(0, 0, 1, 1, UT_White);
+    strncpy((char *)UT_Display.Table.DevicePath, UT_DISPLAY_FB_PATH, sizeof(UT_Display.Table.DevicePath));
+    DISPLAY_CheckDevice();
+    UtAssert_True(!DISPLAY_FbIsMapped(), "Switched away from the mapped path");
+
+    /* no room for the back buffer */
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, 640, 480, 32);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_FB_ERR_EID, NULL);
+    DISPLAY_CheckDevice();
+    UtAssert_True(EventTest.MatchCount == 1, "Configure failure reported (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(!DISPLAY_RenderIsReady(), "Nothing to draw on");
+
+    /* table errors */
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_GetAddress), 1, CFE_TBL_ERR_UNREGISTERED);
+    DISPLAY_CheckDevice();
+    UT_SetDeferredRetcode(UT_KEY(CFE_TBL_ReleaseAddress), 1, CFE_TBL_ERR_UNREGISTERED);
+    DISPLAY_CheckDevice();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_WriteToSysLog)) == 2, "Table errors logged");
+}
+
+void Test_DISPLAY_FbInit(void)
+{
+    /*
+     * Test Case For:
+     * CFE_Status_t DISPLAY_FbInit( const DISPLAY_Table_t *TblPtr )
+     */
+    static const struct
+    {
+        uint32       FailMask;
+        CFE_Status_t Expected;
+    } Failure[] = {
+        {UT_FAKEFB_FAIL_OPEN, DISPLAY_STATUS_ERROR_OPEN},    {UT_FAKEFB_FAIL_FSTAT, DISPLAY_STATUS_ERROR_OPEN},
+        {UT_FAKEFB_FAIL_FIXINFO, DISPLAY_STATUS_ERROR_READ}, {UT_FAKEFB_FAIL_VARINFO, DISPLAY_STATUS_ERROR_READ},
+        {UT_FAKEFB_FAIL_MMAP, DISPLAY_STATUS_ERROR_OPEN},
+    };
+    const DISPLAY_FbInfo_t *Info;
+    uint32                  i;
+
+    UT_TEST_FUNCTION_RC(DISPLAY_FbInit(NULL), DISPLAY_STATUS_ERROR_NULL);
+    UT_TEST_FUNCTION_RC(DISPLAY_FbCheck(NULL), DISPLAY_STATUS_ERROR_NULL);
+
+    for (i = 0; i < sizeof(Failure) / sizeof(Failure[0]); i++)
+    {
+        UT_FakeFb.FailMask = Failure[i].FailMask;
+        UT_TEST_FUNCTION_RC(DISPLAY_FbInit(&UT_Display.Table), Failure[i].Expected);
+        UtAssert_True(!UT_FakeFb.Open && !UT_FakeFb.Mapped, "Nothing left open after failure 0x%02lx",
+                      (unsigned long)Failure[i].FailMask);
+    }
+
+    /* 32 bpp panel with padded lines */
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, 100, 50, 32);
+    UT_FakeFb.LineLength = 512;
+    UT_TEST_FUNCTION_RC(DISPLAY_FbInit(&UT_Display.Table), CFE_SUCCESS);
+    Info = DISPLAY_FbGetInfo();
+    UtAssert_True(Info->BytesPerPixel == 4 && Info->LineLength == 512 && Info->Size == 512 * 50,
+                  "32 bpp geometry read");
+    UtAssert_True(Info->Format.RedOffset == 16 && Info->Format.RedLength == 8, "Pixel format read");
+
+    /* no line length reported: packed lines assumed */
+    UT_FakeFb.LineLength = 0;
+    UT_TEST_FUNCTION_RC(DISPLAY_FbInit(&UT_Display.Table), DISPLAY_STATUS_ERROR_OPEN);
+    DISPLAY_FbClose();
+}
+
+void Test_DISPLAY_Fb32(void)
+{
+    /*
+     * Test Case For:
+     * Drawing on a 32 bpp panel with padded lines
+     */
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT, 32);
+    UT_FakeFb.LineLength = UT_DISPLAY_WIDTH * 4 + 64;
+
+    /* four layers and the back buffer at four bytes a pixel */
+    UT_Display.Table.PoolSize[DISPLAY_POOL_FRAME] = 512 * 1024;
+    UT_Display_Start();
+
+    UT_Display_Fill(1, 1, 2, 2, UT_Red);
+    UT_Display_CheckPixel(1, 1, 0xFF0000);
+    UT_Display_CheckPixel(2, 2, 0xFF0000);
+    UT_Display_CheckPixel(3, 2, 0);
+
+    UT_Display_Upload(0, 2, 1, UT_RGB565_BLUE);
+    memset(&UT_Cmd, 0, sizeof(UT_Cmd));
+    UT_Cmd.DrawImage.X = 10;
+    UT_Display_Send(DISPLAY_CMD_MID, DISPLAY_DRAW_IMAGE_CC, &UT_Cmd, sizeof(UT_Cmd.DrawImage));
+    UT_Display_CheckPixel(11, 0, 0x0000F8);
+}
+
+void Test_DISPLAY_FbBlank(void)
+{
+    /*
+     * Test Case For:
+     * CFE_Status_t DISPLAY_FbBlank( bool Blank )
+     */
+    UT_TEST_FUNCTION_RC(DISPLAY_FbBlank(true), DISPLAY_STATUS_ERROR_OPEN);
+
+    UT_TEST_FUNCTION_RC(DISPLAY_FbInit(&UT_Display.Table), CFE_SUCCESS);
+    UT_TEST_FUNCTION_RC(DISPLAY_FbBlank(true), CFE_SUCCESS);
+    UtAssert_True(UT_FakeFb.Blanked, "Panel blanked");
+    UT_TEST_FUNCTION_RC(DISPLAY_FbBlank(false), CFE_SUCCESS);
+    UtAssert_True(!UT_FakeFb.Blanked, "Panel unblanked");
+
+    UT_FakeFb.FailMask = UT_FAKEFB_FAIL_BLANK;
+    UT_TEST_FUNCTION_RC(DISPLAY_FbBlank(true), DISPLAY_STATUS_ERROR_WRITE);
+}
+
+void Test_DISPLAY_Stream(void)
+{
+    /*
+     * Test Case For:
+     * uint8 DISPLAY_StreamSelect( uint8 Path )
+     * void  DISPLAY_StreamCopy( uint8 *Dst, const uint8 *Src, uint32 Length )
+     *
+     * Every path the CPU has must match memcpy for any alignment and
+     * length, including rows too short to stream and ragged ends.
+     */
+    static const uint32 Lengths[] = {0, 1, 63, 64, 127, 128, 129, 320, 1000};
+    static uint8        Src[1100];
+    static uint8        Dst[1100];
+    static uint8        Expect[1100];
+    uint8               Best = DISPLAY_StreamDetect();
+    uint8               Path;
+    uint32              i, Offset;
+    bool                Match;
+
+    for (i = 0; i < sizeof(Src); i++)
+    {
+        Src[i] = (uint8)(i * 7 + 3);
+    }
+
+    for (Path = DISPLAY_PRESENT_PATH_SCALAR; Path <= Best; Path++)
+    {
+        UtAssert_True(DISPLAY_StreamSelect(Path) == Path, "Path %u selected", (unsigned int)Path);
+        UtAssert_True(DISPLAY_StreamGetPath() == Path, "Path %u in use", (unsigned int)Path);
+
+        Match = true;
+        for (i = 0; i < sizeof(Lengths) / sizeof(Lengths[0]); i++)
+        {
+            for (Offset = 0; Offset < 40; Offset += 13)
+            {
+                memset(Dst, 0xAA, sizeof(Dst));
+                memset(Expect, 0xAA, sizeof(Expect));
+                memcpy(Expect + Offset, Src + 5, Lengths[i]);
+                DISPLAY_StreamCopy(Dst + Offset, Src + 5, Lengths[i]);
+                DISPLAY_StreamFence();
+                Match = Match && (memcmp(Dst, Expect, sizeof(Dst)) == 0);
+            }
+        }
+        UtAssert_True(Match, "Path %u copies match memcpy", (unsigned int)Path);
+    }
+
+    /* a path the CPU lacks falls back to ordinary stores */
+    UtAssert_True(DISPLAY_StreamSelect(Best + 1) == DISPLAY_PRESENT_PATH_SCALAR, "Unknown path refused");
+}
+
+void Test_DISPLAY_PresentPaths(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_FbPresent( const DISPLAY_Surface_t *Src, const DISPLAY_Rect_t *Rect, uint8 Rotation )
+     *
+     * Rows wider than the 180 degree bounce buffer, on every copy path,
+     * in both row-order rotations.
+     */
+    static uint32           Pixels[200 * 6];
+    const DISPLAY_FbInfo_t *Info;
+    DISPLAY_Surface_t       Frame;
+    DISPLAY_Rect_t          Rect = {3, 1, 190, 4};
+    uint8                   Best = DISPLAY_StreamDetect();
+    uint8                   Path;
+    uint32                  x, y, Expected, Wrong;
+
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, 200, 6, 32);
+    UT_TEST_FUNCTION_RC(DISPLAY_FbInit(&UT_Display.Table), CFE_SUCCESS);
+    Info = DISPLAY_FbGetInfo();
+
+    for (x = 0; x < 200 * 6; x++)
+    {
+        Pixels[x] = x + 1;
+    }
+    Frame.Pixels = (uint8 *)Pixels;
+    Frame.Width  = 200;
+    Frame.Height = 6;
+    Frame.Stride = 200 * 4;
+    Frame.Format = Info->Format;
+
+    for (Path = DISPLAY_PRESENT_PATH_SCALAR; Path <= Best; Path++)
+    {
+        DISPLAY_StreamSelect(Path);
+
+        memset(UT_FakeFb.Pixels, 0, UT_FakeFb.Size);
+        DISPLAY_FbPresent(&Frame, &Rect, DISPLAY_ROTATE_0);
+        Wrong = 0;
+        for (y = 0; y < 6; y++)
+        {
+            for (x = 0; x < 200; x++)
+            {
+                Expected = (x >= 3 && x < 193 && y >= 1 && y < 5) ? Pixels[y * 200 + x] : 0;
+                Wrong += (UT_FakeFb_GetPixel(x, y) != Expected);
+            }
+        }
+        UtAssert_True(Wrong == 0, "Path %u upright copy exact (%lu wrong)", (unsigned int)Path, (unsigned long)Wrong);
+
+        memset(UT_FakeFb.Pixels, 0, UT_FakeFb.Size);
+        DISPLAY_FbPresent(&Frame, &Rect, DISPLAY_ROTATE_180);
+        Wrong = 0;
+        for (y = 0; y < 6; y++)
+        {
+            for (x = 0; x < 200; x++)
+            {
+                Expected = (x >= 3 && x < 193 && y >= 1 && y < 5) ? Pixels[y * 200 + x] : 0;
+                Wrong += (UT_FakeFb_GetPixel(199 - x, 5 - y) != Expected);
+            }
+        }
+        UtAssert_True(Wrong == 0, "Path %u inverted copy exact (%lu wrong)", (unsigned int)Path, (unsigned long)Wrong);
+    }
+
+    DISPLAY_StreamSelect(DISPLAY_PRESENT_PATH_SCALAR);
+}
+
+void Test_DISPLAY_PresentCalibration(void)
+{
+    /*
+     * Test Case For:
+     * Choosing the copy path when the device is configured
+     */
+    UT_Display_Start();
+
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.CalScalarKBps > 0, "Ordinary store rate measured (%lu KB/s)",
+                  (unsigned long)DISPLAY_Data.PerfTlm.Payload.CalScalarKBps);
+    UtAssert_True((DISPLAY_Data.PerfTlm.Payload.CalStreamKBps > 0) ==
+                      (DISPLAY_StreamDetect() != DISPLAY_PRESENT_PATH_SCALAR),
+                  "Streaming rate measured where the CPU has it (%lu KB/s)",
+                  (unsigned long)DISPLAY_Data.PerfTlm.Payload.CalStreamKBps);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.PresentPath == DISPLAY_StreamGetPath(), "Path in use reported");
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.PresentPath == DISPLAY_PRESENT_PATH_SCALAR ||
+                      DISPLAY_Data.PerfTlm.Payload.CalStreamKBps >= DISPLAY_Data.PerfTlm.Payload.CalScalarKBps,
+                  "Streaming kept only when it was faster");
+}
+
+void Test_DISPLAY_RefreshPacing(void)
+{
+    /*
+     * Test Case For:
+     * CFE_Status_t DISPLAY_FbWaitVsync( void )
+     * void DISPLAY_RenderFlush( bool Paced ), timed to the panel refresh
+     *
+     * Frame ticks are paced; ground draws go out at once.
+     */
+    DISPLAY_PerfTlm_Payload_t *Perf = &DISPLAY_Data.PerfTlm.Payload;
+    DISPLAY_Rect_t             Rect = {0, 0, 10, 10};
+    struct timespec            Start, End;
+    uint32                     Vsyncs, Late, i;
+    uint64                     ElapsedUs;
+
+    /* a driver's vertical blank is assumed when mapped, not waited on */
+    UT_Display_Start();
+    UtAssert_True(UT_FakeFb.VsyncCalls == 0, "Vertical blank not waited on when mapped");
+    UT_Display_Fill(0, 0, 10, 10, UT_Red);
+    UtAssert_True(UT_FakeFb.VsyncCalls == 0, "Ground draw flushed at once");
+
+    /* a frame tick waits for it once per flush */
+    DISPLAY_RenderFillRect(&Rect, UT_Green);
+    DISPLAY_ServiceClients();
+    UtAssert_True(UT_FakeFb.VsyncCalls == 1, "Frame tick waited for the vertical blank");
+    UT_Display_CheckPixel(5, 5, UT_RGB565_GREEN);
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(Perf->PacePath == DISPLAY_PACE_VSYNC && Perf->RefreshUs == 0, "Driver pacing, no period");
+    UtAssert_True(Perf->LatePresents == 0, "No late presents (%lu)", (unsigned long)Perf->LatePresents);
+
+    /* the driver's own video timings win over the table */
+    UT_FakeFb.Pixclock         = 813802;
+    UT_Display.Table.RefreshUs = 2000;
+    UT_FakeFb.Rdev++;
+    DISPLAY_CheckDevice();
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(Perf->RefreshUs == 16666, "Period from the pixel clock (%lu)", (unsigned long)Perf->RefreshUs);
+
+    /* a driver with no vertical blank is found out on the first paced flush, which falls back to the timer */
+    UT_FakeFb.Pixclock = 0;
+    UT_FakeFb.FailMask = UT_FAKEFB_FAIL_VSYNC;
+    UT_FakeFb.Rdev++;
+    DISPLAY_CheckDevice();
+    Vsyncs = UT_FakeFb.VsyncCalls;
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    for (i = 0; i < 5; i++)
+    {
+        DISPLAY_RenderFillRect(&Rect, (i & 1) ? UT_Red : UT_Green);
+        DISPLAY_ServiceClients();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &End);
+    ElapsedUs = (uint64)(End.tv_sec - Start.tv_sec) * 1000000 + (End.tv_nsec - Start.tv_nsec) / 1000;
+    UtAssert_True(UT_FakeFb.VsyncCalls == Vsyncs + 1, "Vertical blank tried once (%lu)",
+                  (unsigned long)(UT_FakeFb.VsyncCalls - Vsyncs));
+    UtAssert_True(ElapsedUs >= 4 * 2000, "Five ticks spread over four periods (%lu us)", (unsigned long)ElapsedUs);
+    UT_Display_CheckPixel(5, 5, UT_RGB565_GREEN);
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(Perf->PacePath == DISPLAY_PACE_TIMER && Perf->RefreshUs == 2000, "Timer pacing reported");
+    UtAssert_True(Perf->LastJitterUs <= Perf->MaxJitterUs, "Jitter reported (%lu us, most %lu us)",
+                  (unsigned long)Perf->LastJitterUs, (unsigned long)Perf->MaxJitterUs);
+
+    /* ground draws are not held for the refresh, however long it is */
+    UT_Display.Table.RefreshUs = DISPLAY_MAX_REFRESH_US;
+    DISPLAY_CheckDevice();
+    DISPLAY_RenderFillRect(&Rect, UT_Blue);
+    DISPLAY_ServiceClients();
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    for (i = 0; i < 5; i++)
+    {
+        UT_Display_Fill(0, 0, 10, 10, (i & 1) ? UT_Red : UT_Green);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &End);
+    ElapsedUs = (uint64)(End.tv_sec - Start.tv_sec) * 1000000 + (End.tv_nsec - Start.tv_nsec) / 1000;
+    UtAssert_True(ElapsedUs < DISPLAY_MAX_REFRESH_US, "Five ground draws within one period (%lu us)",
+                  (unsigned long)ElapsedUs);
+    UT_Display_CheckPixel(5, 5, UT_RGB565_GREEN);
+
+    /* a whole frame cannot be copied within a 1us refresh; only paced copies can be late */
+    Late                       = Perf->LatePresents;
+    UT_Display.Table.RefreshUs = 1;
+    DISPLAY_CheckDevice();
+    UT_Display_Fill(0, 0, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT, UT_Blue);
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(Perf->LatePresents == Late, "Ground draw not late (%lu)", (unsigned long)Perf->LatePresents);
+    Rect.W = UT_DISPLAY_WIDTH;
+    Rect.H = UT_DISPLAY_HEIGHT;
+    DISPLAY_RenderFillRect(&Rect, UT_Red);
+    DISPLAY_ServiceClients();
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(Perf->LatePresents == Late + 1, "Late present counted (%lu)", (unsigned long)Perf->LatePresents);
+
+    /* with no period either, frame ticks go out at once */
+    UT_Display.Table.RefreshUs = 0;
+    DISPLAY_CheckDevice();
+    DISPLAY_RenderFillRect(&Rect, UT_Blue);
+    DISPLAY_ServiceClients();
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(Perf->PacePath == DISPLAY_PACE_NONE && Perf->LatePresents == Late + 1, "No pacing");
+
+    /* nothing to wait on once the device is gone */
+    DISPLAY_FbClose();
+    UT_TEST_FUNCTION_RC(DISPLAY_FbWaitVsync(), DISPLAY_STATUS_ERROR_OPEN);
+}
+
+/*
+ * Keep the entry point of the last child task created
+ */
+static void UT_Display_ChildTaskHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    *(CFE_ES_TaskEntryFuncPtr_t *)UserObj = UT_Hook_GetArgValueByName(Context, "FunctionPtr", CFE_ES_TaskEntryFuncPtr_t);
+}
+
+/*
+ * Fill, gradients both ways and a blit, all large enough to be split, at
+ * offsets that put no band edge on the dither period by accident. Each is
+ * drawn before the next is made, so none is clipped to a smaller piece.
+ */
+static void UT_Display_DrawLarge(void)
+{
+    static uint16   Image[300 * 200];
+    DISPLAY_Rect_t  Fill  = {1, 3, 500, 250};
+    DISPLAY_Rect_t  Horiz = {7, 5, 480, 203};
+    DISPLAY_Rect_t  Vert  = {-9, -2, 300, 260};
+    DISPLAY_Color_t Teal  = {0, 128, 128, 255};
+    uint32          i;
+
+    for (i = 0; i < 300 * 200; i++)
+    {
+        Image[i] = (uint16)(i * 2654435761u >> 16);
+    }
+
+    DISPLAY_RenderFillRect(&Fill, Teal);
+    DISPLAY_RenderSync();
+    DISPLAY_RenderGradient(&Horiz, UT_Red, UT_Blue, false);
+    DISPLAY_RenderSync();
+    DISPLAY_RenderGradient(&Vert, UT_Green, UT_White, true);
+    DISPLAY_RenderSync();
+    DISPLAY_RenderBlit565(200, 51, (const uint8 *)Image, 300, 200);
+    DISPLAY_RenderFlush(false);
+}
+
+void Test_DISPLAY_Bands(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_BandRun( int32 Y, int32 Rows, int32 Width, DISPLAY_BandFunc_t Func, const void *Arg )
+     *
+     * Split across the pool, large draws and flushes must reach the panel
+     * exactly as they do on the app task alone. The stubbed workers never
+     * run, so the app task takes every band.
+     */
+    static uint8 Single[512 * 256 * 2];
+    uint8        Workers;
+    uint32       Jobs;
+
+    UT_Display.Table.PoolSize[DISPLAY_POOL_FRAME] = 2 * 1024 * 1024;
+
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, 512, 256, 16);
+    UT_Display_Start();
+    UT_Display_DrawLarge();
+    memcpy(Single, UT_FakeFb.Pixels, sizeof(Single));
+    DISPLAY_BandGetStats(&Workers, &Jobs);
+    UtAssert_True(Workers == 0 && Jobs == 0, "Nothing split without a pool");
+    Display_UT_TearDown();
+
+    UT_Display.Table.Workers = 3;
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, 512, 256, 16);
+    UT_Display_Start();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_CreateChildTask)) == 3, "Three workers started");
+    UT_Display_DrawLarge();
+    UtAssert_True(memcmp(Single, UT_FakeFb.Pixels, sizeof(Single)) == 0, "Banded frame matches the single task one");
+
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.Workers == 3, "Workers reported");
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.BandedJobs == 5, "Banded jobs reported (%lu)",
+                  (unsigned long)DISPLAY_Data.PerfTlm.Payload.BandedJobs);
+}
+
+void Test_DISPLAY_BandWorkers(void)
+{
+    /*
+     * Test Case For:
+     * CFE_Status_t DISPLAY_BandInit( uint8 Workers )
+     */
+    UT_CheckEvent_t           EventTest;
+    CFE_ES_TaskEntryFuncPtr_t Entry = NULL;
+    uint8                     Workers;
+    uint32                    Jobs, Gives;
+
+    UT_TEST_FUNCTION_RC(DISPLAY_BandInit(DISPLAY_BAND_MAX_WORKERS + 1), DISPLAY_STATUS_ERROR_RANGE);
+
+    UT_SetDeferredRetcode(UT_KEY(OS_CountSemCreate), 1, OS_ERROR);
+    UT_TEST_FUNCTION_RC(DISPLAY_BandInit(2), DISPLAY_STATUS_ERROR_NOMEM);
+    UT_SetDeferredRetcode(UT_KEY(OS_CountSemCreate), 2, OS_ERROR);
+    UT_TEST_FUNCTION_RC(DISPLAY_BandInit(2), DISPLAY_STATUS_ERROR_NOMEM);
+
+    /* a worker that cannot be started leaves the others running */
+    UT_Display.Table.Workers = 4;
+    UT_SetDeferredRetcode(UT_KEY(CFE_ES_CreateChildTask), 3, CFE_ES_ERR_CHILD_TASK_CREATE);
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_STARTUP_ERR_EID, "Display: Error starting band workers, RC = 0x%08lX\n");
+    UT_Display_Start();
+    UtAssert_True(EventTest.MatchCount == 1, "DISPLAY_STARTUP_ERR_EID generated (%u)",
+                  (unsigned int)EventTest.MatchCount);
+    DISPLAY_BandGetStats(&Workers, &Jobs);
+    UtAssert_True(Workers == 2, "Two workers running (%u)", (unsigned int)Workers);
+
+    /* a worker woken with nothing left to take reports done, and exits when its semaphore goes */
+    UT_SetHandlerFunction(UT_KEY(CFE_ES_CreateChildTask), UT_Display_ChildTaskHandler, &Entry);
+    UT_TEST_FUNCTION_RC(DISPLAY_BandInit(1), CFE_SUCCESS);
+    UtAssert_True(Entry != NULL, "Worker entry point passed");
+    Gives = UT_GetStubCount(UT_KEY(OS_CountSemGive));
+    UT_SetDeferredRetcode(UT_KEY(OS_CountSemTake), 2, OS_ERROR);
+    Entry();
+    UtAssert_True(UT_GetStubCount(UT_KEY(OS_CountSemGive)) == Gives + 1, "Worker reported done once");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_ExitChildTask)) == 1, "Worker exited");
+
+    DISPLAY_BandClose();
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_DeleteChildTask)) == 3, "Workers deleted (%u)",
+                  (unsigned int)UT_GetStubCount(UT_KEY(CFE_ES_DeleteChildTask)));
+}
+
+/*
+ * A frame cleared and then painted over: a full-frame fill, a fill through
+ * a viewport, a full-frame gradient hiding both, a fill on another layer,
+ * and a blit and a panel each covering part of what came before. With
+ * Sync, each draw is drawn before the next is made.
+ */
+static void UT_Display_DrawOverlapping(bool Sync)
+{
+    static uint16   Image[40 * 30];
+    DISPLAY_Rect_t  Full     = {0, 0, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT};
+    DISPLAY_Rect_t  Viewport = {100, 60, 60, 68};
+    DISPLAY_Rect_t  Box      = {0, 0, 40, 40};
+    DISPLAY_Rect_t  Panel    = {30, 20, 60, 50};
+    DISPLAY_Rect_t  Corner   = {0, 0, 20, 20};
+    uint32          i;
+
+    for (i = 0; i < 40 * 30; i++)
+    {
+        Image[i] = (uint16)(i * 2654435761u >> 16);
+    }
+
+    DISPLAY_RenderSetTarget(0, NULL);
+    DISPLAY_RenderFillRect(&Full, UT_Blue);
+    if (Sync)
+    {
+        DISPLAY_RenderSync();
+    }
+    DISPLAY_RenderSetTarget(0, &Viewport);
+    DISPLAY_RenderFillRect(&Box, UT_White);
+    if (Sync)
+    {
+        DISPLAY_RenderSync();
+    }
+    DISPLAY_RenderSetTarget(0, NULL);
+    DISPLAY_RenderGradient(&Full, UT_Red, UT_Green, false);
+    if (Sync)
+    {
+        DISPLAY_RenderSync();
+    }
+    DISPLAY_RenderSetTarget(1, NULL);
+    DISPLAY_RenderFillRect(&Corner, UT_Red);
+    if (Sync)
+    {
+        DISPLAY_RenderSync();
+    }
+    DISPLAY_RenderSetTarget(0, NULL);
+    DISPLAY_RenderBlit565(10, 10, (const uint8 *)Image, 40, 30);
+    if (Sync)
+    {
+        DISPLAY_RenderSync();
+    }
+    DISPLAY_RenderFillRect(&Panel, UT_White);
+    DISPLAY_RenderFlush(false);
+}
+
+void Test_DISPLAY_Overdraw(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_RenderSync( void )
+     *
+     * Draws queued together must leave the same frame as draws made one
+     * at a time, while writing the pixels covered by later draws once.
+     */
+    static uint8 Each[UT_DISPLAY_WIDTH * UT_DISPLAY_HEIGHT * 2];
+
+    UT_Display_Start();
+    UT_Display_DrawOverlapping(true);
+    memcpy(Each, UT_FakeFb.Pixels, sizeof(Each));
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.DrawsCulled == 0 && DISPLAY_Data.PerfTlm.Payload.PixelsSkipped == 0,
+                  "Nothing culled one draw at a time");
+    Display_UT_TearDown();
+
+    UT_Display_Start();
+    UT_Display_DrawOverlapping(false);
+    UtAssert_True(memcmp(Each, UT_FakeFb.Pixels, sizeof(Each)) == 0, "Queued frame matches the one drawn draw by draw");
+
+    /* both first fills are hidden; the gradient loses what the blit and panel cover, the blit what the panel does */
+    DISPLAY_ReportHousekeeping(NULL);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.DrawsCulled == 2, "Draws culled (%lu)",
+                  (unsigned long)DISPLAY_Data.PerfTlm.Payload.DrawsCulled);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.DrawsClipped == 2, "Draws clipped (%lu)",
+                  (unsigned long)DISPLAY_Data.PerfTlm.Payload.DrawsClipped);
+    UtAssert_True(DISPLAY_Data.PerfTlm.Payload.PixelsSkipped == 160 * 128 + 40 * 40 + 3800 + 400,
+                  "Pixels skipped (%lu)", (unsigned long)DISPLAY_Data.PerfTlm.Payload.PixelsSkipped);
+}
+
+void Test_DISPLAY_VerifyCmdLength(void)
+{
+    /*
+     * Test Case For:
+     * bool DISPLAY_VerifyCmdLength
+     * bool DISPLAY_VerifyCmdMinLength
+     */
+    UT_CheckEvent_t EventTest;
+
+    UT_Display.Size    = 8;
+    UT_Display.MsgId   = CFE_SB_ValueToMsgId(3);
+    UT_Display.FcnCode = 2;
+
+    UT_CheckEvent_Setup(&EventTest, DISPLAY_LEN_ERR_EID, NULL);
+    UtAssert_True(DISPLAY_VerifyCmdLength(NULL, 8), "Exact length accepted");
+    UtAssert_True(!DISPLAY_VerifyCmdLength(NULL, 9), "Short length refused");
+    UtAssert_True(DISPLAY_VerifyCmdMinLength(NULL, 8), "Minimum length accepted");
+    UtAssert_True(DISPLAY_VerifyCmdMinLength(NULL, 4), "Longer than minimum accepted");
+    UtAssert_True(!DISPLAY_VerifyCmdMinLength(NULL, 9), "Below minimum refused");
+    UtAssert_True(EventTest.MatchCount == 2, "DISPLAY_LEN_ERR_EID generated (%u)", (unsigned int)EventTest.MatchCount);
+    UtAssert_True(DISPLAY_Data.ErrCounter == 2, "ErrCounter incremented");
+}
+
+void Test_DISPLAY_TblValidationFunc(void)
+{
+    /*
+     * Test Case For:
+     * int32 DISPLAY_TblValidationFunc( void *TblData )
+     */
+    DISPLAY_Table_t TestTblData;
+
+    memcpy(&TestTblData, &UT_Display.Table, sizeof(TestTblData));
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), CFE_SUCCESS);
+
+    /* each of these alone fails validation */
+    UT_FakeFb.Present = false;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    UT_FakeFb.Present = true;
+
+    TestTblData.PoolSize[DISPLAY_POOL_IMAGE] = DISPLAY_ARENA_MAX_SIZE;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.PoolSize[DISPLAY_POOL_IMAGE] = 64 * 1024;
+
+    TestTblData.Rotation = DISPLAY_ROTATE_270 + 1;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.Rotation = DISPLAY_ROTATE_0;
+
+    TestTblData.ClientMsgBudget = 0;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.ClientMsgBudget = 4;
+
+    TestTblData.PanelGamma = 99;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.PanelGamma = 220;
+
+    TestTblData.Brightness = 101;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.Brightness = 100;
+
+    TestTblData.ShotBytesPerSec = 0;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.ShotBytesPerSec = 8 * 1024;
+
+    TestTblData.Workers = DISPLAY_BAND_MAX_WORKERS + 1;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+    TestTblData.Workers = 0;
+
+    TestTblData.RefreshUs = DISPLAY_MAX_REFRESH_US + 1;
+    UT_TEST_FUNCTION_RC(DISPLAY_TblValidationFunc(&TestTblData), DISPLAY_TBL_ERR_EID);
+}
+
+void Test_DISPLAY_GetCrc(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_GetCrc( const char *TableName )
+     */
+    UT_SetDefaultReturnValue(UT_KEY(CFE_TBL_GetInfo), CFE_TBL_ERR_INVALID_NAME);
+    DISPLAY_GetCrc("UT");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_WriteToSysLog)) == 1, "CFE_ES_WriteToSysLog() called");
+
+    UT_ClearDefaultReturnValue(UT_KEY(CFE_TBL_GetInfo));
+    DISPLAY_GetCrc("UT");
+    UtAssert_True(UT_GetStubCount(UT_KEY(CFE_ES_WriteToSysLog)) == 2, "CFE_ES_WriteToSysLog() called");
+}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(DISPLAY_Main);
+    ADD_TEST(DISPLAY_Init);
+    ADD_TEST(DISPLAY_ProcessCommandPacket);
+    ADD_TEST(DISPLAY_ProcessGroundCommand);
+    ADD_TEST(DISPLAY_ReportHousekeeping);
+    ADD_TEST(DISPLAY_NoopCmd);
+    ADD_TEST(DISPLAY_ResetCounters);
+    ADD_TEST(DISPLAY_ProcessTbl);
+    ADD_TEST(DISPLAY_FillRect);
+    ADD_TEST(DISPLAY_Gradient);
+    ADD_TEST(DISPLAY_Images);
+    ADD_TEST(DISPLAY_Xfer);
+    ADD_TEST(DISPLAY_Text);
+    ADD_TEST(DISPLAY_Clients);
+    ADD_TEST(DISPLAY_DrawAck);
+    ADD_TEST(DISPLAY_Flow);
+    ADD_TEST(DISPLAY_Jobs);
+    ADD_TEST(DISPLAY_Lib);
+    ADD_TEST(DISPLAY_Layers);
+    ADD_TEST(DISPLAY_Rotation);
+    ADD_TEST(DISPLAY_Record);
+    ADD_TEST(DISPLAY_Anim);
+    ADD_TEST(DISPLAY_CrcCmd);
+    ADD_TEST(DISPLAY_Screenshot);
+    ADD_TEST(DISPLAY_IdleBlank);
+    ADD_TEST(DISPLAY_CheckDevice);
+    ADD_TEST(DISPLAY_FbInit);
+    ADD_TEST(DISPLAY_Fb32);
+    ADD_TEST(DISPLAY_FbBlank);
+    ADD_TEST(DISPLAY_Stream);
+    ADD_TEST(DISPLAY_PresentPaths);
+    ADD_TEST(DISPLAY_PresentCalibration);
+    ADD_TEST(DISPLAY_RefreshPacing);
+    ADD_TEST(DISPLAY_Bands);
+    ADD_TEST(DISPLAY_BandWorkers);
+    ADD_TEST(DISPLAY_Overdraw);
+    ADD_TEST(DISPLAY_VerifyCmdLength);
+    ADD_TEST(DISPLAY_TblValidationFunc);
+    ADD_TEST(DISPLAY_GetCrc);
+}
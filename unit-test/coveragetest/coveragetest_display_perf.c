@@ -0,0 +1,200 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: coveragetest_display_perf.c
+**
+** Purpose:
+** Performance regression test for the Display Application
+**
+** Notes:
+** Times the fill, blit and flush paths over a full frame of the fake
+** panel and checks each against the baseline in
+** ut_display_perf_baseline.h. Each path is timed as the best of several
+** runs, so a busy build host only makes a failure less likely. Fills and
+** blits are drawn as they are made, as each would otherwise only be
+** culled by the next.
+*/
+
+/*
+ * Includes
+ */
+
+#include "display_7735s_coveragetest_common.h"
+#include "display_render.h"
+#include "ut_display_perf_baseline.h"
+
+#include <time.h>
+
+#define UT_PERF_RUNS  7  /* Runs per path; the fastest counts */
+#define UT_PERF_CALLS 50 /* Full-frame operations per run */
+
+static const DISPLAY_Rect_t UT_Perf_Frame = {0, 0, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT};
+
+static uint16 UT_Perf_Image[UT_DISPLAY_WIDTH * UT_DISPLAY_HEIGHT];
+
+static uint64 UT_Perf_NowNs(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64)Now.tv_sec * 1000000000) + (uint64)Now.tv_nsec;
+}
+
+static void UT_Perf_Fill(uint32 Call)
+{
+    DISPLAY_Color_t Color = {(uint8)Call, 0x80, 0x40, 255};
+
+    DISPLAY_RenderFillRect(&UT_Perf_Frame, Color);
+    DISPLAY_RenderSync();
+}
+
+static void UT_Perf_Blit(uint32 Call)
+{
+    DISPLAY_RenderBlit565(0, 0, (const uint8 *)UT_Perf_Image, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT);
+    DISPLAY_RenderSync();
+}
+
+static void UT_Perf_Flush(uint32 Call)
+{
+    DISPLAY_RenderDamage(&UT_Perf_Frame);
+    DISPLAY_RenderFlush(false);
+}
+
+/*
+ * Best throughput of Func over UT_PERF_RUNS runs, in megapixels per
+ * second
+ */
+static double UT_Perf_Measure(void (*Func)(uint32))
+{
+    uint64 Start, Elapsed, Best = 0;
+    uint32 Run, Call;
+
+    /* warm the caches and settle the damage list first */
+    Func(0);
+    DISPLAY_RenderFlush(false);
+
+    for (Run = 0; Run < UT_PERF_RUNS; Run++)
+    {
+        Start = UT_Perf_NowNs();
+        for (Call = 0; Call < UT_PERF_CALLS; Call++)
+        {
+            Func(Call);
+        }
+        Elapsed = UT_Perf_NowNs() - Start;
+
+        if (Best == 0 || Elapsed < Best)
+        {
+            Best = Elapsed;
+        }
+
+        /* fills and blits only damage; keep the list from carrying over */
+        DISPLAY_RenderFlush(false);
+    }
+
+    if (Best == 0)
+    {
+        Best = 1;
+    }
+
+    return ((double)UT_PERF_CALLS * UT_DISPLAY_WIDTH * UT_DISPLAY_HEIGHT * 1000.0) / (double)Best;
+}
+
+static void UT_Perf_Check(const char *Path, double Measured, double Baseline)
+{
+    double Floor = Baseline * (100 - UT_DISPLAY_PERF_TOLERANCE) / 100.0;
+
+    UtPrintf("%s: %.1f Mpix/s, baseline %.1f, floor %.1f\n", Path, Measured, Baseline, Floor);
+    UtAssert_True(Measured >= Floor, "%s %.1f Mpix/s within %d%% of baseline %.1f Mpix/s", Path, Measured,
+                  UT_DISPLAY_PERF_TOLERANCE, Baseline);
+}
+
+/*
+**********************************************************************************
+**          TEST CASE FUNCTIONS
+**********************************************************************************
+*/
+
+void Test_DISPLAY_PerfFill(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_RenderFillRect( const DISPLAY_Rect_t *Rect, DISPLAY_Color_t Color )
+     */
+    UT_Display_Start();
+
+    UT_Perf_Check("Fill", UT_Perf_Measure(UT_Perf_Fill), UT_DISPLAY_PERF_FILL_MPIX);
+}
+
+void Test_DISPLAY_PerfBlit(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_RenderBlit565( int32 X, int32 Y, const uint8 *Pixels, uint32 Width, uint32 Height )
+     */
+    uint32 i;
+
+    for (i = 0; i < UT_DISPLAY_WIDTH * UT_DISPLAY_HEIGHT; i++)
+    {
+        UT_Perf_Image[i] = (uint16)(i * 2654435761u >> 16);
+    }
+
+    UT_Display_Start();
+
+    UT_Perf_Check("Blit", UT_Perf_Measure(UT_Perf_Blit), UT_DISPLAY_PERF_BLIT_MPIX);
+}
+
+void Test_DISPLAY_PerfFlush(void)
+{
+    /*
+     * Test Case For:
+     * void DISPLAY_RenderFlush( void )
+     *
+     * A full-frame flush with every layer visible, so the composite and
+     * the present to the panel are both on the clock.
+     */
+    DISPLAY_Color_t Key = {0, 0, 0, 255};
+    DISPLAY_Color_t Red = {255, 0, 0, 255};
+    DISPLAY_Rect_t  Box = {16, 16, 64, 64};
+    uint8           Layer;
+
+    UT_Display_Start();
+
+    for (Layer = 0; Layer < DISPLAY_MAX_LAYERS; Layer++)
+    {
+        DISPLAY_RenderSetLayer(Layer, Layer, true, Layer != 0, Key);
+        DISPLAY_RenderSetTarget(Layer, NULL);
+        DISPLAY_RenderFillRect(&Box, Red);
+        Box.X += 16;
+    }
+
+    UT_Perf_Check("Flush", UT_Perf_Measure(UT_Perf_Flush), UT_DISPLAY_PERF_FLUSH_MPIX);
+}
+
+/*
+ * Register the test cases to execute with the unit test tool
+ */
+void UtTest_Setup(void)
+{
+    ADD_TEST(DISPLAY_PerfFill);
+    ADD_TEST(DISPLAY_PerfBlit);
+    ADD_TEST(DISPLAY_PerfFlush);
+}
@@ -0,0 +1,279 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: display_7735s_coveragetest_common.c
+**
+** Purpose:
+** Setup, teardown and stub handlers shared by the display coverage tests
+*/
+
+/*
+ * Includes
+ */
+
+#include "display_7735s_coveragetest_common.h"
+#include "display_arena.h"
+#include "display_band.h"
+#include "display_client.h"
+#include "display_fb.h"
+#include "display_font.h"
+#include "display_image.h"
+#include "display_record.h"
+#include "display_render.h"
+
+UT_Display_State_t UT_Display;
+
+/*
+ * Table every test starts from; matches the flight defaults apart from
+ * the device path
+ */
+static const DISPLAY_Table_t UT_Display_DefaultTable = {
+    .DevicePath = UT_DISPLAY_FB_PATH,
+    .Rotation   = DISPLAY_ROTATE_0,
+    .PoolSize =
+        {
+            [DISPLAY_POOL_FRAME] = 256 * 1024,
+            [DISPLAY_POOL_GLYPH] = 16 * 1024,
+            [DISPLAY_POOL_IMAGE] = 64 * 1024,
+            [DISPLAY_POOL_RING]  = 16 * 1024,
+        },
+    .ClientMsgBudget   = 4,
+    .ClientPixelBudget = 160 * 128 / 2,
+    .JobBudgetUs       = 500,
+    .ShotBytesPerSec   = 8 * 1024,
+    .PanelGamma        = 220,
+    .Brightness        = 100,
+    .RefreshUs         = 0,
+};
+
+static int32 UT_CheckEvent_Hook(void *UserObj, int32 StubRetcode, uint32 CallCount, const UT_StubContext_t *Context,
+                                va_list va)
+{
+    UT_CheckEvent_t *State = UserObj;
+    uint16           EventId;
+    const char      *Spec;
+
+    if (Context->ArgCount > 0)
+    {
+        EventId = UT_Hook_GetArgValueByName(Context, "EventID", uint16);
+        if (EventId == State->ExpectedEvent)
+        {
+            if (State->ExpectedFormat != NULL)
+            {
+                Spec = UT_Hook_GetArgValueByName(Context, "Spec", const char *);
+                if (Spec != NULL && strcmp(Spec, State->ExpectedFormat) == 0)
+                {
+                    ++State->MatchCount;
+                }
+            }
+            else
+            {
+                ++State->MatchCount;
+            }
+        }
+    }
+
+    return 0;
+}
+
+void UT_CheckEvent_Setup(UT_CheckEvent_t *Evt, uint16 ExpectedEvent, const char *ExpectedFormat)
+{
+    memset(Evt, 0, sizeof(*Evt));
+    Evt->ExpectedEvent  = ExpectedEvent;
+    Evt->ExpectedFormat = ExpectedFormat;
+    UT_SetVaHookFunction(UT_KEY(CFE_EVS_SendEvent), UT_CheckEvent_Hook, Evt);
+}
+
+/*
+ * Stub handlers
+ */
+static void UT_Display_GetMsgIdHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_SB_MsgId_t *MsgId = UT_Hook_GetArgValueByName(Context, "MsgId", CFE_SB_MsgId_t *);
+
+    *MsgId = UT_Display.MsgId;
+}
+
+static void UT_Display_GetFcnCodeHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_MSG_FcnCode_t *FcnCode = UT_Hook_GetArgValueByName(Context, "FcnCode", CFE_MSG_FcnCode_t *);
+
+    *FcnCode = UT_Display.FcnCode;
+}
+
+static void UT_Display_GetSizeHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_MSG_Size_t *Size = UT_Hook_GetArgValueByName(Context, "Size", CFE_MSG_Size_t *);
+
+    *Size = UT_Display.Size;
+}
+
+static void UT_Display_ReceiveBufferHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    CFE_SB_Buffer_t **BufPtr = UT_Hook_GetArgValueByName(Context, "BufPtr", CFE_SB_Buffer_t **);
+    int32             status = CFE_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status);
+    if (status == CFE_SUCCESS)
+    {
+        *BufPtr = UT_Display.RecvBuf;
+    }
+}
+
+static void UT_Display_GetAddressHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    void **TblPtr = UT_Hook_GetArgValueByName(Context, "TblPtr", void **);
+    int32  status = CFE_SUCCESS;
+
+    UT_Stub_GetInt32StatusCode(Context, &status);
+    if (status >= CFE_SUCCESS)
+    {
+        *TblPtr = &UT_Display.Table;
+    }
+}
+
+static void UT_Display_GetTimeHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    UT_Stub_SetReturnValue(FuncKey, UT_Display.Time);
+}
+
+static void UT_Display_CalculateCRCHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    const void *DataPtr    = UT_Hook_GetArgValueByName(Context, "DataPtr", const void *);
+    size_t      DataLength = UT_Hook_GetArgValueByName(Context, "DataLength", size_t);
+    uint32      InputCRC   = UT_Hook_GetArgValueByName(Context, "InputCRC", uint32);
+    uint32      Crc;
+
+    Crc = UT_Display_Crc16(DataPtr, DataLength, InputCRC);
+    UT_Stub_SetReturnValue(FuncKey, Crc);
+}
+
+static void UT_Display_OsWriteHandler(void *UserObj, UT_EntryKey_t FuncKey, const UT_StubContext_t *Context)
+{
+    int32 Written = (int32)UT_Hook_GetArgValueByName(Context, "nbytes", size_t);
+    int32 status;
+
+    if (!UT_Stub_GetInt32StatusCode(Context, &status))
+    {
+        UT_Stub_SetReturnValue(FuncKey, Written);
+    }
+}
+
+/*
+ * Table driven like the cFE's own, so the performance test times the app
+ * rather than the checksum
+ */
+uint32 UT_Display_Crc16(const void *Data, size_t Length, uint32 Crc)
+{
+    static uint16 Table[256];
+    static bool   TableReady = false;
+    const uint8  *p          = Data;
+    uint32        i, j, Entry;
+
+    if (!TableReady)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            Entry = i;
+            for (j = 0; j < 8; j++)
+            {
+                Entry = (Entry & 1) ? (Entry >> 1) ^ 0xA001 : Entry >> 1;
+            }
+            Table[i] = (uint16)Entry;
+        }
+        TableReady = true;
+    }
+
+    Crc &= 0xFFFF;
+    while (Length-- > 0)
+    {
+        Crc = (Crc >> 8) ^ Table[(Crc ^ *p++) & 0xFF];
+    }
+
+    return Crc;
+}
+
+void UT_Display_SetTimeMs(uint64 Ms)
+{
+    UT_Display.Time.Seconds = (uint32)(Ms / 1000);
+
+    /* Rounded up so the app's conversion back lands on the same millisecond */
+    UT_Display.Time.Subseconds = (uint32)((((Ms % 1000) << 32) + 999) / 1000);
+}
+
+void UT_Display_Start(void)
+{
+    UT_TEST_FUNCTION_RC(DISPLAY_Init(), CFE_SUCCESS);
+    UtAssert_True(DISPLAY_RenderIsReady(), "Display ready to draw after DISPLAY_Init()");
+}
+
+void UT_Display_Send(uint32 MsgId, uint16 FcnCode, void *Msg, size_t Size)
+{
+    UT_Display.MsgId   = CFE_SB_ValueToMsgId(MsgId);
+    UT_Display.FcnCode = (CFE_MSG_FcnCode_t)FcnCode;
+    UT_Display.Size    = Size;
+
+    DISPLAY_ProcessCommandPacket((CFE_SB_Buffer_t *)Msg);
+}
+
+/*
+ * Setup function prior to every test
+ */
+void Display_UT_Setup(void)
+{
+    UT_ResetState(0);
+
+    memset(&UT_Display, 0, sizeof(UT_Display));
+    memcpy(&UT_Display.Table, &UT_Display_DefaultTable, sizeof(UT_Display.Table));
+    UT_Display_SetTimeMs(1000);
+
+    memset(&DISPLAY_Data, 0, sizeof(DISPLAY_Data));
+
+    UT_FakeFb_Reset(UT_DISPLAY_FB_PATH, UT_DISPLAY_WIDTH, UT_DISPLAY_HEIGHT, 16);
+
+    UT_SetHandlerFunction(UT_KEY(CFE_MSG_GetMsgId), UT_Display_GetMsgIdHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_MSG_GetFcnCode), UT_Display_GetFcnCodeHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_MSG_GetSize), UT_Display_GetSizeHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_SB_ReceiveBuffer), UT_Display_ReceiveBufferHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_TBL_GetAddress), UT_Display_GetAddressHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_TIME_GetTime), UT_Display_GetTimeHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(CFE_ES_CalculateCRC), UT_Display_CalculateCRCHandler, NULL);
+    UT_SetHandlerFunction(UT_KEY(OS_write), UT_Display_OsWriteHandler, NULL);
+
+    /* Pipes are empty unless a test queues something */
+    UT_SetDefaultReturnValue(UT_KEY(CFE_SB_ReceiveBuffer), CFE_SB_NO_MESSAGE);
+}
+
+/*
+ * Teardown function after every test; leaves nothing open or mapped for
+ * the next one
+ */
+void Display_UT_TearDown(void)
+{
+    DISPLAY_RecordStop();
+    DISPLAY_ClientClose();
+    DISPLAY_RenderClose();
+    DISPLAY_BandClose();
+    DISPLAY_FbClose();
+    DISPLAY_FontClose();
+    DISPLAY_ImageClose();
+    DISPLAY_ArenaClose();
+}
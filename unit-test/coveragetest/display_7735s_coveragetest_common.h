@@ -21,11 +21,11 @@
 /**
  * @file
  *
- * Common definitions for all sample_app coverage tests
+ * Common definitions for all display coverage tests
  */
 
-#ifndef SAMPLE_APP_COVERAGETEST_COMMON_H
-#define SAMPLE_APP_COVERAGETEST_COMMON_H
+#ifndef DISPLAY_COVERAGETEST_COMMON_H
+#define DISPLAY_COVERAGETEST_COMMON_H
 
 /*
  * Includes
@@ -36,9 +36,11 @@
 #include "utstubs.h"
 
 #include "cfe.h"
-#include "sample_app_events.h"
-#include "sample_app.h"
-#include "sample_app_table.h"
+#include "display_events.h"
+#include "display_app.h"
+#include "display_table.h"
+#include "ut_display_app.h"
+#include "ut_display_fakefb.h"
 
 /*
  * Macro to call a function and check its int32 return code
@@ -53,16 +55,73 @@
 /*
  * Macro to add a test case to the list of tests to execute
  */
-#define ADD_TEST(test) UtTest_Add((Test_##test), Sample_UT_Setup, Sample_UT_TearDown, #test)
+#define ADD_TEST(test) UtTest_Add((Test_##test), Display_UT_Setup, Display_UT_TearDown, #test)
+
+/*
+ * The fake panel every test starts with: a 160x128 RGB565 ST7735
+ */
+#define UT_DISPLAY_FB_PATH "/dev/fb-ut"
+#define UT_DISPLAY_WIDTH   160
+#define UT_DISPLAY_HEIGHT  128
+
+/*
+ * Values the cFE stubs hand back to the unit under test. Setup points the
+ * CFE_MSG getters, CFE_SB_ReceiveBuffer, CFE_TBL_GetAddress and
+ * CFE_TIME_GetTime at these, so a test only has to fill them in.
+ */
+typedef struct
+{
+    CFE_SB_MsgId_t     MsgId;
+    CFE_MSG_FcnCode_t  FcnCode;
+    CFE_MSG_Size_t     Size;
+    CFE_SB_Buffer_t   *RecvBuf;
+    CFE_TIME_SysTime_t Time;
+    DISPLAY_Table_t    Table;
+} UT_Display_State_t;
+
+extern UT_Display_State_t UT_Display;
+
+typedef struct
+{
+    uint16      ExpectedEvent;
+    uint32      MatchCount;
+    const char *ExpectedFormat;
+} UT_CheckEvent_t;
+
+/*
+ * Count CFE_EVS_SendEvent calls for one event ID (and format, if given)
+ */
+void UT_CheckEvent_Setup(UT_CheckEvent_t *Evt, uint16 ExpectedEvent, const char *ExpectedFormat);
+
+/*
+ * Run DISPLAY_Init against the fake panel and confirm it came up drawing
+ */
+void UT_Display_Start(void);
+
+/*
+ * Deliver one message on the command pipe
+ */
+void UT_Display_Send(uint32 MsgId, uint16 FcnCode, void *Msg, size_t Size);
+
+/*
+ * Set the time CFE_TIME_GetTime reports, in milliseconds
+ */
+void UT_Display_SetTimeMs(uint64 Ms);
+
+/*
+ * Checksum the CFE_ES_CalculateCRC stub computes (CRC-16/ARC), so tile
+ * and transfer checks see real values
+ */
+uint32 UT_Display_Crc16(const void *Data, size_t Length, uint32 Crc);
 
 /*
  * Setup function prior to every test
  */
-void Sample_UT_Setup(void);
+void Display_UT_Setup(void);
 
 /*
  * Teardown function after every test
  */
-void Sample_UT_TearDown(void);
+void Display_UT_TearDown(void);
 
-#endif /* SAMPLE_APP_COVERAGETEST_COMMON_H */
+#endif /* DISPLAY_COVERAGETEST_COMMON_H */
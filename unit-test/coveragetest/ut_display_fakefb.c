@@ -0,0 +1,274 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/*
+** File: ut_display_fakefb.c
+**
+** Purpose:
+** Fake framebuffer device for the display coverage tests. This file is
+** built without override_inc, so the system calls here are the real ones.
+*/
+
+#include "ut_display_fakefb.h"
+
+#include <errno.h>
+#include <linux/fb.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+UT_FakeFb_t UT_FakeFb;
+
+void UT_FakeFb_Reset(const char *Path, uint32_t Width, uint32_t Height, uint32_t BitsPerPixel)
+{
+    free(UT_FakeFb.Pixels);
+    memset(&UT_FakeFb, 0, sizeof(UT_FakeFb));
+
+    strncpy(UT_FakeFb.Path, Path, sizeof(UT_FakeFb.Path) - 1);
+    UT_FakeFb.Present      = true;
+    UT_FakeFb.Rdev         = 0x1d01;
+    UT_FakeFb.Ino          = 1000;
+    UT_FakeFb.Width        = Width;
+    UT_FakeFb.Height       = Height;
+    UT_FakeFb.BitsPerPixel = BitsPerPixel;
+    UT_FakeFb.LineLength   = Width * (BitsPerPixel / 8);
+}
+
+uint32_t UT_FakeFb_GetPixel(uint32_t X, uint32_t Y)
+{
+    const uint8_t *p;
+
+    if (UT_FakeFb.Pixels == NULL || X >= UT_FakeFb.Width || Y >= UT_FakeFb.Height)
+    {
+        return 0;
+    }
+
+    p = UT_FakeFb.Pixels + ((size_t)Y * UT_FakeFb.LineLength) + ((size_t)X * (UT_FakeFb.BitsPerPixel / 8));
+
+    if (UT_FakeFb.BitsPerPixel == 32)
+    {
+        return *(const uint32_t *)p;
+    }
+
+    return *(const uint16_t *)p;
+}
+
+static bool UT_FakeFb_IsDevice(const char *Path)
+{
+    return (UT_FakeFb.Present && Path != NULL && strcmp(Path, UT_FakeFb.Path) == 0);
+}
+
+int UT_FakeFb_open(const char *Path, int Flags, ...)
+{
+    if (!UT_FakeFb_IsDevice(Path) || (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_OPEN))
+    {
+        errno = ENOENT;
+        return -1;
+    }
+
+    UT_FakeFb.Open = true;
+
+    return UT_FAKEFB_FD;
+}
+
+int UT_FakeFb_close(int Fd)
+{
+    if (Fd != UT_FAKEFB_FD || !UT_FakeFb.Open)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    UT_FakeFb.Open = false;
+
+    return 0;
+}
+
+static void UT_FakeFb_FillStat(struct stat *Buf)
+{
+    memset(Buf, 0, sizeof(*Buf));
+    Buf->st_mode = S_IFCHR | 0660;
+    Buf->st_rdev = (dev_t)UT_FakeFb.Rdev;
+    Buf->st_ino  = (ino_t)UT_FakeFb.Ino;
+}
+
+int UT_FakeFb_stat(const char *Path, struct stat *Buf)
+{
+    if (!UT_FakeFb_IsDevice(Path))
+    {
+        errno = ENOENT;
+        return -1;
+    }
+
+    UT_FakeFb_FillStat(Buf);
+
+    return 0;
+}
+
+int UT_FakeFb_fstat(int Fd, struct stat *Buf)
+{
+    if (Fd != UT_FAKEFB_FD || !UT_FakeFb.Open || (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_FSTAT))
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    UT_FakeFb_FillStat(Buf);
+
+    return 0;
+}
+
+int UT_FakeFb_ioctl(int Fd, unsigned long Request, ...)
+{
+    struct fb_fix_screeninfo *Fix;
+    struct fb_var_screeninfo *Var;
+    va_list                   va;
+    int                       status = 0;
+
+    if (Fd != UT_FAKEFB_FD || !UT_FakeFb.Open)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    va_start(va, Request);
+
+    switch (Request)
+    {
+        case FBIOGET_FSCREENINFO:
+            Fix = va_arg(va, struct fb_fix_screeninfo *);
+            if (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_FIXINFO)
+            {
+                status = -1;
+                break;
+            }
+            memset(Fix, 0, sizeof(*Fix));
+            Fix->line_length = UT_FakeFb.LineLength;
+            Fix->smem_len    = UT_FakeFb.LineLength * UT_FakeFb.Height;
+            break;
+
+        case FBIOGET_VSCREENINFO:
+            Var = va_arg(va, struct fb_var_screeninfo *);
+            if (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_VARINFO)
+            {
+                status = -1;
+                break;
+            }
+            memset(Var, 0, sizeof(*Var));
+            Var->xres           = UT_FakeFb.Width;
+            Var->yres           = UT_FakeFb.Height;
+            Var->bits_per_pixel = UT_FakeFb.BitsPerPixel;
+            Var->pixclock       = UT_FakeFb.Pixclock;
+            if (UT_FakeFb.BitsPerPixel == 16)
+            {
+                Var->red.offset   = 11;
+                Var->red.length   = 5;
+                Var->green.offset = 5;
+                Var->green.length = 6;
+                Var->blue.offset  = 0;
+                Var->blue.length  = 5;
+            }
+            else
+            {
+                Var->red.offset   = 16;
+                Var->red.length   = 8;
+                Var->green.offset = 8;
+                Var->green.length = 8;
+                Var->blue.offset  = 0;
+                Var->blue.length  = 8;
+            }
+            break;
+
+        case FBIOBLANK:
+            UT_FakeFb.BlankCalls++;
+            if (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_BLANK)
+            {
+                status = -1;
+                break;
+            }
+            UT_FakeFb.Blanked = (va_arg(va, int) != FB_BLANK_UNBLANK);
+            break;
+
+        case FBIO_WAITFORVSYNC:
+            UT_FakeFb.VsyncCalls++;
+            if (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_VSYNC)
+            {
+                status = -1;
+            }
+            break;
+
+        default:
+            status = -1;
+            break;
+    }
+
+    va_end(va);
+
+    if (status != 0)
+    {
+        errno = EINVAL;
+    }
+
+    return status;
+}
+
+void *UT_FakeFb_mmap(void *Addr, size_t Length, int Prot, int Flags, int Fd, off_t Offset)
+{
+    if (Fd != UT_FAKEFB_FD || !UT_FakeFb.Open || UT_FakeFb.Mapped || Offset != 0 ||
+        Length > (size_t)UT_FakeFb.LineLength * UT_FakeFb.Height || (UT_FakeFb.FailMask & UT_FAKEFB_FAIL_MMAP))
+    {
+        errno = EINVAL;
+        return MAP_FAILED;
+    }
+
+    /* Device memory keeps its contents across maps unless the geometry changed */
+    if (UT_FakeFb.Pixels == NULL || UT_FakeFb.Size != (size_t)UT_FakeFb.LineLength * UT_FakeFb.Height)
+    {
+        free(UT_FakeFb.Pixels);
+        UT_FakeFb.Size   = (size_t)UT_FakeFb.LineLength * UT_FakeFb.Height;
+        UT_FakeFb.Pixels = calloc(1, UT_FakeFb.Size);
+        if (UT_FakeFb.Pixels == NULL)
+        {
+            errno = ENOMEM;
+            return MAP_FAILED;
+        }
+    }
+
+    UT_FakeFb.Mapped = true;
+    UT_FakeFb.MapCalls++;
+
+    return UT_FakeFb.Pixels;
+}
+
+int UT_FakeFb_munmap(void *Addr, size_t Length)
+{
+    if (!UT_FakeFb.Mapped || Addr != UT_FakeFb.Pixels)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    UT_FakeFb.Mapped = false;
+
+    return 0;
+}
@@ -23,7 +23,7 @@
  *
  *
  * Purpose:
- * Extra scaffolding functions for the sample_app unit test
+ * Extra scaffolding functions for the display unit test
  *
  * Notes:
  * This is an extra UT-specific extern declaration
@@ -34,19 +34,19 @@
  * order to exercise or set up for off-nominal cases.
  */
 
-#ifndef UT_SAMPLE_APP_H
-#define UT_SAMPLE_APP_H
+#ifndef UT_DISPLAY_APP_H
+#define UT_DISPLAY_APP_H
 
 /*
  * Necessary to include these here to get the definition of the
- * "SAMPLE_APP_Data_t" typedef.
+ * "DISPLAY_Data_t" typedef.
  */
-#include "sample_app_events.h"
-#include "sample_app.h"
+#include "display_events.h"
+#include "display_app.h"
 
 /*
- * Allow UT access to the global "SAMPLE_APP_Data" object.
+ * Allow UT access to the global "DISPLAY_Data" object.
  */
-extern SAMPLE_APP_Data_t SAMPLE_APP_Data;
+extern DISPLAY_Data_t DISPLAY_Data;
 
-#endif /* UT_SAMPLE_APP_H */
+#endif /* UT_DISPLAY_APP_H */
@@ -0,0 +1,103 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/**
+ * @file
+ *
+ * Purpose:
+ * Fake framebuffer device for the display coverage tests
+ *
+ * Notes:
+ * The units under test are built with override_inc ahead of the system
+ * headers, which turns their open, close, stat, fstat, ioctl, mmap and
+ * munmap calls into the UT_FakeFb_* functions below. The fake answers
+ * for one device node at UT_FakeFb.Path with an RGB565 (or 32 bpp)
+ * frame held in memory, so the real device and drawing code runs and
+ * the test can read back what reached the panel.
+ */
+
+#ifndef UT_DISPLAY_FAKEFB_H
+#define UT_DISPLAY_FAKEFB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+struct stat;
+
+/*
+** Operations that can be told to fail
+*/
+#define UT_FAKEFB_FAIL_OPEN    0x01
+#define UT_FAKEFB_FAIL_FSTAT   0x02
+#define UT_FAKEFB_FAIL_FIXINFO 0x04
+#define UT_FAKEFB_FAIL_VARINFO 0x08
+#define UT_FAKEFB_FAIL_MMAP    0x10
+#define UT_FAKEFB_FAIL_BLANK   0x20
+#define UT_FAKEFB_FAIL_VSYNC   0x40 /* As a driver that cannot wait for the vertical blank */
+
+#define UT_FAKEFB_FD 42
+
+typedef struct
+{
+    char     Path[64];
+    bool     Present;      /* Device node exists */
+    uint64_t Rdev;         /* Reported st_rdev; change it to simulate a driver reload */
+    uint64_t Ino;          /* Reported st_ino */
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t BitsPerPixel; /* 16 (RGB565) or 32 (XRGB8888) */
+    uint32_t LineLength;   /* Bytes per line; may exceed Width * bytes per pixel */
+    uint32_t Pixclock;     /* Reported pixel clock, picoseconds; 0 gives no video timings */
+    uint32_t FailMask;     /* UT_FAKEFB_FAIL_* */
+
+    bool     Open;
+    bool     Blanked;
+    uint32_t BlankCalls;
+    uint32_t MapCalls;
+    uint32_t VsyncCalls; /* Vertical blank waits; each returns at once */
+
+    uint8_t *Pixels; /* Device memory, LineLength * Height bytes */
+    size_t   Size;
+    bool     Mapped;
+} UT_FakeFb_t;
+
+extern UT_FakeFb_t UT_FakeFb;
+
+/*
+** Replace the device with a fresh blank one, present at Path
+*/
+void UT_FakeFb_Reset(const char *Path, uint32_t Width, uint32_t Height, uint32_t BitsPerPixel);
+
+/*
+** Read back one pixel of device memory, in device coordinates
+*/
+uint32_t UT_FakeFb_GetPixel(uint32_t X, uint32_t Y);
+
+int   UT_FakeFb_open(const char *Path, int Flags, ...);
+int   UT_FakeFb_close(int Fd);
+int   UT_FakeFb_stat(const char *Path, struct stat *Buf);
+int   UT_FakeFb_fstat(int Fd, struct stat *Buf);
+int   UT_FakeFb_ioctl(int Fd, unsigned long Request, ...);
+void *UT_FakeFb_mmap(void *Addr, size_t Length, int Prot, int Flags, int Fd, off_t Offset);
+int   UT_FakeFb_munmap(void *Addr, size_t Length);
+
+#endif /* UT_DISPLAY_FAKEFB_H */
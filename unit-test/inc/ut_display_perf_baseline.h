@@ -0,0 +1,59 @@
+/*
+**  GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**  Copyright (c) 2006-2019 United States Government as represented by
+**  the Administrator of the National Aeronautics and Space Administration.
+**  All Rights Reserved.
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**    http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+*/
+
+/**
+ * @file
+ *
+ * Stored baseline for the display performance test
+ *
+ * Throughput of each drawing path over a full 160x128 RGB565 frame, in
+ * megapixels per second, as measured on the reference build host with the
+ * coverage test flags (no optimization, coverage instrumentation). The
+ * test fails when a path falls more than UT_DISPLAY_PERF_TOLERANCE percent
+ * below its baseline.
+ *
+ * The numbers only mean something on the host they were taken on. Other
+ * hosts set their own from the test's output with -D, or widen the
+ * tolerance through the DISPLAY_PERF_TOLERANCE cache variable.
+ */
+
+#ifndef UT_DISPLAY_PERF_BASELINE_H
+#define UT_DISPLAY_PERF_BASELINE_H
+
+#ifndef UT_DISPLAY_PERF_FILL_MPIX
+#define UT_DISPLAY_PERF_FILL_MPIX 8000
+#endif
+
+#ifndef UT_DISPLAY_PERF_BLIT_MPIX
+#define UT_DISPLAY_PERF_BLIT_MPIX 6000
+#endif
+
+#ifndef UT_DISPLAY_PERF_FLUSH_MPIX
+#define UT_DISPLAY_PERF_FLUSH_MPIX 30
+#endif
+
+/*
+ * Allowed shortfall against the baseline, in percent
+ */
+#ifndef UT_DISPLAY_PERF_TOLERANCE
+#define UT_DISPLAY_PERF_TOLERANCE 50
+#endif
+
+#endif /* UT_DISPLAY_PERF_BASELINE_H */
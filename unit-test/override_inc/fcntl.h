@@ -0,0 +1,14 @@
+/*
+** Coverage test override: route open() in the units under test to the
+** fake framebuffer device. See ut_display_fakefb.h.
+*/
+#ifndef UT_OVERRIDE_FCNTL_H
+#define UT_OVERRIDE_FCNTL_H
+
+#include_next <fcntl.h>
+
+#include "ut_display_fakefb.h"
+
+#define open(...) UT_FakeFb_open(__VA_ARGS__)
+
+#endif /* UT_OVERRIDE_FCNTL_H */
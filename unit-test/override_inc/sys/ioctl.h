@@ -0,0 +1,14 @@
+/*
+** Coverage test override: route ioctl() in the units under test to the
+** fake framebuffer device. See ut_display_fakefb.h.
+*/
+#ifndef UT_OVERRIDE_SYS_IOCTL_H
+#define UT_OVERRIDE_SYS_IOCTL_H
+
+#include_next <sys/ioctl.h>
+
+#include "ut_display_fakefb.h"
+
+#define ioctl(...) UT_FakeFb_ioctl(__VA_ARGS__)
+
+#endif /* UT_OVERRIDE_SYS_IOCTL_H */
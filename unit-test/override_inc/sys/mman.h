@@ -0,0 +1,15 @@
+/*
+** Coverage test override: route mmap() and munmap() in the units under
+** test to the fake framebuffer device. See ut_display_fakefb.h.
+*/
+#ifndef UT_OVERRIDE_SYS_MMAN_H
+#define UT_OVERRIDE_SYS_MMAN_H
+
+#include_next <sys/mman.h>
+
+#include "ut_display_fakefb.h"
+
+#define mmap(a, l, p, f, fd, o) UT_FakeFb_mmap(a, l, p, f, fd, o)
+#define munmap(a, l)            UT_FakeFb_munmap(a, l)
+
+#endif /* UT_OVERRIDE_SYS_MMAN_H */
@@ -0,0 +1,16 @@
+/*
+** Coverage test override: route stat() and fstat() in the units under
+** test to the fake framebuffer device. Function-like macros leave
+** "struct stat" alone. See ut_display_fakefb.h.
+*/
+#ifndef UT_OVERRIDE_SYS_STAT_H
+#define UT_OVERRIDE_SYS_STAT_H
+
+#include_next <sys/stat.h>
+
+#include "ut_display_fakefb.h"
+
+#define stat(p, s)   UT_FakeFb_stat(p, s)
+#define fstat(fd, s) UT_FakeFb_fstat(fd, s)
+
+#endif /* UT_OVERRIDE_SYS_STAT_H */
@@ -0,0 +1,14 @@
+/*
+** Coverage test override: route close() in the units under test to the
+** fake framebuffer device. See ut_display_fakefb.h.
+*/
+#ifndef UT_OVERRIDE_UNISTD_H
+#define UT_OVERRIDE_UNISTD_H
+
+#include_next <unistd.h>
+
+#include "ut_display_fakefb.h"
+
+#define close(fd) UT_FakeFb_close(fd)
+
+#endif /* UT_OVERRIDE_UNISTD_H */